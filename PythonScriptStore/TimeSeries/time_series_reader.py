@@ -0,0 +1,99 @@
+# !/usr/bin/env python3
+import struct
+import sys
+from array import array
+
+# This is the reader of the time series store (output/TimeSeries.sts) written by the recordings
+# of observed and reduced quantities in the time series format, see src/shared/io_system/io_time_series.h.
+# Only the chunk headers are scanned when opening the store, and only the data chunks
+# overlapping the requested time range are read.
+
+MAGIC = b"SPHTS001"
+CHUNK_HEADER = struct.Struct("<IIQQdd")
+SCHEMA_CHUNK = 1
+DATA_CHUNK = 2
+
+
+class TimeSeriesStore:
+
+    def __init__(self, file_path):
+        self.file_path = file_path
+        self.series_ids = {}
+        self.series_columns = []
+        self.series_chunks = []
+        with open(file_path, "rb") as file:
+            if file.read(len(MAGIC)) != MAGIC:
+                raise ValueError(f"{file_path} is not a time series store.")
+            while True:
+                header = file.read(CHUNK_HEADER.size)
+                if len(header) < CHUNK_HEADER.size:
+                    break
+                chunk_type, series_id, payload_size, number_of_records, first_time, last_time = \
+                    CHUNK_HEADER.unpack(header)
+                payload = file.read(payload_size)
+                if len(payload) < payload_size:
+                    break  # truncated by an aborted run
+                if chunk_type == SCHEMA_CHUNK and series_id == len(self.series_columns):
+                    self._read_schema(series_id, payload)
+                elif chunk_type == DATA_CHUNK and series_id < len(self.series_columns):
+                    self.series_chunks[series_id].append(
+                        (file.tell() - payload_size, number_of_records, first_time, last_time))
+
+    def _read_schema(self, series_id, payload):
+        def read_string(offset):
+            (length,) = struct.unpack_from("<Q", payload, offset)
+            offset += 8
+            return payload[offset:offset + length].decode(), offset + length
+
+        series_name, offset = read_string(0)
+        (number_of_columns,) = struct.unpack_from("<Q", payload, offset)
+        offset += 8
+        column_names = []
+        for _ in range(number_of_columns):
+            offset += 4  # column type, float64 only by now
+            column_name, offset = read_string(offset)
+            column_names.append(column_name)
+        self.series_ids[series_name] = series_id
+        self.series_columns.append(column_names)
+        self.series_chunks.append([])
+
+    def series_names(self):
+        return list(self.series_ids.keys())
+
+    def column_names(self, series_name):
+        return self.series_columns[self.series_ids[series_name]]
+
+    def read(self, series_name, start_time=-float("inf"), end_time=float("inf")):
+        """Returns the columns of the records with start_time <= time <= end_time,
+        the first column is the time. A restarted run records again from its restart time,
+        so that only the latest run is read, i.e. the records at or after the first time
+        of a later chunk of the series are dropped."""
+        series_id = self.series_ids[series_name]
+        chunks = self.series_chunks[series_id]
+        superseded_times = [float("inf")] * len(chunks)
+        for k in reversed(range(len(chunks) - 1)):
+            superseded_times[k] = min(superseded_times[k + 1], chunks[k + 1][2])
+        columns = [array("d") for _ in self.series_columns[series_id]]
+        with open(self.file_path, "rb") as file:
+            for (offset, number_of_records, first_time, last_time), superseded_time in zip(chunks, superseded_times):
+                if last_time < start_time or first_time > end_time or first_time >= superseded_time:
+                    continue
+                file.seek(offset)
+                chunk_columns = array("d")
+                chunk_columns.fromfile(file, number_of_records * len(columns))
+                if sys.byteorder != "little":
+                    chunk_columns.byteswap()
+                times = chunk_columns[:number_of_records]
+                first = next((i for i, time in enumerate(times) if time >= start_time), number_of_records)
+                last = next((i for i in reversed(range(number_of_records))
+                             if times[i] <= end_time and times[i] < superseded_time), -1) + 1
+                for j, column in enumerate(columns):
+                    column.extend(chunk_columns[j * number_of_records + first:j * number_of_records + last])
+        return columns
+
+
+if __name__ == "__main__":
+    store = TimeSeriesStore(sys.argv[1] if len(sys.argv) > 1 else "output/TimeSeries.sts")
+    for name in store.series_names():
+        columns = store.read(name)
+        print(f"{name}: {len(columns[0])} records of {', '.join(store.column_names(name))}")
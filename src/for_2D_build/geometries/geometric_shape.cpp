@@ -26,6 +26,12 @@ Vec2d GeometricShapeBox::findClosestPoint(const Vec2d &probe_point)
     return multi_polygon_.findClosestPoint(probe_point);
 }
 //=================================================================================================//
+bool GeometricShapeBox::hashGeometry(ContentHash &content_hash)
+{
+    content_hash.add(std::string("GeometricShapeBox")).add(halfsize_);
+    return true;
+}
+//=================================================================================================//
 BoundingBox GeometricShapeBox::findBounds()
 {
     return BoundingBox(-halfsize_, halfsize_);
@@ -40,6 +46,12 @@ bool GeometricShapeBall::checkContain(const Vec2d &probe_point, bool BOUNDARY_IN
     return (probe_point - center_).norm() < radius_;
 }
 //=================================================================================================//
+bool GeometricShapeBall::hashGeometry(ContentHash &content_hash)
+{
+    content_hash.add(std::string("GeometricShapeBall")).add(center_).add(radius_);
+    return true;
+}
+//=================================================================================================//
 Vec2d GeometricShapeBall::findClosestPoint(const Vec2d &probe_point)
 {
     Vec2d displacement = probe_point - center_;
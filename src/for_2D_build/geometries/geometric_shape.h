@@ -43,6 +43,7 @@ class GeometricShapeBox : public Shape
 
     virtual bool checkContain(const Vec2d &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vec2d findClosestPoint(const Vec2d &probe_point) override;
+    virtual bool hashGeometry(ContentHash &content_hash) override;
 
   protected:
     Vec2d halfsize_;
@@ -63,6 +64,7 @@ class GeometricShapeBall : public Shape
 
     virtual bool checkContain(const Vec2d &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vec2d findClosestPoint(const Vec2d &probe_point) override;
+    virtual bool hashGeometry(ContentHash &content_hash) override;
 
   protected:
     virtual BoundingBox findBounds() override;
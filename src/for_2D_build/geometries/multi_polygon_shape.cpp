@@ -269,6 +269,15 @@ bool MultiPolygonShape::isValid()
     return multi_polygon_.getBoostMultiPoly().size() == 0 ? false : true;
 }
 //=================================================================================================//
+bool MultiPolygonShape::hashGeometry(ContentHash &content_hash)
+{
+    content_hash.add(std::string("MultiPolygonShape"));
+    for_each_point(multi_polygon_.getBoostMultiPoly(),
+                   [&](const model::d2::point_xy<Real> &point)
+                   { content_hash.add(point.x()).add(point.y()); });
+    return true;
+}
+//=================================================================================================//
 bool MultiPolygonShape::checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED)
 {
     return multi_polygon_.checkContain(probe_point, BOUNDARY_INCLUDED);
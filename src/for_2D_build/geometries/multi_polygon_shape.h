@@ -109,6 +109,7 @@ class MultiPolygonShape : public Shape
     virtual bool isValid() override;
     virtual bool checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vecd findClosestPoint(const Vecd &probe_point) override;
+    virtual bool hashGeometry(ContentHash &content_hash) override;
 
   protected:
     MultiPolygon multi_polygon_;
@@ -9,44 +9,91 @@
 namespace SPH
 {
 //=================================================================================================//
-void ParticleGenerator<BaseParticles, Lattice>::prepareGeometricData()
+StdLargeVec<Vecd> GeneratingMethod<Lattice>::findLatticePositionsInShape()
 {
     BaseMesh mesh(domain_bounds_, lattice_spacing_, 0);
-    Real particle_volume = lattice_spacing_ * lattice_spacing_;
     Arrayi number_of_lattices = mesh.AllCellsFromAllGridPoints(mesh.AllGridPoints());
-    for (int i = 0; i < number_of_lattices[0]; ++i)
-        for (int j = 0; j < number_of_lattices[1]; ++j)
+    Arrayi number_of_tiles = (number_of_lattices + Arrayi::Constant(tile_size_ - 1)) / tile_size_;
+
+    // 1 for the tiles far outside, -1 for those deep inside and 0 for those cut by the surface
+    StdLargeVec<int> tile_states(number_of_tiles.prod());
+    parallel_for(
+        IndexRange(0, tile_states.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                Arrayi tile(n / number_of_tiles[1], n % number_of_tiles[1]);
+                Arrayi first_cell = tile * tile_size_;
+                Arrayi last_cell = (first_cell + Arrayi::Constant(tile_size_ - 1)).min(number_of_lattices - Arrayi::Ones());
+                Vecd first_position = mesh.CellPositionFromIndex(first_cell);
+                Vecd last_position = mesh.CellPositionFromIndex(last_cell);
+                // one lattice spacing as safety margin for approximated signed distances, e.g. from level sets
+                Real tile_radius = 0.5 * (last_position - first_position).norm() + lattice_spacing_;
+                Real signed_distance = initial_shape_.findSignedDistance(0.5 * (first_position + last_position));
+                tile_states[n] = signed_distance > tile_radius ? 1 : (signed_distance < -tile_radius ? -1 : 0);
+            }
+        },
+        ap);
+
+    size_t number_of_rows = number_of_lattices[0];
+    StdLargeVec<StdVec<int>> contained_in_rows(number_of_rows);
+    parallel_for(
+        IndexRange(0, number_of_rows),
+        [&](const IndexRange &r)
         {
-            Vecd particle_position = mesh.CellPositionFromIndex(Arrayi(i, j));
-            if (initial_shape_.checkNotFar(particle_position, lattice_spacing_))
+            for (size_t row = r.begin(); row != r.end(); ++row)
             {
-                if (initial_shape_.checkContain(particle_position))
+                int i = row;
+                size_t tile_row = (i / tile_size_) * number_of_tiles[1];
+                for (int j = 0; j < number_of_lattices[1]; ++j)
                 {
-                    addPositionAndVolumetricMeasure(particle_position, particle_volume);
+                    int tile_state = tile_states[tile_row + j / tile_size_];
+                    if (tile_state == -1 ||
+                        (tile_state == 0 && initial_shape_.checkContain(mesh.CellPositionFromIndex(Arrayi(i, j)))))
+                        contained_in_rows[row].push_back(j);
                 }
             }
-        }
+        },
+        ap);
+
+    StdLargeVec<size_t> row_offsets(number_of_rows + 1, 0);
+    for (size_t row = 0; row != number_of_rows; ++row)
+        row_offsets[row + 1] = row_offsets[row] + contained_in_rows[row].size();
+
+    StdLargeVec<Vecd> lattice_positions(row_offsets[number_of_rows]);
+    parallel_for(
+        IndexRange(0, number_of_rows),
+        [&](const IndexRange &r)
+        {
+            for (size_t row = r.begin(); row != r.end(); ++row)
+            {
+                for (size_t n = 0; n != contained_in_rows[row].size(); ++n)
+                    lattice_positions[row_offsets[row] + n] =
+                        mesh.CellPositionFromIndex(Arrayi(int(row), contained_in_rows[row][n]));
+            }
+        },
+        ap);
+    return lattice_positions;
+}
+//=================================================================================================//
+void ParticleGenerator<BaseParticles, Lattice>::prepareGeometricData()
+{
+    Real particle_volume = lattice_spacing_ * lattice_spacing_;
+    StdLargeVec<Vecd> lattice_positions = findLatticePositionsInShape();
+    position_.reserve(lattice_positions.size());
+    volumetric_measure_.reserve(lattice_positions.size());
+    for (const Vecd &particle_position : lattice_positions)
+        addPositionAndVolumetricMeasure(particle_position, particle_volume);
 }
 //=================================================================================================//
 void ParticleGenerator<SurfaceParticles, Lattice>::prepareGeometricData()
 {
     // Calculate the total volume and
     // count the number of cells inside the body volume, where we might put particles.
-    std::unique_ptr<BaseMesh> mesh(new BaseMesh(domain_bounds_, lattice_spacing_, 0));
-    Arrayi number_of_lattices = mesh->AllCellsFromAllGridPoints(mesh->AllGridPoints());
-    for (int i = 0; i < number_of_lattices[0]; ++i)
-        for (int j = 0; j < number_of_lattices[1]; ++j)
-        {
-            Vecd particle_position = mesh->CellPositionFromIndex(Arrayi(i, j));
-            if (initial_shape_.checkNotFar(particle_position, lattice_spacing_))
-            {
-                if (initial_shape_.checkContain(particle_position))
-                {
-                    all_cells_++;
-                    total_volume_ += lattice_spacing_ * lattice_spacing_;
-                }
-            }
-        }
+    StdLargeVec<Vecd> lattice_positions = findLatticePositionsInShape();
+    all_cells_ = lattice_positions.size();
+    total_volume_ = Real(all_cells_) * lattice_spacing_ * lattice_spacing_;
     Real number_of_particles = total_volume_ / avg_particle_volume_ + 0.5;
     planned_number_of_particles_ = int(number_of_particles);
 
@@ -60,24 +107,16 @@ void ParticleGenerator<SurfaceParticles, Lattice>::prepareGeometricData()
     std::uniform_real_distribution<Real> unif(0, 1);
 
     // Add a particle in each interval, randomly. We will skip the last intervals if we already reach the number of particles
-    for (int i = 0; i < number_of_lattices[0]; ++i)
-        for (int j = 0; j < number_of_lattices[1]; ++j)
+    for (const Vecd &particle_position : lattice_positions)
+    {
+        Real random_real = unif(rng);
+        // If the random_real is smaller than the interval, add a particle, only if we haven't reached the max. number of particles
+        if (random_real <= interval && base_particles_.TotalRealParticles() < planned_number_of_particles_)
         {
-            Vecd particle_position = mesh->CellPositionFromIndex(Arrayi(i, j));
-            if (initial_shape_.checkNotFar(particle_position, lattice_spacing_))
-            {
-                if (initial_shape_.checkContain(particle_position))
-                {
-                    Real random_real = unif(rng);
-                    // If the random_real is smaller than the interval, add a particle, only if we haven't reached the max. number of particles
-                    if (random_real <= interval && base_particles_.TotalRealParticles() < planned_number_of_particles_)
-                    {
-                        addPositionAndVolumetricMeasure(particle_position, avg_particle_volume_ / thickness_);
-                        addSurfaceProperties(initial_shape_.findNormalDirection(particle_position), thickness_);
-                    }
-                }
-            }
+            addPositionAndVolumetricMeasure(particle_position, avg_particle_volume_ / thickness_);
+            addSurfaceProperties(initial_shape_.findNormalDirection(particle_position), thickness_);
         }
+    }
 }
 //=================================================================================================//
 } // namespace SPH
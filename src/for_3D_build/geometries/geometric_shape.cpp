@@ -52,6 +52,12 @@ Vec3d GeometricShapeBox::findClosestPoint(const Vec3d &probe_point)
     return Vecd(out_pnt[0], out_pnt[1], out_pnt[2]);
 }
 //=================================================================================================//
+bool GeometricShapeBox::hashGeometry(ContentHash &content_hash)
+{
+    content_hash.add(std::string("GeometricShapeBox")).add(halfsize_);
+    return true;
+}
+//=================================================================================================//
 BoundingBox GeometricShapeBox::findBounds()
 {
     return BoundingBox(-halfsize_, halfsize_);
@@ -69,6 +75,12 @@ bool GeometricShapeBall::checkContain(const Vec3d &probe_point, bool BOUNDARY_IN
     return (probe_point - center_).norm() < sphere_.getRadius();
 }
 //=================================================================================================//
+bool GeometricShapeBall::hashGeometry(ContentHash &content_hash)
+{
+    content_hash.add(std::string("GeometricShapeBall")).add(center_).add(Real(sphere_.getRadius()));
+    return true;
+}
+//=================================================================================================//
 Vec3d GeometricShapeBall::findClosestPoint(const Vec3d &probe_point)
 {
     Vec3d displacement = probe_point - center_;
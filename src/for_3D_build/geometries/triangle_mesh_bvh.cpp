@@ -0,0 +1,369 @@
+#include "triangle_mesh_bvh.h"
+
+#include <algorithm>
+
+namespace SPH
+{
+//=================================================================================================//
+TriangleMeshBVH::TriangleMeshBVH(const StdVec<Vec3d> &vertices, const StdVec<std::array<int, 3>> &faces)
+    : vertices_(vertices), faces_(faces)
+{
+    if (faces_.empty())
+    {
+        std::cout << "\n Error: the triangle mesh for the BVH has no faces!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    StdVec<Vec3d> centroids(faces_.size());
+    for (size_t i = 0; i != faces_.size(); ++i)
+        centroids[i] = (vertices_[faces_[i][0]] + vertices_[faces_[i][1]] + vertices_[faces_[i][2]]) / 3.0;
+
+    nodes_.reserve(2 * faces_.size() / max_faces_in_leaf_ + 1);
+    nodes_.push_back(Node());
+    buildNode(0, 0, faces_.size(), 0, centroids);
+}
+//=================================================================================================//
+void TriangleMeshBVH::computeNodeBoundsAndDipole(Node &node, size_t first, size_t last)
+{
+    node.lower_bound_ = MaxReal * Vec3d::Ones();
+    node.upper_bound_ = -MaxReal * Vec3d::Ones();
+    node.dipole_area_ = Vec3d::Zero();
+    Vec3d weighted_center = Vec3d::Zero();
+    Real total_area = 0.0;
+    for (size_t i = first; i != last; ++i)
+    {
+        const Vec3d &v0 = vertices_[faces_[i][0]];
+        const Vec3d &v1 = vertices_[faces_[i][1]];
+        const Vec3d &v2 = vertices_[faces_[i][2]];
+        node.lower_bound_ = node.lower_bound_.cwiseMin(v0).cwiseMin(v1).cwiseMin(v2);
+        node.upper_bound_ = node.upper_bound_.cwiseMax(v0).cwiseMax(v1).cwiseMax(v2);
+
+        Vec3d area = 0.5 * (v1 - v0).cross(v2 - v0);
+        Real area_norm = area.norm();
+        node.dipole_area_ += area;
+        weighted_center += area_norm * (v0 + v1 + v2) / 3.0;
+        total_area += area_norm;
+    }
+    node.dipole_center_ = total_area > TinyReal ? Vec3d(weighted_center / total_area)
+                                                : Vec3d(0.5 * (node.lower_bound_ + node.upper_bound_));
+
+    node.dipole_moment_ = Mat3d::Zero();
+    node.quadrupole_moment_.fill(Mat3d::Zero());
+    node.dipole_radius_ = 0.0;
+    for (size_t i = first; i != last; ++i)
+    {
+        const Vec3d &v0 = vertices_[faces_[i][0]];
+        const Vec3d &v1 = vertices_[faces_[i][1]];
+        const Vec3d &v2 = vertices_[faces_[i][2]];
+        Vec3d area = 0.5 * (v1 - v0).cross(v2 - v0);
+        Vec3d offset_sum = v0 + v1 + v2 - 3.0 * node.dipole_center_;
+        node.dipole_moment_ += area * offset_sum.transpose() / 3.0;
+        // exact second moment of a triangle divided by its area
+        Mat3d second_moment = offset_sum * offset_sum.transpose();
+        for (int k = 0; k != 3; ++k)
+        {
+            Vec3d offset = vertices_[faces_[i][k]] - node.dipole_center_;
+            second_moment += offset * offset.transpose();
+            node.dipole_radius_ = SMAX(node.dipole_radius_, offset.norm());
+        }
+        for (int k = 0; k != 3; ++k)
+            node.quadrupole_moment_[k] += area[k] * second_moment / 12.0;
+    }
+}
+//=================================================================================================//
+void TriangleMeshBVH::buildNode(size_t node_index, size_t first, size_t last, size_t depth, StdVec<Vec3d> &centroids)
+{
+    computeNodeBoundsAndDipole(nodes_[node_index], first, last);
+    nodes_[node_index].first_ = first;
+    nodes_[node_index].number_of_faces_ = last - first;
+    // the depth is limited so that the traversal stacks have fixed size
+    if (last - first <= max_faces_in_leaf_ || depth == max_depth_)
+        return;
+
+    Vec3d centroid_lower = MaxReal * Vec3d::Ones();
+    Vec3d centroid_upper = -MaxReal * Vec3d::Ones();
+    for (size_t i = first; i != last; ++i)
+    {
+        centroid_lower = centroid_lower.cwiseMin(centroids[i]);
+        centroid_upper = centroid_upper.cwiseMax(centroids[i]);
+    }
+    Vec3d centroid_extent = centroid_upper - centroid_lower;
+
+    // surface area heuristic on binned centroids for all axes
+    auto surface_area = [](const Vec3d &lower, const Vec3d &upper)
+    {
+        Vec3d extent = (upper - lower).cwiseMax(Vec3d::Zero());
+        return extent[0] * extent[1] + extent[1] * extent[2] + extent[2] * extent[0];
+    };
+    auto bin_index = [&](const Vec3d &centroid, int axis)
+    {
+        size_t index = size_t(Real(number_of_bins_) * (centroid[axis] - centroid_lower[axis]) / centroid_extent[axis]);
+        return SMIN(index, number_of_bins_ - 1);
+    };
+
+    Real best_cost = MaxReal;
+    int best_axis = -1;
+    size_t best_split = 0;
+    for (int axis = 0; axis != 3; ++axis)
+    {
+        if (centroid_extent[axis] < TinyReal)
+            continue;
+
+        StdVec<size_t> bin_counts(number_of_bins_, 0);
+        StdVec<Vec3d> bin_lower(number_of_bins_, MaxReal * Vec3d::Ones());
+        StdVec<Vec3d> bin_upper(number_of_bins_, -MaxReal * Vec3d::Ones());
+        for (size_t i = first; i != last; ++i)
+        {
+            size_t bin = bin_index(centroids[i], axis);
+            bin_counts[bin]++;
+            for (int k = 0; k != 3; ++k)
+            {
+                bin_lower[bin] = bin_lower[bin].cwiseMin(vertices_[faces_[i][k]]);
+                bin_upper[bin] = bin_upper[bin].cwiseMax(vertices_[faces_[i][k]]);
+            }
+        }
+
+        // sweep from the right to obtain the costs of all right parts
+        StdVec<Real> right_costs(number_of_bins_, 0.0);
+        Vec3d lower = MaxReal * Vec3d::Ones();
+        Vec3d upper = -MaxReal * Vec3d::Ones();
+        size_t count = 0;
+        for (size_t bin = number_of_bins_ - 1; bin != 0; --bin)
+        {
+            lower = lower.cwiseMin(bin_lower[bin]);
+            upper = upper.cwiseMax(bin_upper[bin]);
+            count += bin_counts[bin];
+            right_costs[bin] = Real(count) * surface_area(lower, upper);
+        }
+
+        lower = MaxReal * Vec3d::Ones();
+        upper = -MaxReal * Vec3d::Ones();
+        count = 0;
+        for (size_t split = 1; split != number_of_bins_; ++split)
+        {
+            lower = lower.cwiseMin(bin_lower[split - 1]);
+            upper = upper.cwiseMax(bin_upper[split - 1]);
+            count += bin_counts[split - 1];
+            Real cost = Real(count) * surface_area(lower, upper) + right_costs[split];
+            if (count != 0 && count != last - first && cost < best_cost)
+            {
+                best_cost = cost;
+                best_axis = axis;
+                best_split = split;
+            }
+        }
+    }
+
+    size_t middle = first + (last - first) / 2;
+    if (best_axis >= 0)
+    {
+        // partition the faces together with their centroids
+        size_t left_end = first;
+        for (size_t i = first; i != last; ++i)
+            if (bin_index(centroids[i], best_axis) < best_split)
+            {
+                std::swap(faces_[i], faces_[left_end]);
+                std::swap(centroids[i], centroids[left_end]);
+                left_end++;
+            }
+        middle = left_end;
+    }
+    // otherwise, all centroids coincide and the faces are split evenly
+
+    size_t left_child = nodes_.size();
+    nodes_.push_back(Node());
+    nodes_.push_back(Node());
+    nodes_[node_index].first_ = left_child;
+    nodes_[node_index].number_of_faces_ = 0;
+    buildNode(left_child, first, middle, depth + 1, centroids);
+    buildNode(left_child + 1, middle, last, depth + 1, centroids);
+}
+//=================================================================================================//
+Real TriangleMeshBVH::SquaredDistanceToBox(const Vec3d &probe_point, const Node &node)
+{
+    Vec3d outside = (node.lower_bound_ - probe_point).cwiseMax(probe_point - node.upper_bound_).cwiseMax(Vec3d::Zero());
+    return outside.squaredNorm();
+}
+//=================================================================================================//
+Vec3d TriangleMeshBVH::ClosestPointOnFace(const Vec3d &probe_point, size_t face_index)
+{
+    // "Real-Time Collision Detection", Ericson, C., Section 5.1.5
+    const Vec3d &a = vertices_[faces_[face_index][0]];
+    const Vec3d &b = vertices_[faces_[face_index][1]];
+    const Vec3d &c = vertices_[faces_[face_index][2]];
+    Vec3d ab = b - a;
+    Vec3d ac = c - a;
+    Vec3d ap = probe_point - a;
+    Real d1 = ab.dot(ap);
+    Real d2 = ac.dot(ap);
+    if (d1 <= 0.0 && d2 <= 0.0)
+        return a;
+
+    Vec3d bp = probe_point - b;
+    Real d3 = ab.dot(bp);
+    Real d4 = ac.dot(bp);
+    if (d3 >= 0.0 && d4 <= d3)
+        return b;
+
+    Real vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+        return a + d1 / (d1 - d3) * ab;
+
+    Vec3d cp = probe_point - c;
+    Real d5 = ab.dot(cp);
+    Real d6 = ac.dot(cp);
+    if (d6 >= 0.0 && d5 <= d6)
+        return c;
+
+    Real vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+        return a + d2 / (d2 - d6) * ac;
+
+    Real va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+        return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+
+    Real denominator = 1.0 / (va + vb + vc);
+    return a + ab * vb * denominator + ac * vc * denominator;
+}
+//=================================================================================================//
+Real TriangleMeshBVH::FaceSolidAngle(const Vec3d &probe_point, size_t face_index)
+{
+    // "The solid angle of a plane triangle", Van Oosterom, A. and Strackee, J.,
+    // IEEE Transactions on Biomedical Engineering, 1983.
+    Vec3d a = vertices_[faces_[face_index][0]] - probe_point;
+    Vec3d b = vertices_[faces_[face_index][1]] - probe_point;
+    Vec3d c = vertices_[faces_[face_index][2]] - probe_point;
+    Real a_norm = a.norm();
+    Real b_norm = b.norm();
+    Real c_norm = c.norm();
+    Real determinant = a.dot(b.cross(c));
+    Real denominator = a_norm * b_norm * c_norm + a.dot(b) * c_norm + b.dot(c) * a_norm + c.dot(a) * b_norm;
+    return 2.0 * atan2(determinant, denominator);
+}
+//=================================================================================================//
+Vec3d TriangleMeshBVH::findClosestPoint(const Vec3d &probe_point, size_t &face_index)
+{
+    Vec3d closest_point = probe_point;
+    Real closest_distance_sqr = MaxReal;
+    face_index = 0;
+
+    std::array<size_t, max_depth_ + 2> stack;
+    size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size != 0)
+    {
+        const Node &node = nodes_[stack[--stack_size]];
+        if (SquaredDistanceToBox(probe_point, node) >= closest_distance_sqr)
+            continue;
+
+        if (node.number_of_faces_ != 0)
+        {
+            for (size_t i = node.first_; i != node.first_ + node.number_of_faces_; ++i)
+            {
+                Vec3d point_on_face = ClosestPointOnFace(probe_point, i);
+                Real distance_sqr = (point_on_face - probe_point).squaredNorm();
+                if (distance_sqr < closest_distance_sqr)
+                {
+                    closest_distance_sqr = distance_sqr;
+                    closest_point = point_on_face;
+                    face_index = i;
+                }
+            }
+        }
+        else
+        {
+            // visit the nearer child first
+            size_t left_child = node.first_;
+            Real left_distance_sqr = SquaredDistanceToBox(probe_point, nodes_[left_child]);
+            Real right_distance_sqr = SquaredDistanceToBox(probe_point, nodes_[left_child + 1]);
+            bool is_left_nearer = left_distance_sqr < right_distance_sqr;
+            stack[stack_size++] = is_left_nearer ? left_child + 1 : left_child;
+            stack[stack_size++] = is_left_nearer ? left_child : left_child + 1;
+        }
+    }
+    return closest_point;
+}
+//=================================================================================================//
+Vec3d TriangleMeshBVH::findClosestPoint(const Vec3d &probe_point)
+{
+    size_t face_index;
+    return findClosestPoint(probe_point, face_index);
+}
+//=================================================================================================//
+Real TriangleMeshBVH::computeWindingNumber(const Vec3d &probe_point)
+{
+    Real solid_angle = 0.0;
+
+    std::array<size_t, max_depth_ + 2> stack;
+    size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size != 0)
+    {
+        const Node &node = nodes_[stack[--stack_size]];
+        Vec3d displacement = node.dipole_center_ - probe_point;
+        Real distance = displacement.norm();
+        if (distance > dipole_distance_ratio_ * node.dipole_radius_)
+        {
+            // second order expansion of the solid angle kernel (x - p) / |x - p|^3 around the dipole center
+            Real distance_2 = distance * distance;
+            Real distance_3 = distance_2 * distance;
+            Real quadrupole_trace = 0.0;
+            Real quadrupole_projection = 0.0;
+            Real quadrupole_contraction = 0.0;
+            for (int k = 0; k != 3; ++k)
+            {
+                quadrupole_trace += displacement[k] * node.quadrupole_moment_[k].trace();
+                quadrupole_projection += node.quadrupole_moment_[k].row(k).dot(displacement);
+                quadrupole_contraction += displacement[k] * displacement.dot(node.quadrupole_moment_[k] * displacement);
+            }
+            solid_angle += displacement.dot(node.dipole_area_) / distance_3 +
+                           (node.dipole_moment_.trace() -
+                            3.0 * displacement.dot(node.dipole_moment_ * displacement) / distance_2) /
+                               distance_3 +
+                           (-1.5 * (quadrupole_trace + 2.0 * quadrupole_projection) +
+                            7.5 * quadrupole_contraction / distance_2) /
+                               (distance_3 * distance_2);
+        }
+        else if (node.number_of_faces_ != 0)
+        {
+            for (size_t i = node.first_; i != node.first_ + node.number_of_faces_; ++i)
+                solid_angle += FaceSolidAngle(probe_point, i);
+        }
+        else
+        {
+            stack[stack_size++] = node.first_;
+            stack[stack_size++] = node.first_ + 1;
+        }
+    }
+    return solid_angle / (4.0 * Pi);
+}
+//=================================================================================================//
+void TriangleMeshBVH::findClosestPoints(const StdLargeVec<Vec3d> &positions, const IndexRange &index_range,
+                                        StdLargeVec<Vec3d> &closest_points)
+{
+    parallel_for(
+        index_range,
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                closest_points[i] = findClosestPoint(positions[i]);
+        },
+        ap);
+}
+//=================================================================================================//
+void TriangleMeshBVH::computeWindingNumbers(const StdLargeVec<Vec3d> &positions, const IndexRange &index_range,
+                                            StdLargeVec<Real> &winding_numbers)
+{
+    parallel_for(
+        index_range,
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                winding_numbers[i] = computeWindingNumber(positions[i]);
+        },
+        ap);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,100 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	triangle_mesh_bvh.h
+ * @brief 	Bounding volume hierarchy over the faces of a triangle mesh
+ *			for closest point and containment queries.
+ * @details The hierarchy is built with the surface area heuristic on binned face centroids.
+ *			Containment is decided by the generalized winding number,
+ *			which is close to one inside and zero outside even if the mesh has small holes or gaps.
+ *			Far clusters of faces are approximated by second order expansions during the summation,
+ *			see "Fast winding numbers for soups and clouds", Barill, G., et al., ACM TOG, 2018.
+ *			All queries only read the hierarchy and so can be called concurrently.
+ * @author	agent
+ */
+
+#ifndef TRIANGLE_MESH_BVH_H
+#define TRIANGLE_MESH_BVH_H
+
+#include "base_data_package.h"
+#include "sph_data_containers.h"
+
+#include <array>
+
+namespace SPH
+{
+/**
+ * @class TriangleMeshBVH
+ * @brief Bounding volume hierarchy for triangle meshes with consistently outward oriented faces.
+ */
+class TriangleMeshBVH
+{
+  public:
+    TriangleMeshBVH(const StdVec<Vec3d> &vertices, const StdVec<std::array<int, 3>> &faces);
+    virtual ~TriangleMeshBVH(){};
+
+    size_t NumberOfFaces() { return faces_.size(); };
+    /** closest point on the mesh surface and the index of the face it locates */
+    Vec3d findClosestPoint(const Vec3d &probe_point, size_t &face_index);
+    Vec3d findClosestPoint(const Vec3d &probe_point);
+    /** generalized winding number, approximately one inside and zero outside */
+    Real computeWindingNumber(const Vec3d &probe_point);
+    bool checkContain(const Vec3d &probe_point) { return computeWindingNumber(probe_point) > 0.5; };
+
+    /** batched and multithreaded queries for the positions in the index range,
+     *  the results are stored at the same indices as the positions. */
+    void findClosestPoints(const StdLargeVec<Vec3d> &positions, const IndexRange &index_range,
+                           StdLargeVec<Vec3d> &closest_points);
+    void computeWindingNumbers(const StdLargeVec<Vec3d> &positions, const IndexRange &index_range,
+                               StdLargeVec<Real> &winding_numbers);
+
+  protected:
+    struct Node
+    {
+        Vec3d lower_bound_, upper_bound_;
+        Vec3d dipole_center_;                    /**< area weighted centroid of the faces in the node */
+        Vec3d dipole_area_;                      /**< sum of the area weighted outward normals */
+        Mat3d dipole_moment_;                    /**< first moment of the area weighted normals about the center */
+        std::array<Mat3d, 3> quadrupole_moment_; /**< second moments, one matrix per normal component */
+        Real dipole_radius_;                     /**< radius of the sphere around the center enclosing the node */
+        size_t first_;                           /**< first face for a leaf, the left child for an inner node */
+        size_t number_of_faces_;                 /**< zero for an inner node */
+    };
+
+    StdVec<Vec3d> vertices_;
+    StdVec<std::array<int, 3>> faces_; /**< reordered so that the faces of a leaf are contiguous */
+    StdVec<Node> nodes_;
+    /** ratio of the distance to the radius of a node, beyond which the far field expansion is used */
+    const Real dipole_distance_ratio_ = 2.0;
+    const size_t max_faces_in_leaf_ = 4;
+    const size_t number_of_bins_ = 16;
+    static constexpr size_t max_depth_ = 48;
+
+    void buildNode(size_t node_index, size_t first, size_t last, size_t depth, StdVec<Vec3d> &centroids);
+    void computeNodeBoundsAndDipole(Node &node, size_t first, size_t last);
+    Real SquaredDistanceToBox(const Vec3d &probe_point, const Node &node);
+    Vec3d ClosestPointOnFace(const Vec3d &probe_point, size_t face_index);
+    Real FaceSolidAngle(const Vec3d &probe_point, size_t face_index);
+};
+} // namespace SPH
+#endif // TRIANGLE_MESH_BVH_H
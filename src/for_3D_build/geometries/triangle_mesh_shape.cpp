@@ -15,6 +15,19 @@ SimTK::ContactGeometry::TriangleMesh *TriangleMeshShape::generateTriangleMesh(co
     }
     std::cout << "num of faces:" << triangle_mesh->getNumFaces() << std::endl;
 
+    StdVec<Vec3d> vertices;
+    vertices.reserve(triangle_mesh->getNumVertices());
+    for (int i = 0; i != triangle_mesh->getNumVertices(); ++i)
+        vertices.push_back(SimTKToEigen(triangle_mesh->getVertexPosition(i)));
+
+    StdVec<std::array<int, 3>> faces;
+    faces.reserve(triangle_mesh->getNumFaces());
+    for (int i = 0; i != triangle_mesh->getNumFaces(); ++i)
+        faces.push_back({triangle_mesh->getFaceVertex(i, 0),
+                         triangle_mesh->getFaceVertex(i, 1),
+                         triangle_mesh->getFaceVertex(i, 2)});
+    bvh_ = bvh_ptr_keeper_.createPtr<TriangleMeshBVH>(vertices, faces);
+
     return triangle_mesh;
 }
 //=================================================================================================//
@@ -29,54 +42,25 @@ SimTK::ContactGeometry::TriangleMesh *TriangleMeshShape::getTriangleMesh()
     return triangle_mesh_;
 }
 //=================================================================================================//
-bool TriangleMeshShape::checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED)
+TriangleMeshBVH *TriangleMeshShape::getTriangleMeshBVH()
 {
-    SimTKVec2 uv_coordinate;
-    bool inside = false; // note that direct prediction is not reliable sometime.
-    int face_id;
-
-    SimTKVec3 closest_pnt = triangle_mesh_->findNearestPoint(EigenToSimTK(probe_point), inside, face_id, uv_coordinate);
-    Vec3d from_face_to_pnt = probe_point - SimTKToEigen(closest_pnt);
-    Real distance_to_pnt = from_face_to_pnt.norm();
-    Vec3d direction_to_pnt = from_face_to_pnt / (distance_to_pnt + TinyReal);
-    Vec3d face_normal = SimTKToEigen(triangle_mesh_->getFaceNormal(face_id));
-    Real cosine_angle = face_normal.dot(direction_to_pnt);
-
-    int ite = 0;
-    while (fabs(cosine_angle) < Eps)
+    if (bvh_ == nullptr)
     {
-        Vec3d jittered = probe_point; // jittering
-        for (int l = 0; l != probe_point.size(); ++l)
-            jittered[l] = probe_point[l] + rand_uniform(-0.5, 0.5) * (SqrtEps + distance_to_pnt * 0.1);
-        Vec3d from_face_to_jittered = jittered - SimTKToEigen(closest_pnt);
-        Vec3d direction_to_jittered = from_face_to_jittered / (from_face_to_jittered.norm() + TinyReal);
-        cosine_angle = face_normal.dot(direction_to_jittered);
-
-        ite++;
-        if (ite > 100)
-        {
-            std::cout << "\n Error: TriangleMeshShape::checkContain not able to achieve!  " << std::endl;
-            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-            exit(1);
-        }
+        std::cout << "\n Error: TriangleMesh not setup yet! \n";
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
     }
-
-    return cosine_angle < 0.0 ? true : false;
+    return bvh_;
+}
+//=================================================================================================//
+bool TriangleMeshShape::checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED)
+{
+    return bvh_->checkContain(probe_point);
 }
 //=================================================================================================//
 Vecd TriangleMeshShape::findClosestPoint(const Vecd &probe_point)
 {
-    bool inside = false;
-    int face_id;
-    SimTKVec2 norm;
-    SimTKVec3 closest_pnt = triangle_mesh_->findNearestPoint(SimTKVec3(probe_point[0], probe_point[1], probe_point[2]), inside, face_id, norm);
-    if (face_id < 0 && face_id > triangle_mesh_->getNumFaces())
-    {
-        std::cout << "\n Error the nearest point is not valid" << std::endl;
-        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-        throw;
-    }
-    return Vecd(closest_pnt[0], closest_pnt[1], closest_pnt[2]);
+    return bvh_->findClosestPoint(probe_point);
 }
 //=================================================================================================//
 BoundingBox TriangleMeshShape::findBounds()
@@ -129,7 +113,8 @@ TriangleMeshShapeCylinder::TriangleMeshShapeCylinder(SimTK::UnitVec3 axis, Real
 //=================================================================================================//
 TriangleMeshShapeSTL::TriangleMeshShapeSTL(const std::string &filepathname, Vec3d translation,
                                            Real scale_factor, const std::string &shape_name)
-    : TriangleMeshShape(shape_name)
+    : TriangleMeshShape(shape_name), file_path_name_(filepathname),
+      translation_(translation), scale_factor_(scale_factor)
 {
     if (!fs::exists(filepathname))
     {
@@ -142,38 +127,12 @@ TriangleMeshShapeSTL::TriangleMeshShapeSTL(const std::string &filepathname, Vec3
     polymesh.scaleMesh(scale_factor);
     polymesh.transformMesh(SimTKVec3(translation[0], translation[1], translation[2]));
     triangle_mesh_ = generateTriangleMesh(polymesh);
-
-    std::vector<std::array<Real, 3>> vertices;
-    vertices.reserve(polymesh.getNumVertices());
-    for (int i = 0; i < polymesh.getNumVertices(); i++)
-    {
-        const auto &p = polymesh.getVertexPosition(i);
-        vertices.push_back({Real(p[0]), Real(p[1]), Real(p[2])});
-    }
-
-    std::vector<std::array<int, 3>> faces;
-    faces.reserve(polymesh.getNumFaces());
-    for (int i = 0; i < polymesh.getNumFaces(); i++)
-    {
-        auto f1 = polymesh.getFaceVertex(i, 0);
-        auto f2 = polymesh.getFaceVertex(i, 1);
-        auto f3 = polymesh.getFaceVertex(i, 2);
-        faces.push_back({f1, f2, f3});
-    }
-    triangle_mesh_distance_.construct(vertices, faces);
-}
-//=================================================================================================//
-bool TriangleMeshShapeSTL::checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED)
-{
-    Real distance = triangle_mesh_distance_.signed_distance(probe_point).distance;
-
-    return distance < 0.0 ? true : false;
 }
 //=================================================================================================//
-Vecd TriangleMeshShapeSTL::findClosestPoint(const Vecd &probe_point)
+bool TriangleMeshShapeSTL::hashGeometry(ContentHash &content_hash)
 {
-    auto closest_pnt = triangle_mesh_distance_.signed_distance(probe_point).nearest_point;
-    return Vecd(closest_pnt[0], closest_pnt[1], closest_pnt[2]);
+    content_hash.add(std::string("TriangleMeshShapeSTL")).add(translation_).add(scale_factor_);
+    return content_hash.addFileContent(file_path_name_);
 }
 //=================================================================================================//
 } // namespace SPH
@@ -30,9 +30,9 @@
 #ifndef TRIANGULAR_MESH_SHAPE_H
 #define TRIANGULAR_MESH_SHAPE_H
 
-#include "TriangleMeshDistance.h"
 #include "all_simbody.h"
 #include "base_geometry.h"
+#include "triangle_mesh_bvh.h"
 
 #include <filesystem>
 #include <fstream>
@@ -50,26 +50,29 @@ class TriangleMeshShape : public Shape
 {
   private:
     UniquePtrKeeper<SimTK::ContactGeometry::TriangleMesh> triangle_mesh_ptr_keeper_;
+    UniquePtrKeeper<TriangleMeshBVH> bvh_ptr_keeper_;
 
   public:
     explicit TriangleMeshShape(const std::string &shape_name, const SimTK::PolygonalMesh *mesh = nullptr)
-        : Shape(shape_name), triangle_mesh_(nullptr)
+        : Shape(shape_name), triangle_mesh_(nullptr), bvh_(nullptr)
     {
         if (mesh)
             triangle_mesh_ = generateTriangleMesh(*mesh);
     };
-    /** Only reliable when the probe point is close to the shape surface.
-     * Need to be combined with level set shape and sign correction to avoid artifacts
-     * when probe distance is far from the surface. */
+    /** Decided by the generalized winding number, which is also reliable
+     * far from the surface and for meshes which are not exactly watertight. */
     virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vec3d findClosestPoint(const Vec3d &probe_point) override;
 
     SimTK::ContactGeometry::TriangleMesh *getTriangleMesh();
+    /** for batched and multithreaded closest point and containment queries */
+    TriangleMeshBVH *getTriangleMeshBVH();
 
   protected:
     SimTK::ContactGeometry::TriangleMesh *triangle_mesh_;
+    TriangleMeshBVH *bvh_;
 
-    /** generate triangle mesh from polygon mesh */
+    /** generate triangle mesh from polygon mesh and the bounding volume hierarchy on its faces */
     SimTK::ContactGeometry::TriangleMesh *generateTriangleMesh(const SimTK::PolygonalMesh &poly_mesh);
     virtual BoundingBox findBounds() override;
 };
@@ -131,13 +134,13 @@ class TriangleMeshShapeSTL : public TriangleMeshShape
                                   const std::string &shape_name = "TriangleMeshShapeSTL");
     virtual ~TriangleMeshShapeSTL(){};
 
-    /** Here, we use the open source method TriangleMeshDistance library.
-     * https://github.com/InteractiveComputerGraphics/TriangleMeshDistance/tree/main */
-    virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override;
-    virtual Vec3d findClosestPoint(const Vec3d &probe_point) override;
+    /** identified by the content of the STL file, not its name, and the transformation */
+    virtual bool hashGeometry(ContentHash &content_hash) override;
 
   protected:
-    tmd::TriangleMeshDistance triangle_mesh_distance_;
+    std::string file_path_name_;
+    Vec3d translation_;
+    Real scale_factor_;
 };
 } // namespace SPH
 
@@ -231,6 +231,92 @@ DataType MeshWithGridDataPackages<PKG_SIZE>::
     return bilinear_1 * beta[2] + bilinear_2 * alpha[2];
 }
 //=================================================================================================//
+template <int PKG_SIZE>
+template <class DataType>
+void MeshWithGridDataPackages<PKG_SIZE>::
+    probeMesh(MeshVariable<DataType> &mesh_variable, const StdLargeVec<Vecd> &positions,
+              const IndexVector &indices, StdLargeVec<DataType> &probed_values)
+{
+    StdVec<PackageProbe> probes;
+    IndexVector package_starts;
+    groupProbesByPackage(positions, indices, probes, package_starts);
+
+    auto mesh_variable_data = mesh_variable.DataField();
+    parallel_for(
+        IndexRange(0, package_starts.size() - 1),
+        [&](const IndexRange &r)
+        {
+            PackageTemporaryData<DataType> stencil;
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                size_t first = package_starts[n];
+                size_t last = package_starts[n + 1];
+                size_t package_index = probes[first].first;
+                Arrayi cell_index = CellIndexFromPosition(positions[probes[first].second]);
+                if (!isInnerDataPackage(cell_index))
+                {
+                    for (size_t i = first; i != last; ++i)
+                        probed_values[probes[i].second] = mesh_variable_data[package_index][0][0][0];
+                }
+                // gathering the stencil pays off only if it is used by enough probes
+                else if ((last - first) * 8 < (pkg_size + 1) * (pkg_size + 1) * (pkg_size + 1))
+                {
+                    for (size_t i = first; i != last; ++i)
+                    {
+                        const Vecd &position = positions[probes[i].second];
+                        probed_values[probes[i].second] = probeDataPackage(mesh_variable, package_index, cell_index, position);
+                    }
+                }
+                else
+                {
+                    gatherPackageStencil(mesh_variable, package_index, stencil);
+                    for (size_t i = first; i != last; ++i)
+                        probed_values[probes[i].second] = probePackageStencil(stencil, cell_index, positions[probes[i].second]);
+                }
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+template <int PKG_SIZE>
+template <class DataType>
+void MeshWithGridDataPackages<PKG_SIZE>::
+    gatherPackageStencil(MeshVariable<DataType> &mesh_variable, size_t package_index,
+                         PackageTemporaryData<DataType> &stencil)
+{
+    auto &neighborhood = cell_neighborhood_[package_index];
+    auto mesh_variable_data = mesh_variable.DataField();
+    for (int i = 0; i != pkg_size + 1; ++i)
+        for (int j = 0; j != pkg_size + 1; ++j)
+            for (int k = 0; k != pkg_size + 1; ++k)
+            {
+                NeighbourIndex neighbour_index = NeighbourIndexShift(Arrayi(i, j, k), neighborhood);
+                stencil[i][j][k] = mesh_variable_data[neighbour_index.first][neighbour_index.second[0]][neighbour_index.second[1]][neighbour_index.second[2]];
+            }
+}
+//=================================================================================================//
+template <int PKG_SIZE>
+template <class DataType>
+DataType MeshWithGridDataPackages<PKG_SIZE>::
+    probePackageStencil(const PackageTemporaryData<DataType> &stencil, const Arrayi &cell_index, const Vecd &position)
+{
+    Arrayi data_index = DataIndexFromPosition(cell_index, position);
+    Vecd data_position = DataPositionFromIndex(cell_index, data_index);
+    Vecd alpha = (position - data_position) / data_spacing_;
+    Vecd beta = Vecd::Ones() - alpha;
+
+    int i = data_index[0], j = data_index[1], k = data_index[2];
+    DataType bilinear_1 = stencil[i][j][k] * beta[0] * beta[1] +
+                          stencil[i + 1][j][k] * alpha[0] * beta[1] +
+                          stencil[i][j + 1][k] * beta[0] * alpha[1] +
+                          stencil[i + 1][j + 1][k] * alpha[0] * alpha[1];
+    DataType bilinear_2 = stencil[i][j][k + 1] * beta[0] * beta[1] +
+                          stencil[i + 1][j][k + 1] * alpha[0] * beta[1] +
+                          stencil[i][j + 1][k + 1] * beta[0] * alpha[1] +
+                          stencil[i + 1][j + 1][k + 1] * alpha[0] * alpha[1];
+    return bilinear_1 * beta[2] + bilinear_2 * alpha[2];
+}
+//=================================================================================================//
 } // namespace SPH
 //=================================================================================================//
 #endif // MESH_WITH_DATA_PACKAGES_3D_HPP
\ No newline at end of file
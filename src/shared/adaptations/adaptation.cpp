@@ -97,6 +97,20 @@ UniquePtr<BaseLevelSet> SPHAdaptation::createLevelSet(Shape &shape, Real refinem
     return makeUnique<RefinedMesh<LevelSet>>(shape.getBounds(), *coarser_level_sets.getMeshLevels().back(), shape, *this);
 }
 //=================================================================================================//
+UniquePtr<BaseLevelSet> SPHAdaptation::createLevelSet(Shape &shape, Real refinement_ratio,
+                                                      CacheFileReader &cache_file_reader)
+{
+    // the same spacing as the finest level set above
+    int total_levels = (int)log10(MinimumDimension(shape.getBounds()) / ReferenceSpacing()) + 2;
+    Real data_spacing = ReferenceSpacing() * pow(2.0, total_levels - 1) / refinement_ratio;
+    for (int level = 1; level != total_levels; ++level)
+        data_spacing *= 0.5;
+
+    UniquePtr<LevelSet> level_set = makeUnique<LevelSet>(shape.getBounds(), data_spacing, 4, shape, *this);
+    level_set->readCacheData(cache_file_reader);
+    return level_set;
+}
+//=================================================================================================//
 ParticleWithLocalRefinement::
     ParticleWithLocalRefinement(Real resolution_ref, Real h_spacing_ratio, Real system_refinement_ratio,
                                 int local_refinement_level)
@@ -143,6 +157,13 @@ UniquePtr<BaseLevelSet> ParticleWithLocalRefinement::createLevelSet(Shape &shape
                                           getLevelSetTotalLevel(), shape, *this);
 }
 //=================================================================================================//
+UniquePtr<BaseLevelSet> ParticleWithLocalRefinement::createLevelSet(Shape &shape, Real refinement_ratio,
+                                                                    CacheFileReader &cache_file_reader)
+{
+    return makeUnique<MultilevelLevelSet>(shape.getBounds(), ReferenceSpacing() / refinement_ratio,
+                                          getLevelSetTotalLevel(), shape, *this, cache_file_reader);
+}
+//=================================================================================================//
 Real ParticleRefinementByShape::smoothedSpacing(const Real &measure, const Real &transition_thickness)
 {
     Real ratio_ref = measure / (2.0 * transition_thickness);
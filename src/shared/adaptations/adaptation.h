@@ -38,6 +38,7 @@ namespace SPH
 
 class Shape;
 class BaseParticles;
+class CacheFileReader;
 class BodyRegionByCell;
 class BaseLevelSet;
 class BaseCellLinkedList;
@@ -81,6 +82,8 @@ class SPHAdaptation
 
     virtual UniquePtr<BaseCellLinkedList> createCellLinkedList(const BoundingBox &domain_bounds);
     virtual UniquePtr<BaseLevelSet> createLevelSet(Shape &shape, Real refinement_ratio);
+    /** the same level set as above but with the data read from a cache file */
+    virtual UniquePtr<BaseLevelSet> createLevelSet(Shape &shape, Real refinement_ratio, CacheFileReader &cache_file_reader);
 
     template <class KernelType, typename... Args>
     void resetKernel(Args &&...args)
@@ -119,6 +122,8 @@ class ParticleWithLocalRefinement : public SPHAdaptation
     virtual void initializeAdaptationVariables(BaseParticles &base_particles) override;
     virtual UniquePtr<BaseCellLinkedList> createCellLinkedList(const BoundingBox &domain_bounds) override;
     virtual UniquePtr<BaseLevelSet> createLevelSet(Shape &shape, Real refinement_ratio) override;
+    virtual UniquePtr<BaseLevelSet> createLevelSet(Shape &shape, Real refinement_ratio,
+                                                   CacheFileReader &cache_file_reader) override;
 
   protected:
     Real finest_spacing_bound_;   /**< the adaptation bound for finest particles */
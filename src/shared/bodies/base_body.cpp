@@ -104,11 +104,37 @@ void SPHBody::readParticlesFromXmlForRestart(std::string &filefullpath)
     base_particles_->readParticleFromXmlForRestart(filefullpath);
 }
 //=================================================================================================//
+void SPHBody::writeParticlesToBinaryForRestart(const std::string &filefullpath, Real physical_time,
+                                               bool is_incremental, bool is_change_tracked)
+{
+    base_particles_->writeParticlesToBinaryForRestart(filefullpath, physical_time, is_incremental, is_change_tracked);
+}
+//=================================================================================================//
+Real SPHBody::readParticlesFromBinaryForRestart(const std::string &filefullpath)
+{
+    return base_particles_->readParticlesFromBinaryForRestart(filefullpath);
+}
+//=================================================================================================//
 void SPHBody::writeToXmlForReloadParticle(std::string &filefullpath)
 {
     base_particles_->writeToXmlForReloadParticle(filefullpath);
 }
 //=================================================================================================//
+void SPHBody::reportMemoryUsage(MemoryReport &memory_report)
+{
+    if (base_particles_ != nullptr)
+    {
+        base_particles_->reportMemoryUsage(memory_report);
+    }
+
+    for (SPHRelation *relation : body_relations_)
+    {
+        relation->reportMemoryUsage(memory_report);
+    }
+
+    initial_shape_->reportMemoryUsage(memory_report, body_name_);
+}
+//=================================================================================================//
 BaseCellLinkedList &RealBody::getCellLinkedList()
 {
     if (!cell_linked_list_created_)
@@ -135,4 +161,13 @@ void RealBody::updateCellLinkedListWithParticleSort(size_t particle_sorting_peri
     updateCellLinkedList();
 }
 //=================================================================================================//
+void RealBody::reportMemoryUsage(MemoryReport &memory_report)
+{
+    SPHBody::reportMemoryUsage(memory_report);
+    if (cell_linked_list_created_)
+    {
+        cell_linked_list_ptr_->reportMemoryUsage(memory_report, getName());
+    }
+}
+//=================================================================================================//
 } // namespace SPH
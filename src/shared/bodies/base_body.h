@@ -176,7 +176,12 @@ class SPHBody
     virtual void writeParticlesToPltFile(std::ofstream &output_file);
     virtual void writeParticlesToXmlForRestart(std::string &filefullpath);
     virtual void readParticlesFromXmlForRestart(std::string &filefullpath);
+    virtual void writeParticlesToBinaryForRestart(const std::string &filefullpath, Real physical_time,
+                                                  bool is_incremental = false, bool is_change_tracked = false);
+    virtual Real readParticlesFromBinaryForRestart(const std::string &filefullpath);
     virtual void writeToXmlForReloadParticle(std::string &filefullpath);
+    /** add the memory of particles, relations and geometric data of this body to the report */
+    virtual void reportMemoryUsage(MemoryReport &memory_report);
     virtual SPHBody *ThisObjectPtr() { return this; };
 };
 
@@ -204,6 +209,7 @@ class RealBody : public SPHBody
     BaseCellLinkedList &getCellLinkedList();
     void updateCellLinkedList();
     void updateCellLinkedListWithParticleSort(size_t particle_sort_period);
+    virtual void reportMemoryUsage(MemoryReport &memory_report) override;
 };
 } // namespace SPH
 #endif // BASE_BODY_H
@@ -137,6 +137,13 @@ NearShapeSurface::NearShapeSurface(RealBody &real_body, const std::string &sub_s
     tagCells(tagging_cell_method);
 }
 //=================================================================================================//
+void NearShapeSurface::updateCellsNearSurface()
+{
+    body_part_cells_.clear();
+    TaggingCellMethod tagging_cell_method = std::bind(&NearShapeSurface::checkNearSurface, this, _1, _2);
+    tagCells(tagging_cell_method);
+}
+//=================================================================================================//
 bool NearShapeSurface::checkNearSurface(Vecd cell_position, Real threshold)
 {
     return level_set_shape_.checkNearSurface(cell_position, threshold);
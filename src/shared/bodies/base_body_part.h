@@ -208,6 +208,8 @@ class NearShapeSurface : public BodyPartByCell
     NearShapeSurface(RealBody &real_body, const std::string &sub_shape_name);
     virtual ~NearShapeSurface(){};
     LevelSetShape &getLevelSetShape() { return level_set_shape_; };
+    /** tag the cells again after the level set shape is moved by a new transform */
+    void updateCellsNearSurface();
 
   private:
     LevelSetShape &level_set_shape_;
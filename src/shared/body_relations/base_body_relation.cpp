@@ -42,6 +42,12 @@ void BaseInnerRelation::resetNeighborhoodCurrentSize()
         ap);
 }
 //=================================================================================================//
+void BaseInnerRelation::reportMemoryUsage(MemoryReport &memory_report)
+{
+    memory_report.addEntry(sph_body_.getName(), "relations", "inner_configuration",
+                           configurationMemoryUsage(inner_configuration_, base_particles_.TotalRealParticles()));
+}
+//=================================================================================================//
 BaseContactRelation::BaseContactRelation(SPHBody &sph_body, RealBodyVector contact_sph_bodies)
     : SPHRelation(sph_body), contact_bodies_(contact_sph_bodies)
 {
@@ -70,4 +76,14 @@ void BaseContactRelation::resetNeighborhoodCurrentSize()
     }
 }
 //=================================================================================================//
+void BaseContactRelation::reportMemoryUsage(MemoryReport &memory_report)
+{
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        memory_report.addEntry(sph_body_.getName(), "relations",
+                               "contact_configuration_" + contact_bodies_[k]->getName(),
+                               configurationMemoryUsage(contact_configuration_[k], base_particles_.TotalRealParticles()));
+    }
+}
+//=================================================================================================//
 } // namespace SPH
@@ -112,6 +112,8 @@ class SPHRelation
 
     void subscribeToBody() { sph_body_.body_relations_.push_back(this); };
     virtual void updateConfiguration() = 0;
+    /** add the memory allocated and used by the particle configurations to the report */
+    virtual void reportMemoryUsage(MemoryReport &memory_report){};
 
   protected:
     SPHBody &sph_body_;
@@ -134,6 +136,7 @@ class BaseInnerRelation : public SPHRelation
     explicit BaseInnerRelation(RealBody &real_body);
     virtual ~BaseInnerRelation(){};
     BaseInnerRelation &getRelation() { return *this; };
+    virtual void reportMemoryUsage(MemoryReport &memory_report) override;
 };
 
 /**
@@ -154,6 +157,7 @@ class BaseContactRelation : public SPHRelation
         : BaseContactRelation(sph_body, BodyPartsToRealBodies(contact_body_parts)){};
     virtual ~BaseContactRelation(){};
     BaseContactRelation &getRelation() { return *this; };
+    virtual void reportMemoryUsage(MemoryReport &memory_report) override;
 };
 } // namespace SPH
 #endif // BASE_BODY_RELATION_H
\ No newline at end of file
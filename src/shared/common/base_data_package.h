@@ -58,7 +58,10 @@ using DataAssemble = std::tuple<KeeperType<ContainerType<size_t>>,
                                 KeeperType<ContainerType<Vec2d>>,
                                 KeeperType<ContainerType<Mat2d>>,
                                 KeeperType<ContainerType<Vec3d>>,
-                                KeeperType<ContainerType<Mat3d>>>;
+                                KeeperType<ContainerType<Mat3d>>,
+                                KeeperType<ContainerType<float>>,
+                                KeeperType<ContainerType<Vec2f>>,
+                                KeeperType<ContainerType<Vec3f>>>;
 /** Generalized data container assemble type */
 template <template <typename> typename ContainerType>
 using DataContainerAssemble = DataAssemble<DataContainerKeeper, ContainerType>;
@@ -84,6 +84,9 @@ using Vec3d = Eigen::Matrix<Real, 3, 1>;
 /** Small, 2*2 and 3*3, matrix with float point number. */
 using Mat2d = Eigen::Matrix<Real, 2, 2>;
 using Mat3d = Eigen::Matrix<Real, 3, 3>;
+/** Vector with single-precision float point number, used for reduced-precision storage. */
+using Vec2f = Eigen::Matrix<float, 2, 1>;
+using Vec3f = Eigen::Matrix<float, 3, 1>;
 /** AlignedBox */
 using AlignedBox2d = Eigen::AlignedBox<Real, 2>;
 using AlignedBox3d = Eigen::AlignedBox<Real, 3>;
@@ -131,6 +134,69 @@ struct IdentityMatrix
     static inline DataType value = DataType::Identity();
 };
 
+/**
+ * Reduced-precision storage for selected particle variables.
+ * A variable registered with ReducedData<DataType> is stored in single precision,
+ * while the local dynamics still accumulate in ComputingData, i.e. in Real,
+ * and only convert the result by precisionCast when writing it back.
+ * With SPHINXSYS_USE_FLOAT, both are identical to the original data type.
+ */
+template <typename DataType>
+struct ReducedPrecision
+{
+    using type = DataType;
+};
+template <>
+struct ReducedPrecision<Real>
+{
+    using type = float;
+};
+template <>
+struct ReducedPrecision<Vec2d>
+{
+    using type = Vec2f;
+};
+template <>
+struct ReducedPrecision<Vec3d>
+{
+    using type = Vec3f;
+};
+template <typename DataType>
+using ReducedData = typename ReducedPrecision<DataType>::type;
+
+template <typename DataType>
+struct ComputingPrecision
+{
+    using type = DataType;
+};
+template <>
+struct ComputingPrecision<float>
+{
+    using type = Real;
+};
+template <>
+struct ComputingPrecision<Vec2f>
+{
+    using type = Vec2d;
+};
+template <>
+struct ComputingPrecision<Vec3f>
+{
+    using type = Vec3d;
+};
+template <typename DataType>
+using ComputingData = typename ComputingPrecision<DataType>::type;
+
+/** Conversion between the storage and computing precisions. */
+template <typename TargetType, typename SourceType>
+inline TargetType precisionCast(const SourceType &value)
+{
+    if constexpr (std::is_arithmetic_v<SourceType>)
+        return static_cast<TargetType>(value);
+    else
+        return value.template cast<typename TargetType::Scalar>();
+}
+
 /** Type trait for data type index. */
 template <typename T>
 struct DataTypeIndex
@@ -172,6 +238,24 @@ struct DataTypeIndex<Mat3d>
 {
     static constexpr int value = 6;
 };
+#if !SPHINXSYS_USE_FLOAT
+/** Reduced-precision types, which are identical to the above types when Real is float. */
+template <>
+struct DataTypeIndex<float>
+{
+    static constexpr int value = 7;
+};
+template <>
+struct DataTypeIndex<Vec2f>
+{
+    static constexpr int value = 8;
+};
+template <>
+struct DataTypeIndex<Vec3f>
+{
+    static constexpr int value = 9;
+};
+#endif
 
 /** Verbal boolean for positive and negative axis directions. */
 const int xAxis = 0;
@@ -272,6 +356,9 @@ class BaseTransform
         : rotation_(MatType::Identity()), inv_rotation_(rotation_.transpose()), translation_(translation){};
     BaseTransform() : BaseTransform(VecType::Zero()){};
 
+    const MatType &RotationMatrix() const { return rotation_; };
+    const VecType &Translation() const { return translation_; };
+
     /** Forward rotation. */
     VecType xformFrameVecToBase(const VecType &origin)
     {
@@ -0,0 +1,275 @@
+#include "cache_file.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPHINXSYS_CACHE_FILE_MMAP 1
+#endif
+
+namespace fs = std::filesystem;
+
+namespace SPH
+{
+//=================================================================================================//
+ContentHash &ContentHash::addBytes(const void *data, size_t size)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i != size; ++i)
+    {
+        value_ ^= bytes[i];
+        value_ *= 1099511628211ULL;
+    }
+    return *this;
+}
+//=================================================================================================//
+ContentHash &ContentHash::add(const std::string &value)
+{
+    add(value.size());
+    return addBytes(value.data(), value.size());
+}
+//=================================================================================================//
+bool ContentHash::addFileContent(const std::string &file_path)
+{
+    std::ifstream in_file(file_path.c_str(), std::ios::binary);
+    if (!in_file.is_open())
+        return false;
+
+    StdVec<char> buffer(1 << 20);
+    while (in_file)
+    {
+        in_file.read(buffer.data(), buffer.size());
+        addBytes(buffer.data(), in_file.gcount());
+    }
+    return true;
+}
+//=================================================================================================//
+std::string ContentHash::HexDigest() const
+{
+    std::ostringstream digest;
+    digest << std::hex << std::setw(16) << std::setfill('0') << value_;
+    return digest.str();
+}
+//=================================================================================================//
+LargeDataHash &LargeDataHash::addBytes(const void *data, size_t size)
+{
+    const char *bytes = static_cast<const char *>(data);
+    size_ += size;
+    // complete the current part first
+    size_t to_current_part = SMIN(size, part_size_ - current_part_size_);
+    current_part_.addBytes(bytes, to_current_part);
+    current_part_size_ += to_current_part;
+    bytes += to_current_part;
+    size -= to_current_part;
+    if (current_part_size_ == part_size_)
+    {
+        part_hashes_.push_back(current_part_.Value());
+        current_part_ = ContentHash();
+        current_part_size_ = 0;
+    }
+
+    size_t number_of_complete_parts = size / part_size_;
+    size_t first_part = part_hashes_.size();
+    part_hashes_.resize(first_part + number_of_complete_parts);
+    parallel_for(
+        IndexRange(0, number_of_complete_parts),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                part_hashes_[first_part + i] = ContentHash().addBytes(bytes + i * part_size_, part_size_).Value();
+        },
+        ap);
+
+    size_t rest = size - number_of_complete_parts * part_size_;
+    current_part_.addBytes(bytes + number_of_complete_parts * part_size_, rest);
+    current_part_size_ += rest;
+    return *this;
+}
+//=================================================================================================//
+uint64_t LargeDataHash::Value() const
+{
+    ContentHash hash;
+    hash.add(size_).addBytes(part_hashes_.data(), part_hashes_.size() * sizeof(uint64_t));
+    if (current_part_size_ != 0)
+        hash.add(current_part_.Value());
+    return hash.Value();
+}
+//=================================================================================================//
+uint64_t hashLargeData(const void *data, size_t size)
+{
+    return LargeDataHash().addBytes(data, size).Value();
+}
+//=================================================================================================//
+CacheFileHeader::CacheFileHeader(uint64_t key)
+    : magic_{'S', 'P', 'H', 'C', 'A', 'C', 'H', 'E'}, version_(2), dimensions_(Dimensions),
+      real_size_(sizeof(Real)), reserved_(0), key_(key), payload_size_(0), checksum_(0) {}
+//=================================================================================================//
+bool CacheFileHeader::isCompatible(const CacheFileHeader &other) const
+{
+    return std::memcmp(magic_, other.magic_, sizeof(magic_)) == 0 &&
+           version_ == other.version_ && dimensions_ == other.dimensions_ &&
+           real_size_ == other.real_size_ && key_ == other.key_;
+}
+//=================================================================================================//
+CacheFileWriter::CacheFileWriter(const std::string &file_path, uint64_t key)
+    : file_path_(file_path), header_(key)
+{
+    fs::path parent_path = fs::path(file_path_).parent_path();
+    if (!parent_path.empty() && !fs::exists(parent_path))
+        fs::create_directories(parent_path);
+
+    auto time_stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    temporary_path_ = file_path_ + ".tmp" + std::to_string(time_stamp);
+    out_file_.open(temporary_path_.c_str(), std::ios::binary | std::ios::trunc);
+    out_file_.write(reinterpret_cast<const char *>(&header_), sizeof(CacheFileHeader));
+}
+//=================================================================================================//
+CacheFileWriter::~CacheFileWriter()
+{
+    if (out_file_.is_open())
+    {
+        out_file_.close();
+        std::remove(temporary_path_.c_str());
+    }
+}
+//=================================================================================================//
+void CacheFileWriter::writeBytes(const void *data, size_t size)
+{
+    out_file_.write(static_cast<const char *>(data), size);
+    checksum_.addBytes(data, size);
+    header_.payload_size_ += size;
+}
+//=================================================================================================//
+void CacheFileWriter::write(const std::string &value)
+{
+    write(value.size());
+    writeBytes(value.data(), value.size());
+}
+//=================================================================================================//
+bool CacheFileWriter::commit()
+{
+    header_.checksum_ = checksum_.Value();
+    out_file_.seekp(0);
+    out_file_.write(reinterpret_cast<const char *>(&header_), sizeof(CacheFileHeader));
+    out_file_.close();
+    if (out_file_.fail())
+    {
+        std::remove(temporary_path_.c_str());
+        return false;
+    }
+
+    std::error_code error_code;
+    fs::rename(temporary_path_, file_path_, error_code);
+    if (error_code)
+    {
+        std::remove(temporary_path_.c_str());
+        return false;
+    }
+    return true;
+}
+//=================================================================================================//
+CacheFileReader::CacheFileReader(const std::string &file_path, uint64_t key)
+    : data_(nullptr), mapped_size_(0), cursor_(nullptr), end_(nullptr)
+{
+    if (!fs::exists(file_path))
+        return;
+
+#ifdef SPHINXSYS_CACHE_FILE_MMAP
+    int file_descriptor = open(file_path.c_str(), O_RDONLY);
+    if (file_descriptor < 0)
+        return;
+    struct stat file_status;
+    if (fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0)
+    {
+        void *mapped = mmap(nullptr, file_status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (mapped != MAP_FAILED)
+        {
+            data_ = static_cast<const char *>(mapped);
+            mapped_size_ = file_status.st_size;
+        }
+    }
+    close(file_descriptor);
+#else
+    std::ifstream in_file(file_path.c_str(), std::ios::binary | std::ios::ate);
+    std::streamoff file_size = in_file.is_open() ? std::streamoff(in_file.tellg()) : -1;
+    if (file_size < 0)
+        return;
+    buffer_.resize(file_size);
+    in_file.seekg(0);
+    in_file.read(buffer_.data(), buffer_.size());
+    data_ = buffer_.data();
+    mapped_size_ = in_file ? buffer_.size() : 0;
+#endif
+
+    if (mapped_size_ < sizeof(CacheFileHeader))
+        return;
+    CacheFileHeader header;
+    std::memcpy(&header, data_, sizeof(CacheFileHeader));
+    if (!CacheFileHeader(key).isCompatible(header) ||
+        header.payload_size_ != mapped_size_ - sizeof(CacheFileHeader))
+        return;
+
+    const char *payload = data_ + sizeof(CacheFileHeader);
+    if (hashLargeData(payload, header.payload_size_) != header.checksum_)
+        return;
+
+    cursor_ = payload;
+    end_ = payload + header.payload_size_;
+}
+//=================================================================================================//
+CacheFileReader::CacheFileReader(CacheFileReader &&other) noexcept
+    : data_(other.data_), mapped_size_(other.mapped_size_), cursor_(other.cursor_), end_(other.end_),
+      buffer_(std::move(other.buffer_))
+{
+    other.data_ = nullptr;
+    other.mapped_size_ = 0;
+    other.cursor_ = nullptr;
+    other.end_ = nullptr;
+}
+//=================================================================================================//
+CacheFileReader::~CacheFileReader()
+{
+#ifdef SPHINXSYS_CACHE_FILE_MMAP
+    if (data_ != nullptr)
+        munmap(const_cast<char *>(data_), mapped_size_);
+#endif
+}
+//=================================================================================================//
+void CacheFileReader::readBytes(void *data, size_t size)
+{
+    if (cursor_ == nullptr || size > size_t(end_ - cursor_))
+    {
+        std::cout << "\n Error: reading beyond the end of a cache file!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    std::memcpy(data, cursor_, size);
+    cursor_ += size;
+}
+//=================================================================================================//
+void CacheFileReader::seek(size_t offset)
+{
+    const char *payload = data_ + sizeof(CacheFileHeader);
+    if (cursor_ == nullptr || offset > size_t(end_ - payload))
+    {
+        std::cout << "\n Error: seeking beyond the end of a cache file!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    cursor_ = payload + offset;
+}
+//=================================================================================================//
+void CacheFileReader::read(std::string &value)
+{
+    value.resize(read<size_t>());
+    readBytes(value.data(), value.size());
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,194 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	cache_file.h
+ * @brief 	Content-addressed binary cache files for results of expensive preprocessing,
+ *			such as level sets built from STL files and relaxed particles.
+ * @details	A cache file is identified by a hash of all the inputs which produce its content.
+ *			The file starts with a header holding the format version, the build dimension,
+ *			the size of Real, the input hash, the payload size and a checksum of the payload,
+ *			which is computed from 1 MiB parts in parallel, see LargeDataHash.
+ *			It is read through a memory map and accepted only when the whole header matches.
+ *			A cache file is written under a temporary name and renamed when finished,
+ *			so that concurrent runs, e.g. in a parameter sweep, never read a partial file.
+ * @author	agent
+ */
+
+#ifndef CACHE_FILE_H
+#define CACHE_FILE_H
+
+#include "data_type.h"
+#include "large_data_containers.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+
+namespace SPH
+{
+/**
+ * @class ContentHash
+ * @brief 64-bit FNV-1a hash accumulating the inputs which identify a cached result.
+ */
+class ContentHash
+{
+    uint64_t value_;
+
+  public:
+    ContentHash() : value_(14695981039346656037ULL){};
+
+    ContentHash &addBytes(const void *data, size_t size);
+    /** add an arithmetic value or the coefficients of an Eigen matrix */
+    template <typename DataType>
+    ContentHash &add(const DataType &value)
+    {
+        if constexpr (std::is_arithmetic<DataType>::value)
+        {
+            return addBytes(&value, sizeof(DataType));
+        }
+        else
+        {
+            for (Eigen::Index i = 0; i != value.size(); ++i)
+                add(value.data()[i]);
+            return *this;
+        }
+    };
+    ContentHash &add(const std::string &value);
+    /** add the content of a file, return false if the file can not be read */
+    bool addFileContent(const std::string &file_path);
+    uint64_t Value() const { return value_; };
+    std::string HexDigest() const;
+};
+
+/**
+ * @class LargeDataHash
+ * @brief Hash of a large data block, computed from the hashes of its 1 MiB parts.
+ * Data may be added in pieces of any size, complete parts of a piece are hashed in parallel.
+ */
+class LargeDataHash
+{
+    ContentHash current_part_;
+    size_t current_part_size_;
+    size_t size_;
+    StdVec<uint64_t> part_hashes_;
+
+  public:
+    static constexpr size_t part_size_ = 1 << 20;
+    LargeDataHash() : current_part_size_(0), size_(0){};
+
+    LargeDataHash &addBytes(const void *data, size_t size);
+    uint64_t Value() const;
+};
+
+/** hash of a large data block, computed from the hashes of its parts in parallel */
+uint64_t hashLargeData(const void *data, size_t size);
+
+/**
+ * @struct CacheFileHeader
+ * @brief Header at the beginning of a cache file.
+ */
+struct CacheFileHeader
+{
+    char magic_[8];
+    uint32_t version_;
+    uint32_t dimensions_;
+    uint32_t real_size_;
+    uint32_t reserved_;
+    uint64_t key_;
+    uint64_t payload_size_;
+    uint64_t checksum_;
+
+    explicit CacheFileHeader(uint64_t key = 0);
+    bool isCompatible(const CacheFileHeader &other) const;
+};
+
+/**
+ * @class CacheFileWriter
+ * @brief Write the payload of a cache file, which becomes visible only after commit.
+ * Only plain data, i.e. arithmetic values and fixed-size Eigen matrices, are written by value.
+ */
+class CacheFileWriter
+{
+    std::string file_path_, temporary_path_;
+    std::ofstream out_file_;
+    CacheFileHeader header_;
+    LargeDataHash checksum_;
+
+  public:
+    CacheFileWriter(const std::string &file_path, uint64_t key);
+    ~CacheFileWriter();
+
+    void writeBytes(const void *data, size_t size);
+    template <typename DataType>
+    void write(const DataType &value)
+    {
+        writeBytes(&value, sizeof(DataType));
+    };
+    void write(const std::string &value);
+    size_t PayloadSize() const { return header_.payload_size_; };
+    /** complete the header and rename the temporary file, return false if writing failed */
+    bool commit();
+};
+
+/**
+ * @class CacheFileReader
+ * @brief Read the payload of a memory-mapped cache file in the order it has been written.
+ */
+class CacheFileReader
+{
+    const char *data_;
+    size_t mapped_size_;
+    const char *cursor_;
+    const char *end_;
+    StdVec<char> buffer_; /**< file content if memory map is not available */
+
+  public:
+    CacheFileReader(const std::string &file_path, uint64_t key);
+    /** the memory map is owned by a single reader */
+    CacheFileReader(const CacheFileReader &) = delete;
+    CacheFileReader &operator=(const CacheFileReader &) = delete;
+    CacheFileReader(CacheFileReader &&other) noexcept;
+    ~CacheFileReader();
+
+    /** the file exists and its header and checksum match */
+    bool isValid() const { return cursor_ != nullptr; };
+    void readBytes(void *data, size_t size);
+    /** move the cursor to the offset in the payload */
+    void seek(size_t offset);
+    template <typename DataType>
+    void read(DataType &value)
+    {
+        readBytes(&value, sizeof(DataType));
+    };
+    void read(std::string &value);
+    template <typename DataType>
+    DataType read()
+    {
+        DataType value;
+        read(value);
+        return value;
+    };
+};
+} // namespace SPH
+#endif // CACHE_FILE_H
@@ -39,6 +39,12 @@
 #include "tbb/scalable_allocator.h"
 #include "tbb/tick_count.h"
 
+#include <cstdlib>
+#include <new>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 namespace SPH
 {
 
@@ -53,8 +59,67 @@ typedef tbb::tick_count::interval_t TimeInterval;
 template <typename T>
 using ConcurrentVec = tbb::concurrent_vector<T>;
 
+/**
+ * @class LargeDataAllocator
+ * @brief Cache aligned allocator for large data containers.
+ * On Linux, blocks not smaller than a huge page are aligned to the huge page size
+ * and their whole huge pages are advised to be backed by transparent huge pages,
+ * which reduces TLB misses when looping over particle data and neighbor lists.
+ * The block size is not padded to a huge page multiple,
+ * so that the allocated bytes are those of the container capacity.
+ * Note that each container is still allocated independently, no arena is shared.
+ */
+template <typename T>
+class LargeDataAllocator
+{
+  public:
+    using value_type = T;
+    static constexpr size_t huge_page_size_ = 2 * 1024 * 1024;
+
+    LargeDataAllocator() noexcept {};
+    template <typename U>
+    LargeDataAllocator(const LargeDataAllocator<U> &) noexcept {};
+
+    T *allocate(size_t n)
+    {
+#ifdef __linux__
+        if (isHugePageBlock(n))
+        {
+            void *ptr = nullptr;
+            if (posix_memalign(&ptr, huge_page_size_, n * sizeof(T)) != 0)
+                throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+            madvise(ptr, n * sizeof(T) / huge_page_size_ * huge_page_size_, MADV_HUGEPAGE);
+#endif
+            return static_cast<T *>(ptr);
+        }
+#endif
+        return tbb::cache_aligned_allocator<T>().allocate(n);
+    };
+
+    void deallocate(T *ptr, size_t n)
+    {
+#ifdef __linux__
+        if (isHugePageBlock(n))
+        {
+            std::free(ptr);
+            return;
+        }
+#endif
+        tbb::cache_aligned_allocator<T>().deallocate(ptr, n);
+    };
+
+  private:
+    static bool isHugePageBlock(size_t n) { return n * sizeof(T) >= huge_page_size_; };
+};
+
+template <typename T, typename U>
+bool operator==(const LargeDataAllocator<T> &, const LargeDataAllocator<U> &) { return true; };
+template <typename T, typename U>
+bool operator!=(const LargeDataAllocator<T> &, const LargeDataAllocator<U> &) { return false; };
+
 template <typename T>
-using StdLargeVec = std::vector<T, tbb::cache_aligned_allocator<T>>;
+using StdLargeVec = std::vector<T, LargeDataAllocator<T>>;
 
 template <typename T>
 using StdVec = std::vector<T>;
@@ -0,0 +1,157 @@
+#include "memory_report.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace SPH
+{
+//=================================================================================================//
+void MemoryReport::addEntry(const std::string &body_name, const std::string &subsystem_name,
+                            const std::string &item_name, const MemoryUsage &usage)
+{
+    entries_.push_back(Entry{body_name, subsystem_name, item_name, usage});
+}
+//=================================================================================================//
+MemoryUsage MemoryReport::TotalUsage() const
+{
+    MemoryUsage total;
+    for (const Entry &entry : entries_)
+        total += entry.usage_;
+    return total;
+}
+//=================================================================================================//
+MemoryUsage MemoryReport::BodyUsage(const std::string &body_name) const
+{
+    MemoryUsage body_usage;
+    for (const Entry &entry : entries_)
+        if (entry.body_name_ == body_name)
+            body_usage += entry.usage_;
+    return body_usage;
+}
+//=================================================================================================//
+MemoryUsage MemoryReport::SubsystemUsage(const std::string &body_name, const std::string &subsystem_name) const
+{
+    MemoryUsage subsystem_usage;
+    for (const Entry &entry : entries_)
+        if (entry.body_name_ == body_name && entry.subsystem_name_ == subsystem_name)
+            subsystem_usage += entry.usage_;
+    return subsystem_usage;
+}
+//=================================================================================================//
+StdVec<std::string> MemoryReport::BodyNames() const
+{
+    StdVec<std::string> body_names;
+    for (const Entry &entry : entries_)
+        if (std::find(body_names.begin(), body_names.end(), entry.body_name_) == body_names.end())
+            body_names.push_back(entry.body_name_);
+    return body_names;
+}
+//=================================================================================================//
+StdVec<std::string> MemoryReport::SubsystemNames(const std::string &body_name) const
+{
+    StdVec<std::string> subsystem_names;
+    for (const Entry &entry : entries_)
+        if (entry.body_name_ == body_name &&
+            std::find(subsystem_names.begin(), subsystem_names.end(), entry.subsystem_name_) == subsystem_names.end())
+            subsystem_names.push_back(entry.subsystem_name_);
+    return subsystem_names;
+}
+//=================================================================================================//
+std::string MemoryReport::formatUsage(const MemoryUsage &usage)
+{
+    return "allocated " + formatBytes(usage.allocated_) + ", used " + formatBytes(usage.used_) +
+           (usage.is_estimated_ ? " (estimated in part)" : "");
+}
+//=================================================================================================//
+std::string MemoryReport::formatBytes(size_t bytes)
+{
+    const char *units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    Real value = Real(bytes);
+    size_t unit = 0;
+    while (value >= 1024.0 && unit != 4)
+    {
+        value /= 1024.0;
+        unit++;
+    }
+    std::ostringstream formatted;
+    formatted << std::fixed << std::setprecision(2) << value << " " << units[unit];
+    return formatted.str();
+}
+//=================================================================================================//
+void MemoryReport::writeToStream(std::ostream &output_stream) const
+{
+    output_stream << "\n Memory report: " << formatUsage(TotalUsage()) << "\n";
+    for (const std::string &body_name : BodyNames())
+    {
+        output_stream << "  " << body_name << ": " << formatUsage(BodyUsage(body_name)) << "\n";
+        for (const std::string &subsystem_name : SubsystemNames(body_name))
+        {
+            MemoryUsage subsystem_usage = SubsystemUsage(body_name, subsystem_name);
+            output_stream << "    " << std::left << std::setw(24) << subsystem_name << std::right
+                          << " allocated " << std::setw(12) << formatBytes(subsystem_usage.allocated_)
+                          << ", used " << std::setw(12) << formatBytes(subsystem_usage.used_)
+                          << (subsystem_usage.is_estimated_ ? " (estimated in part)" : "") << "\n";
+        }
+    }
+    output_stream << std::endl;
+}
+//=================================================================================================//
+void MemoryReport::writeToJson(const std::string &filefullpath, Real physical_time) const
+{
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+    MemoryUsage total = TotalUsage();
+    out_file << "{\n";
+    out_file << "  \"physical_time\": " << std::setprecision(9) << physical_time << ",\n";
+    out_file << "  \"allocated\": " << total.allocated_ << ",\n";
+    out_file << "  \"used\": " << total.used_ << ",\n";
+    out_file << "  \"bodies\": [";
+
+    StdVec<std::string> body_names = BodyNames();
+    for (size_t i = 0; i != body_names.size(); ++i)
+    {
+        MemoryUsage body_usage = BodyUsage(body_names[i]);
+        out_file << (i == 0 ? "\n" : ",\n");
+        out_file << "    {\n";
+        out_file << "      \"name\": \"" << body_names[i] << "\",\n";
+        out_file << "      \"allocated\": " << body_usage.allocated_ << ",\n";
+        out_file << "      \"used\": " << body_usage.used_ << ",\n";
+        out_file << "      \"subsystems\": [";
+
+        StdVec<std::string> subsystem_names = SubsystemNames(body_names[i]);
+        for (size_t j = 0; j != subsystem_names.size(); ++j)
+        {
+            MemoryUsage subsystem_usage = SubsystemUsage(body_names[i], subsystem_names[j]);
+            out_file << (j == 0 ? "\n" : ",\n");
+            out_file << "        {\n";
+            out_file << "          \"name\": \"" << subsystem_names[j] << "\",\n";
+            out_file << "          \"allocated\": " << subsystem_usage.allocated_ << ",\n";
+            out_file << "          \"used\": " << subsystem_usage.used_ << ",\n";
+            out_file << "          \"items\": [";
+
+            bool is_first_item = true;
+            for (const Entry &entry : entries_)
+            {
+                if (entry.body_name_ == body_names[i] && entry.subsystem_name_ == subsystem_names[j])
+                {
+                    out_file << (is_first_item ? "\n" : ",\n");
+                    out_file << "            {\"name\": \"" << entry.item_name_
+                             << "\", \"allocated\": " << entry.usage_.allocated_
+                             << ", \"used\": " << entry.usage_.used_
+                             << (entry.usage_.is_estimated_ ? ", \"estimated\": true}" : "}");
+                    is_first_item = false;
+                }
+            }
+            out_file << "\n          ]\n";
+            out_file << "        }";
+        }
+        out_file << "\n      ]\n";
+        out_file << "    }";
+    }
+    out_file << "\n  ]\n";
+    out_file << "}\n";
+    out_file.close();
+}
+//=================================================================================================//
+} // namespace SPH
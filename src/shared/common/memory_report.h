@@ -0,0 +1,121 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	memory_report.h
+ * @brief 	Accounting of the memory allocated and used by bodies and their subsystems,
+ *			such as particle variables, particle configurations, cell linked lists and level sets.
+ * @details	The report is assembled by walking through the data containers.
+ *			Allocated bytes are those reserved by the containers (their capacity),
+ *			while used bytes are those holding valid data.
+ *			Usages which can only be estimated, such as those of xml documents,
+ *			are marked as such in the summary and in the JSON file.
+ * @author	agent
+ */
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include "base_data_type.h"
+#include "large_data_containers.h"
+
+#include <iostream>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @struct MemoryUsage
+ * @brief Bytes allocated and bytes used by a data container.
+ */
+struct MemoryUsage
+{
+    size_t allocated_ = 0;     /**< bytes reserved by the container */
+    size_t used_ = 0;          /**< bytes holding valid data */
+    bool is_estimated_ = false; /**< the bytes are estimated as the container does not expose its capacity */
+
+    MemoryUsage() = default;
+    MemoryUsage(size_t allocated, size_t used, bool is_estimated = false)
+        : allocated_(allocated), used_(used), is_estimated_(is_estimated){};
+    MemoryUsage &operator+=(const MemoryUsage &other)
+    {
+        allocated_ += other.allocated_;
+        used_ += other.used_;
+        is_estimated_ = is_estimated_ || other.is_estimated_;
+        return *this;
+    };
+};
+
+/** memory usage of a vector with given number of valid entries */
+template <typename DataType, class AllocatorType>
+MemoryUsage vectorMemoryUsage(const std::vector<DataType, AllocatorType> &data, size_t used_size)
+{
+    return MemoryUsage(data.capacity() * sizeof(DataType), used_size * sizeof(DataType));
+};
+
+/** memory usage of a vector of which all entries are valid */
+template <typename DataType, class AllocatorType>
+MemoryUsage vectorMemoryUsage(const std::vector<DataType, AllocatorType> &data)
+{
+    return vectorMemoryUsage(data, data.size());
+};
+
+/**
+ * @class MemoryReport
+ * @brief Collection of memory usage entries labeled by body, subsystem and item.
+ * Entries are kept in the order of adding and summarized per body and per subsystem.
+ */
+class MemoryReport
+{
+  public:
+    struct Entry
+    {
+        std::string body_name_;
+        std::string subsystem_name_;
+        std::string item_name_;
+        MemoryUsage usage_;
+    };
+
+    MemoryReport(){};
+    virtual ~MemoryReport(){};
+
+    void addEntry(const std::string &body_name, const std::string &subsystem_name,
+                  const std::string &item_name, const MemoryUsage &usage);
+    const StdVec<Entry> &Entries() const { return entries_; };
+    MemoryUsage TotalUsage() const;
+    MemoryUsage BodyUsage(const std::string &body_name) const;
+    MemoryUsage SubsystemUsage(const std::string &body_name, const std::string &subsystem_name) const;
+    /** print the summary per body and per subsystem */
+    void writeToStream(std::ostream &output_stream) const;
+    /** write all entries with the summaries in JSON format */
+    void writeToJson(const std::string &filefullpath, Real physical_time = 0.0) const;
+
+  protected:
+    StdVec<Entry> entries_;
+
+    StdVec<std::string> BodyNames() const;
+    StdVec<std::string> SubsystemNames(const std::string &body_name) const;
+    static std::string formatBytes(size_t bytes);
+    static std::string formatUsage(const MemoryUsage &usage);
+};
+} // namespace SPH
+#endif // MEMORY_REPORT_H
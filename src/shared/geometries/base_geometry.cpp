@@ -51,6 +51,26 @@ bool BinaryShapes::isValid()
     return sub_shapes_and_ops_.size() == 0 ? false : true;
 }
 //=================================================================================================//
+void BinaryShapes::reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name)
+{
+    for (auto &sub_shape_and_op : sub_shapes_and_ops_)
+    {
+        sub_shape_and_op.first->reportMemoryUsage(memory_report, owner_name);
+    }
+}
+//=================================================================================================//
+bool BinaryShapes::hashGeometry(ContentHash &content_hash)
+{
+    content_hash.add(std::string("BinaryShapes"));
+    for (auto &sub_shape_and_op : sub_shapes_and_ops_)
+    {
+        content_hash.add(static_cast<int>(sub_shape_and_op.second));
+        if (!sub_shape_and_op.first->hashGeometry(content_hash))
+            return false;
+    }
+    return true;
+}
+//=================================================================================================//
 BoundingBox BinaryShapes::findBounds()
 {
     // initial reference values
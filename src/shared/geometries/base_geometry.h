@@ -31,6 +31,8 @@
 #define BASE_GEOMETRY_H
 
 #include "base_data_package.h"
+#include "cache_file.h"
+#include "memory_report.h"
 #include "sph_data_containers.h"
 #include <string>
 
@@ -81,6 +83,11 @@ class Shape
     Real findSignedDistance(const Vecd &probe_point);
     /** Normal direction point toward outside of the shape. */
     Vecd findNormalDirection(const Vecd &probe_point);
+    /** add the memory of the geometric data, such as level sets, to the report */
+    virtual void reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name){};
+    /** Add the data defining the geometry to the hash identifying cached results.
+     *  Returns false if the geometry can not be identified by its data, and so can not be cached. */
+    virtual bool hashGeometry(ContentHash &content_hash) { return false; };
 
   protected:
     std::string name_;
@@ -123,6 +130,8 @@ class BinaryShapes : public Shape
     virtual bool isValid() override;
     virtual bool checkContain(const Vecd &pnt, bool BOUNDARY_INCLUDED = true) override;
     virtual Vecd findClosestPoint(const Vecd &probe_point) override;
+    virtual void reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name) override;
+    virtual bool hashGeometry(ContentHash &content_hash) override;
     Shape *getSubShapeByName(const std::string &name);
     SubShapeAndOp *getSubShapeAndOpByName(const std::string &name);
     size_t getSubShapeIndexByName(const std::string &name);
@@ -2,8 +2,11 @@
 
 #include "adaptation.h"
 #include "base_kernel.h"
+#include "io_vtk_binary.h"
 #include "mesh_iterators.hpp"
 
+#include "tbb/parallel_scan.h"
+
 namespace SPH
 {
 //=================================================================================================//
@@ -83,15 +86,97 @@ void LevelSet::finishDataPackages()
 //=================================================================================================//
 void LevelSet::initializeIndexMesh()
 {
-    mesh_for(MeshRange(Arrayi::Zero(), all_cells_),
-             [&](const Arrayi &cell_index)
-             {
-                 if (isInnerDataPackage(cell_index))
-                 {
-                     assignDataPackageIndex(cell_index, num_grid_pkgs_);
-                     num_grid_pkgs_++;
-                 }
-             });
+    // A prefix sum over the cells in their serial (row-major) order,
+    // so that the package indices are the same as those from a sequential loop.
+    size_t number_of_cells = all_cells_.prod();
+    size_t number_of_inner_packages = tbb::parallel_scan(
+        IndexRange(0, number_of_cells), size_t(0),
+        [&](const IndexRange &r, size_t sum, bool is_final_scan) -> size_t
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                Arrayi cell_index = transfer1DtoMeshIndex(all_cells_, i);
+                if (isInnerDataPackage(cell_index))
+                {
+                    if (is_final_scan)
+                        assignDataPackageIndex(cell_index, num_grid_pkgs_ + sum);
+                    sum++;
+                }
+            }
+            return sum;
+        },
+        [](size_t left, size_t right) -> size_t
+        { return left + right; });
+    num_grid_pkgs_ += number_of_inner_packages;
+}
+//=================================================================================================//
+void LevelSet::writeCacheData(CacheFileWriter &cache_file_writer)
+{
+    writeMeshDataToCache(cache_file_writer);
+}
+//=================================================================================================//
+void LevelSet::readCacheData(CacheFileReader &cache_file_reader)
+{
+    readMeshDataFromCache(cache_file_reader);
+    initializeCellNeighborhood();
+}
+//=================================================================================================//
+void LevelSet::writeMeshFieldToVtk(const std::string &file_path_without_extension)
+{
+    Arrayi all_grid_points = global_mesh_.AllGridPoints();
+    size_t total_grid_points = all_grid_points.prod();
+    Vec3d origin = upgradeToVec3d(global_mesh_.GridPositionFromIndex(Arrayi::Zero()));
+    std::stringstream extent;
+    for (int n = 0; n != 3; ++n)
+        extent << (n == 0 ? "" : " ") << "0 " << (n < Dimensions ? all_grid_points[n] - 1 : 0);
+
+    // the grid points of an image data are ordered with the x index running fastest
+    auto grid_index = [all_grid_points](size_t point_number)
+    {
+        Arrayi index = Arrayi::Zero();
+        for (int n = 0; n != Dimensions; ++n)
+        {
+            index[n] = point_number % all_grid_points[n];
+            point_number /= all_grid_points[n];
+        }
+        return index;
+    };
+    auto grid_data_filler = [&](auto &mesh_variable)
+    {
+        auto *variable = &mesh_variable;
+        return [this, variable, grid_index](size_t begin, size_t end, float *values)
+        {
+            for (size_t i = begin; i != end; ++i)
+            {
+                auto data_value = DataValueFromGlobalIndex(*variable, grid_index(i));
+                values = VtkComponents<decltype(data_value)>::copy(data_value, values);
+            }
+        };
+    };
+
+    VtkAppendedData appended_data(VtkEncoding::raw);
+    std::ofstream out_file(file_path_without_extension + ".vti", std::ios::trunc | std::ios::binary);
+    out_file << "<?xml version=\"1.0\"?>\n";
+    out_file << "<VTKFile type=\"ImageData\" " << appended_data.FileAttributes() << ">\n";
+    out_file << " <ImageData WholeExtent=\"" << extent.str() << "\" Origin=\"" << origin[0] << " " << origin[1] << " " << origin[2]
+             << "\" Spacing=\"" << data_spacing_ << " " << data_spacing_ << " " << data_spacing_ << "\">\n";
+    out_file << "  <Piece Extent=\"" << extent.str() << "\">\n";
+    out_file << "   <PointData Scalars=\"phi\" Vectors=\"phi_gradient\">\n";
+    out_file << appended_data.addFloat32Array("phi", 1, total_grid_points, grid_data_filler(phi_));
+    out_file << appended_data.addFloat32Array("phi_gradient", 3, total_grid_points, grid_data_filler(phi_gradient_));
+    out_file << appended_data.addFloat32Array("kernel_weight", 1, total_grid_points, grid_data_filler(kernel_weight_));
+    out_file << appended_data.addFloat32Array("kernel_gradient", 3, total_grid_points, grid_data_filler(kernel_gradient_));
+    out_file << appended_data.addInt32Array("near_interface_id", 1, total_grid_points,
+                                            [this, grid_index](size_t begin, size_t end, int *values)
+                                            {
+                                                for (size_t i = begin; i != end; ++i)
+                                                    *values++ = DataValueFromGlobalIndex(near_interface_id_, grid_index(i));
+                                            });
+    out_file << "   </PointData>\n";
+    out_file << "  </Piece>\n";
+    out_file << " </ImageData>\n";
+    appended_data.writeAppendedData(out_file);
+    out_file << "</VTKFile>\n";
 }
 //=================================================================================================//
 bool LevelSet::isWithinCorePackage(Vecd position)
@@ -100,6 +185,11 @@ bool LevelSet::isWithinCorePackage(Vecd position)
     return isCoreDataPackage(cell_index);
 }
 //=================================================================================================//
+void LevelSet::reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name)
+{
+    reportMeshDataMemory(memory_report, owner_name, "level_set", name_);
+}
+//=================================================================================================//
 void LevelSet::updateLevelSetGradient()
 {
     package_parallel_for(
@@ -159,6 +249,52 @@ Vecd LevelSet::probeKernelGradientIntegral(const Vecd &position, Real h_ratio)
     return probeMesh(kernel_gradient_, position);
 }
 //=================================================================================================//
+void LevelSet::probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                   StdLargeVec<Real> &signed_distances)
+{
+    probeMesh(phi_, positions, indices, signed_distances);
+}
+//=================================================================================================//
+void LevelSet::probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                    StdLargeVec<Vecd> &normal_directions)
+{
+    probeMesh(phi_gradient_, positions, indices, normal_directions);
+
+    Real threshold = 1.0e-2 * data_spacing_;
+    parallel_for(
+        IndexRange(0, indices.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                Vecd &normal_direction = normal_directions[indices[i]];
+                // jittering by the single-position version for vanishing gradients
+                normal_direction = normal_direction.norm() < threshold
+                                       ? probeNormalDirection(positions[indices[i]])
+                                       : normal_direction.normalized();
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void LevelSet::probeLevelSetGradient(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Vecd> &level_set_gradients)
+{
+    probeMesh(phi_gradient_, positions, indices, level_set_gradients);
+}
+//=================================================================================================//
+void LevelSet::probeKernelIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                   StdLargeVec<Real> &kernel_integrals, Real h_ratio)
+{
+    probeMesh(kernel_weight_, positions, indices, kernel_integrals);
+}
+//=================================================================================================//
+void LevelSet::probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                           StdLargeVec<Vecd> &kernel_gradient_integrals, Real h_ratio)
+{
+    probeMesh(kernel_gradient_, positions, indices, kernel_gradient_integrals);
+}
+//=================================================================================================//
 void LevelSet::redistanceInterface()
 {
     package_parallel_for(
@@ -291,6 +427,27 @@ MultilevelLevelSet::MultilevelLevelSet(
     : MultilevelMesh<BaseLevelSet, LevelSet>(
           tentative_bounds, reference_data_spacing, total_levels, shape, sph_adaptation) {}
 //=================================================================================================//
+MultilevelLevelSet::MultilevelLevelSet(
+    BoundingBox tentative_bounds, Real reference_data_spacing, size_t total_levels,
+    Shape &shape, SPHAdaptation &sph_adaptation, CacheFileReader &cache_file_reader)
+    : MultilevelMesh<BaseLevelSet, LevelSet>(total_levels, shape, sph_adaptation)
+{
+    // the same spacing and bounds as RefinedMesh<LevelSet> so that the meshes are identical
+    Real data_spacing = reference_data_spacing;
+    for (size_t level = 0; level != total_levels_; ++level)
+    {
+        addMeshLevel(tentative_bounds, data_spacing, 4, shape, sph_adaptation);
+        mesh_levels_.back()->readCacheData(cache_file_reader);
+        data_spacing *= 0.5;
+    }
+}
+//=================================================================================================//
+void MultilevelLevelSet::writeCacheData(CacheFileWriter &cache_file_writer)
+{
+    for (size_t level = 0; level != total_levels_; ++level)
+        mesh_levels_[level]->writeCacheData(cache_file_writer);
+}
+//=================================================================================================//
 size_t MultilevelLevelSet::getCoarseLevel(Real h_ratio)
 {
     for (size_t level = total_levels_; level != 0; --level)
@@ -358,6 +515,96 @@ Vecd MultilevelLevelSet::probeKernelGradientIntegral(const Vecd &position, Real
     return alpha * coarse_level_value + (1.0 - alpha) * fine_level_value;
 }
 //=================================================================================================//
+StdVec<IndexVector> MultilevelLevelSet::getProbeLevelIndices(const StdLargeVec<Vecd> &positions,
+                                                             const IndexVector &indices)
+{
+    IndexVector probe_levels(indices.size());
+    parallel_for(
+        IndexRange(0, indices.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                probe_levels[i] = getProbeLevel(positions[indices[i]]);
+        },
+        ap);
+
+    StdVec<IndexVector> level_indices(total_levels_);
+    for (size_t i = 0; i != indices.size(); ++i)
+        level_indices[probe_levels[i]].push_back(indices[i]);
+    return level_indices;
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Real> &signed_distances)
+{
+    StdVec<IndexVector> level_indices = getProbeLevelIndices(positions, indices);
+    for (size_t level = 0; level != total_levels_; ++level)
+        mesh_levels_[level]->probeSignedDistance(positions, level_indices[level], signed_distances);
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                              StdLargeVec<Vecd> &normal_directions)
+{
+    StdVec<IndexVector> level_indices = getProbeLevelIndices(positions, indices);
+    for (size_t level = 0; level != total_levels_; ++level)
+        mesh_levels_[level]->probeNormalDirection(positions, level_indices[level], normal_directions);
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeLevelSetGradient(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                               StdLargeVec<Vecd> &level_set_gradients)
+{
+    StdVec<IndexVector> level_indices = getProbeLevelIndices(positions, indices);
+    for (size_t level = 0; level != total_levels_; ++level)
+        mesh_levels_[level]->probeLevelSetGradient(positions, level_indices[level], level_set_gradients);
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeKernelIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Real> &kernel_integrals, Real h_ratio)
+{
+    size_t coarse_level = getCoarseLevel(h_ratio);
+    Real alpha = (mesh_levels_[coarse_level + 1]->global_h_ratio_ - h_ratio) /
+                 (mesh_levels_[coarse_level + 1]->global_h_ratio_ - mesh_levels_[coarse_level]->global_h_ratio_);
+    StdLargeVec<Real> fine_level_values(positions.size());
+    mesh_levels_[coarse_level]->probeKernelIntegral(positions, indices, kernel_integrals);
+    mesh_levels_[coarse_level + 1]->probeKernelIntegral(positions, indices, fine_level_values);
+
+    parallel_for(
+        IndexRange(0, indices.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                size_t index_i = indices[i];
+                kernel_integrals[index_i] = alpha * kernel_integrals[index_i] + (1.0 - alpha) * fine_level_values[index_i];
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                                     StdLargeVec<Vecd> &kernel_gradient_integrals, Real h_ratio)
+{
+    size_t coarse_level = getCoarseLevel(h_ratio);
+    Real alpha = (mesh_levels_[coarse_level + 1]->global_h_ratio_ - h_ratio) /
+                 (mesh_levels_[coarse_level + 1]->global_h_ratio_ - mesh_levels_[coarse_level]->global_h_ratio_);
+    StdLargeVec<Vecd> fine_level_values(positions.size());
+    mesh_levels_[coarse_level]->probeKernelGradientIntegral(positions, indices, kernel_gradient_integrals);
+    mesh_levels_[coarse_level + 1]->probeKernelGradientIntegral(positions, indices, fine_level_values);
+
+    parallel_for(
+        IndexRange(0, indices.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                size_t index_i = indices[i];
+                kernel_gradient_integrals[index_i] = alpha * kernel_gradient_integrals[index_i] +
+                                                     (1.0 - alpha) * fine_level_values[index_i];
+            }
+        },
+        ap);
+}
+//=================================================================================================//
 bool MultilevelLevelSet::probeIsWithinMeshBound(const Vecd &position)
 {
     bool is_bounded = true;
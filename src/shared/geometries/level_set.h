@@ -55,6 +55,20 @@ class BaseLevelSet : public BaseMeshField
     virtual Vecd probeLevelSetGradient(const Vecd &position) = 0;
     virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) = 0;
     virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) = 0;
+    /** Batched probes at the positions of the given indices, e.g. particle indices.
+     *  The probed values are stored at the same indices of the output vectors. */
+    virtual void probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &signed_distances) = 0;
+    virtual void probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                      StdLargeVec<Vecd> &normal_directions) = 0;
+    virtual void probeLevelSetGradient(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                       StdLargeVec<Vecd> &level_set_gradients) = 0;
+    virtual void probeKernelIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &kernel_integrals, Real h_ratio = 1.0) = 0;
+    virtual void probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Vecd> &kernel_gradient_integrals, Real h_ratio = 1.0) = 0;
+    /** write the level set data to a cache file, see LevelSetShape */
+    virtual void writeCacheData(CacheFileWriter &cache_file_writer) = 0;
 
   protected:
     Shape &shape_; /**< the geometry is described by the level set. */
@@ -96,7 +110,23 @@ class LevelSet : public MeshWithGridDataPackages<4>,
     virtual Vecd probeLevelSetGradient(const Vecd &position) override;
     virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) override;
     virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) override;
+    virtual void probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &signed_distances) override;
+    virtual void probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                      StdLargeVec<Vecd> &normal_directions) override;
+    virtual void probeLevelSetGradient(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                       StdLargeVec<Vecd> &level_set_gradients) override;
+    virtual void probeKernelIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &kernel_integrals, Real h_ratio = 1.0) override;
+    virtual void probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Vecd> &kernel_gradient_integrals, Real h_ratio = 1.0) override;
     virtual void writeMeshFieldToPlt(std::ofstream &output_file) override;
+    /** write the grid data of all packages as a raw binary image data, i.e. .vti, file */
+    virtual void writeMeshFieldToVtk(const std::string &file_path_without_extension) override;
+    virtual void reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name) override;
+    virtual void writeCacheData(CacheFileWriter &cache_file_writer) override;
+    /** fill a level set from the far-field-only constructor with the data of the cache file */
+    void readCacheData(CacheFileReader &cache_file_reader);
     bool isWithinCorePackage(Vecd position);
     Real computeKernelIntegral(const Vecd &position);
     Vecd computeKernelGradientIntegral(const Vecd &position);
@@ -149,6 +179,9 @@ class MultilevelLevelSet : public MultilevelMesh<BaseLevelSet, LevelSet>
 {
   public:
     MultilevelLevelSet(BoundingBox tentative_bounds, Real reference_data_spacing, size_t total_levels, Shape &shape, SPHAdaptation &sph_adaptation);
+    /** This constructor reads all levels from a cache file instead of building them. */
+    MultilevelLevelSet(BoundingBox tentative_bounds, Real reference_data_spacing, size_t total_levels, Shape &shape,
+                       SPHAdaptation &sph_adaptation, CacheFileReader &cache_file_reader);
     virtual ~MultilevelLevelSet(){};
 
     virtual void cleanInterface(Real small_shift_factor) override;
@@ -159,10 +192,23 @@ class MultilevelLevelSet : public MultilevelMesh<BaseLevelSet, LevelSet>
     virtual Vecd probeLevelSetGradient(const Vecd &position) override;
     virtual Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0) override;
     virtual Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0) override;
+    virtual void probeSignedDistance(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &signed_distances) override;
+    virtual void probeNormalDirection(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                      StdLargeVec<Vecd> &normal_directions) override;
+    virtual void probeLevelSetGradient(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                       StdLargeVec<Vecd> &level_set_gradients) override;
+    virtual void probeKernelIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                     StdLargeVec<Real> &kernel_integrals, Real h_ratio = 1.0) override;
+    virtual void probeKernelGradientIntegral(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                                             StdLargeVec<Vecd> &kernel_gradient_integrals, Real h_ratio = 1.0) override;
+    virtual void writeCacheData(CacheFileWriter &cache_file_writer) override;
 
   protected:
     inline size_t getProbeLevel(const Vecd &position);
     inline size_t getCoarseLevel(Real h_ratio);
+    /** the indices grouped by their probe levels */
+    StdVec<IndexVector> getProbeLevelIndices(const StdLargeVec<Vecd> &positions, const IndexVector &indices);
 };
 } // namespace SPH
 #endif // LEVEL_SET_H
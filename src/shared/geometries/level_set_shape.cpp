@@ -4,6 +4,8 @@
 #include "io_all.h"
 #include "sph_system.h"
 
+#include <numeric>
+
 namespace SPH
 {
 //=================================================================================================//
@@ -13,46 +15,121 @@ LevelSetShape::
       level_set_(*level_set_keeper_.movePtr(sph_adaptation->createLevelSet(shape, refinement_ratio)))
 {
     bounding_box_ = shape.getBounds();
+    reference_bounds_ = bounding_box_;
     is_bounds_found_ = true;
 }
 //=================================================================================================//
 LevelSetShape::LevelSetShape(SPHBody &sph_body, Shape &shape, Real refinement_ratio)
     : Shape(shape.getName()),
       level_set_(*level_set_keeper_.movePtr(
-          sph_body.sph_adaptation_->createLevelSet(shape, refinement_ratio)))
+          createLevelSet(sph_body.getSPHSystem(), *sph_body.sph_adaptation_, shape, refinement_ratio)))
 {
     bounding_box_ = shape.getBounds();
+    reference_bounds_ = bounding_box_;
     is_bounds_found_ = true;
 }
 //=================================================================================================//
+UniquePtr<BaseLevelSet> LevelSetShape::createLevelSet(SPHSystem &sph_system, SPHAdaptation &sph_adaptation,
+                                                      Shape &shape, Real refinement_ratio)
+{
+    is_geometry_hashed_ = shape.hashGeometry(geometry_hash_);
+    const std::string &cache_folder = sph_system.GeometryCacheFolder();
+    if (cache_folder.empty() || !is_geometry_hashed_)
+        return sph_adaptation.createLevelSet(shape, refinement_ratio);
+
+    ContentHash cache_key = geometry_hash_;
+    cache_key.add(std::string(typeid(sph_adaptation).name()))
+        .add(sph_adaptation.ReferenceSpacing())
+        .add(sph_adaptation.ReferenceSmoothingLength())
+        .add(sph_adaptation.LocalRefinementLevel())
+        .add(sph_adaptation.getKernel()->Name())
+        .add(refinement_ratio);
+    std::string cache_file_path = cache_folder + "/level_set_" + shape.getName() + "_" + cache_key.HexDigest() + ".bin";
+
+    CacheFileReader cache_file_reader(cache_file_path, cache_key.Value());
+    if (cache_file_reader.isValid())
+        return sph_adaptation.createLevelSet(shape, refinement_ratio, cache_file_reader);
+
+    UniquePtr<BaseLevelSet> level_set = sph_adaptation.createLevelSet(shape, refinement_ratio);
+    CacheFileWriter cache_file_writer(cache_file_path, cache_key.Value());
+    level_set->writeCacheData(cache_file_writer);
+    if (!cache_file_writer.commit())
+        std::cout << "\n Warning: the level set of " << shape.getName() << " is not cached!" << std::endl;
+    return level_set;
+}
+//=================================================================================================//
+bool LevelSetShape::hashGeometry(ContentHash &content_hash)
+{
+    if (is_geometry_hashed_)
+        content_hash.add(std::string("LevelSetShape")).add(geometry_hash_.Value());
+    if (is_transformed_)
+        content_hash.add(transform_.RotationMatrix()).add(transform_.Translation());
+    return is_geometry_hashed_;
+}
+//=================================================================================================//
+void LevelSetShape::setTransform(const Transform &transform)
+{
+    transform_ = transform;
+    is_transformed_ = true;
+
+    // bounds of all corners of the reference bounds in the current configuration
+    Vecd lower_bound = MaxReal * Vecd::Ones();
+    Vecd upper_bound = -MaxReal * Vecd::Ones();
+    for (int corner = 0; corner != (1 << Dimensions); ++corner)
+    {
+        Vecd reference_corner = reference_bounds_.first_;
+        for (int k = 0; k != Dimensions; ++k)
+            if (corner & (1 << k))
+                reference_corner[k] = reference_bounds_.second_[k];
+        Vecd moved_corner = transform_.shiftFrameStationToBase(reference_corner);
+        lower_bound = lower_bound.cwiseMin(moved_corner);
+        upper_bound = upper_bound.cwiseMax(moved_corner);
+    }
+    bounding_box_ = BoundingBox(lower_bound, upper_bound);
+}
+//=================================================================================================//
 void LevelSetShape::writeLevelSet(SPHSystem &sph_system)
 {
     MeshRecordingToPlt write_level_set_to_plt(sph_system, level_set_);
     write_level_set_to_plt.writeToFile(0);
 }
 //=================================================================================================//
+void LevelSetShape::writeLevelSetToVtk(SPHSystem &sph_system)
+{
+    MeshRecordingToVtk write_level_set_to_vtk(sph_system, level_set_);
+    write_level_set_to_vtk.writeToFile(0);
+}
+//=================================================================================================//
+void LevelSetShape::reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name)
+{
+    level_set_.reportMemoryUsage(memory_report, owner_name);
+}
+//=================================================================================================//
 LevelSetShape *LevelSetShape::cleanLevelSet(Real small_shift_factor)
 {
     level_set_.cleanInterface(small_shift_factor);
+    geometry_hash_.add(std::string("cleanLevelSet")).add(small_shift_factor);
     return this;
 }
 //=================================================================================================//
 LevelSetShape *LevelSetShape::correctLevelSetSign(Real small_shift_factor)
 {
     level_set_.correctTopology(small_shift_factor);
+    geometry_hash_.add(std::string("correctLevelSetSign")).add(small_shift_factor);
     return this;
 }
 //=================================================================================================//
 bool LevelSetShape::checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED)
 {
-    return level_set_.probeSignedDistance(probe_point) < 0.0 ? true : false;
+    return level_set_.probeSignedDistance(shiftToFrame(probe_point)) < 0.0 ? true : false;
 }
 //=================================================================================================//
 Vecd LevelSetShape::findClosestPoint(const Vecd &probe_point)
 {
-    Real phi = level_set_.probeSignedDistance(probe_point);
-    Vecd normal = level_set_.probeNormalDirection(probe_point);
-    return probe_point - phi * normal;
+    Vecd frame_point = shiftToFrame(probe_point);
+    Real phi = level_set_.probeSignedDistance(frame_point);
+    Vecd normal = level_set_.probeNormalDirection(frame_point);
+    return shiftFromFrame(frame_point - phi * normal);
 }
 //=================================================================================================//
 BoundingBox LevelSetShape::findBounds()
@@ -68,17 +145,101 @@ BoundingBox LevelSetShape::findBounds()
 //=================================================================================================//
 Vecd LevelSetShape::findLevelSetGradient(const Vecd &probe_point)
 {
-    return level_set_.probeLevelSetGradient(probe_point);
+    return rotateFromFrame(level_set_.probeLevelSetGradient(shiftToFrame(probe_point)));
 }
 //=================================================================================================//
 Real LevelSetShape::computeKernelIntegral(const Vecd &probe_point, Real h_ratio)
 {
-    return level_set_.probeKernelIntegral(probe_point, h_ratio);
+    return level_set_.probeKernelIntegral(shiftToFrame(probe_point), h_ratio);
 }
 //=================================================================================================//
 Vecd LevelSetShape::computeKernelGradientIntegral(const Vecd &probe_point, Real h_ratio)
 {
-    return level_set_.probeKernelGradientIntegral(probe_point, h_ratio);
+    return rotateFromFrame(level_set_.probeKernelGradientIntegral(shiftToFrame(probe_point), h_ratio));
+}
+//=================================================================================================//
+IndexVector LevelSetShape::IndicesInRange(const IndexRange &index_range)
+{
+    IndexVector indices(index_range.size());
+    std::iota(indices.begin(), indices.end(), index_range.begin());
+    return indices;
+}
+//=================================================================================================//
+const StdLargeVec<Vecd> &LevelSetShape::PositionsInFrame(const StdLargeVec<Vecd> &positions,
+                                                         const IndexRange &index_range,
+                                                         StdLargeVec<Vecd> &positions_in_frame)
+{
+    if (!is_transformed_)
+        return positions;
+
+    positions_in_frame.resize(positions.size());
+    parallel_for(
+        index_range,
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                positions_in_frame[i] = transform_.shiftBaseStationToFrame(positions[i]);
+        },
+        ap);
+    return positions_in_frame;
+}
+//=================================================================================================//
+void LevelSetShape::rotateFromFrame(const IndexRange &index_range, StdLargeVec<Vecd> &frame_vectors)
+{
+    if (!is_transformed_)
+        return;
+
+    parallel_for(
+        index_range,
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                frame_vectors[i] = transform_.xformFrameVecToBase(frame_vectors[i]);
+        },
+        ap);
+}
+//=================================================================================================//
+void LevelSetShape::findSignedDistances(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                                        StdLargeVec<Real> &signed_distances)
+{
+    StdLargeVec<Vecd> positions_in_frame;
+    level_set_.probeSignedDistance(PositionsInFrame(positions, index_range, positions_in_frame),
+                                   IndicesInRange(index_range), signed_distances);
+}
+//=================================================================================================//
+void LevelSetShape::findNormalDirections(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                                         StdLargeVec<Vecd> &normal_directions)
+{
+    StdLargeVec<Vecd> positions_in_frame;
+    level_set_.probeNormalDirection(PositionsInFrame(positions, index_range, positions_in_frame),
+                                    IndicesInRange(index_range), normal_directions);
+    rotateFromFrame(index_range, normal_directions);
+}
+//=================================================================================================//
+void LevelSetShape::findLevelSetGradients(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                                          StdLargeVec<Vecd> &level_set_gradients)
+{
+    StdLargeVec<Vecd> positions_in_frame;
+    level_set_.probeLevelSetGradient(PositionsInFrame(positions, index_range, positions_in_frame),
+                                     IndicesInRange(index_range), level_set_gradients);
+    rotateFromFrame(index_range, level_set_gradients);
+}
+//=================================================================================================//
+void LevelSetShape::computeKernelIntegrals(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                                           StdLargeVec<Real> &kernel_integrals, Real h_ratio)
+{
+    StdLargeVec<Vecd> positions_in_frame;
+    level_set_.probeKernelIntegral(PositionsInFrame(positions, index_range, positions_in_frame),
+                                   IndicesInRange(index_range), kernel_integrals, h_ratio);
+}
+//=================================================================================================//
+void LevelSetShape::computeKernelGradientIntegrals(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                                                   StdLargeVec<Vecd> &kernel_gradient_integrals, Real h_ratio)
+{
+    StdLargeVec<Vecd> positions_in_frame;
+    level_set_.probeKernelGradientIntegral(PositionsInFrame(positions, index_range, positions_in_frame),
+                                           IndicesInRange(index_range), kernel_gradient_integrals, h_ratio);
+    rotateFromFrame(index_range, kernel_gradient_integrals);
 }
 //=================================================================================================//
 } // namespace SPH
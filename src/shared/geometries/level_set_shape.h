@@ -45,9 +45,15 @@ class SPHSystem;
 class LevelSetShape : public Shape
 {
   private:
+    bool is_geometry_hashed_ = false;
+    ContentHash geometry_hash_; /**< of the original shape and the level set corrections */
     UniquePtrKeeper<BaseLevelSet> level_set_keeper_;
     SharedPtr<SPHAdaptation> sph_adaptation_;
 
+    /** read the level set from the geometry cache if available, otherwise build and cache it */
+    UniquePtr<BaseLevelSet> createLevelSet(SPHSystem &sph_system, SPHAdaptation &sph_adaptation,
+                                           Shape &shape, Real refinement_ratio);
+
   public:
     /** refinement_ratio is between body reference resolution and level set resolution */
     LevelSetShape(Shape &shape, SharedPtr<SPHAdaptation> sph_adaptation, Real refinement_ratio = 1.0);
@@ -61,16 +67,60 @@ class LevelSetShape : public Shape
     Vecd findLevelSetGradient(const Vecd &probe_point);
     Real computeKernelIntegral(const Vecd &probe_point, Real h_ratio = 1.0);
     Vecd computeKernelGradientIntegral(const Vecd &probe_point, Real h_ratio = 1.0);
+    /** Batched versions for the positions within the index range, e.g. all real particles.
+     *  The results are stored at the same indices as the positions. */
+    void findSignedDistances(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                             StdLargeVec<Real> &signed_distances);
+    void findNormalDirections(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                              StdLargeVec<Vecd> &normal_directions);
+    void findLevelSetGradients(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                               StdLargeVec<Vecd> &level_set_gradients);
+    void computeKernelIntegrals(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                                StdLargeVec<Real> &kernel_integrals, Real h_ratio = 1.0);
+    void computeKernelGradientIntegrals(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                                        StdLargeVec<Vecd> &kernel_gradient_integrals, Real h_ratio = 1.0);
     /** small_shift_factor = 1.0 by default, can be increased for difficult geometries for smoothing */
     LevelSetShape *cleanLevelSet(Real small_shift_factor = 1.0);
     /** required to build level set from triangular mesh in stl file format. */
     LevelSetShape *correctLevelSetSign(Real small_shift_factor = 1.0);
+    /** Rigid motion of the shape from the frame in which the level set is built, e.g. for moving solid bodies.
+     *  Probe points are mapped into the level set frame and vector results rotated back,
+     *  so that the level set needs not to be rebuilt when the shape moves.
+     *  This is a manual setter, it is not hooked to any time-dependent motion,
+     *  so that the user calls it whenever the body has moved, e.g. after each Simbody step. */
+    void setTransform(const Transform &transform);
+    const Transform &getTransform() const { return transform_; };
     void writeLevelSet(SPHSystem &sph_system);
+    /** binary image data of the level set, which is much faster to write and read than Tecplot output */
+    void writeLevelSetToVtk(SPHSystem &sph_system);
+    virtual void reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name) override;
+    virtual bool hashGeometry(ContentHash &content_hash) override;
 
   protected:
-    BaseLevelSet &level_set_; /**< narrow bounded level set mesh. */
+    BaseLevelSet &level_set_;      /**< narrow bounded level set mesh. */
+    Transform transform_;          /**< from the level set frame to the current configuration */
+    bool is_transformed_ = false;  /**< to skip the mapping for shapes not moved */
+    BoundingBox reference_bounds_; /**< in the level set frame */
 
     virtual BoundingBox findBounds() override;
+    IndexVector IndicesInRange(const IndexRange &index_range);
+    Vecd shiftToFrame(const Vecd &probe_point)
+    {
+        return is_transformed_ ? transform_.shiftBaseStationToFrame(probe_point) : probe_point;
+    };
+    Vecd shiftFromFrame(const Vecd &frame_point)
+    {
+        return is_transformed_ ? transform_.shiftFrameStationToBase(frame_point) : frame_point;
+    };
+    Vecd rotateFromFrame(const Vecd &frame_vector)
+    {
+        return is_transformed_ ? transform_.xformFrameVecToBase(frame_vector) : frame_vector;
+    };
+    /** the positions in the range mapped into the level set frame and stored at the same indices
+     *  of the caller-provided buffer, or the positions themselves if the shape is not transformed */
+    const StdLargeVec<Vecd> &PositionsInFrame(const StdLargeVec<Vecd> &positions, const IndexRange &index_range,
+                                              StdLargeVec<Vecd> &positions_in_frame);
+    void rotateFromFrame(const IndexRange &index_range, StdLargeVec<Vecd> &frame_vectors);
 };
 } // namespace SPH
 #endif // LEVEL_SET_SHAPE_H
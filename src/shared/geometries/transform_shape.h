@@ -69,6 +69,12 @@ class TransformShape : public BaseShapeType
         return transform_.shiftFrameStationToBase(closest_point_origin);
     };
 
+    virtual bool hashGeometry(ContentHash &content_hash) override
+    {
+        content_hash.add(transform_.RotationMatrix()).add(transform_.Translation());
+        return BaseShapeType::hashGeometry(content_hash);
+    };
+
   protected:
     Transform transform_;
 
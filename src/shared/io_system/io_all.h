@@ -29,9 +29,12 @@ io class used in SPHinXsys. **/
 
 #include "io_base.h"
 #include "io_observation.h"
+#include "io_output_filter.h"
 #include "io_plt.h"
 #include "io_simbody.h"
+#include "io_time_series.h"
 #include "io_vtk.h"
 #include "io_vtk_fvm.h"
+#include "io_xdmf.h"
 
 #endif // IO_ALL_H
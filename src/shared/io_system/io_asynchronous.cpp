@@ -0,0 +1,173 @@
+/**
+ * @file 	io_asynchronous.cpp
+ * @author	agent
+ */
+
+#include "io_asynchronous.h"
+
+#include "base_particles.h"
+
+namespace SPH
+{
+//=============================================================================================//
+AsynchronousWriter::AsynchronousWriter(size_t max_pending_tasks)
+    : max_pending_tasks_(SMAX(max_pending_tasks, size_t(1))), pending_tasks_(0), is_stopping_(false),
+      io_thread_(&AsynchronousWriter::executeTasks, this) {}
+//=============================================================================================//
+AsynchronousWriter::~AsynchronousWriter()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        task_finished_.wait(lock, [&]
+                            { return pending_tasks_ == 0; });
+        is_stopping_ = true;
+        if (task_exception_)
+        {
+            std::cout << "\n Error: an asynchronous writing task failed and was not reported by flush!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        }
+    }
+    task_submitted_.notify_one();
+    io_thread_.join();
+}
+//=============================================================================================//
+void AsynchronousWriter::waitForFreeSlot()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    task_finished_.wait(lock, [&]
+                        { return pending_tasks_ < max_pending_tasks_; });
+    rethrowTaskException();
+}
+//=============================================================================================//
+void AsynchronousWriter::submit(const std::function<void()> &task)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        task_finished_.wait(lock, [&]
+                            { return pending_tasks_ < max_pending_tasks_; });
+        rethrowTaskException();
+        tasks_.push_back(task);
+        ++pending_tasks_;
+    }
+    task_submitted_.notify_one();
+}
+//=============================================================================================//
+void AsynchronousWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    task_finished_.wait(lock, [&]
+                        { return pending_tasks_ == 0; });
+    rethrowTaskException();
+}
+//=============================================================================================//
+void AsynchronousWriter::executeTasks()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            task_submitted_.wait(lock, [&]
+                                 { return is_stopping_ || !tasks_.empty(); });
+            if (tasks_.empty())
+                return;
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        std::exception_ptr task_exception;
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            task_exception = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (task_exception && !task_exception_)
+                task_exception_ = task_exception;
+            --pending_tasks_;
+        }
+        task_finished_.notify_all();
+    }
+}
+//=============================================================================================//
+void AsynchronousWriter::rethrowTaskException()
+{
+    if (task_exception_)
+    {
+        std::exception_ptr task_exception = task_exception_;
+        task_exception_ = nullptr;
+        std::rethrow_exception(task_exception);
+    }
+}
+//=============================================================================================//
+template <typename DataType>
+void ParticleStatesSnapshot::CopyParticleVariable::
+operator()(const DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables, ParticleStatesSnapshot *snapshot,
+           const IndexVector *selected_particles)
+{
+    constexpr int type_index = DataTypeIndex<DataType>::value;
+    std::get<type_index>(snapshot->variables_to_write_).clear();
+    size_t total_real_particles = snapshot->total_real_particles_;
+    for (DiscreteVariable<DataType> *variable : variables)
+    {
+        DiscreteVariable<DataType> *copy =
+            findVariableByName<DataType>(snapshot->copied_variables_, variable->Name());
+        if (copy == nullptr)
+        {
+            copy = addVariableToAssemble<DataType>(snapshot->copied_variables_, snapshot->variable_ptrs_, variable->Name());
+            copy->allocateDataField(0, DataType());
+        }
+        std::get<type_index>(snapshot->variables_to_write_).push_back(copy);
+
+        // resizing without shrinking keeps the memory for the following snapshots
+        StdLargeVec<DataType> &source = *variable->DataField();
+        StdLargeVec<DataType> &target = *copy->DataField();
+        target.resize(total_real_particles);
+        parallel_for(
+            IndexRange(0, total_real_particles),
+            [&](const IndexRange &r)
+            {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                    target[i] = source[selected_particles == nullptr ? i : (*selected_particles)[i]];
+            },
+            ap);
+    }
+}
+//=============================================================================================//
+void ParticleStatesSnapshot::copyFrom(BaseParticles &base_particles)
+{
+    copyFrom(base_particles, base_particles.getVariablesToWrite());
+}
+//=============================================================================================//
+void ParticleStatesSnapshot::copyFrom(BaseParticles &base_particles, const ParticleVariables &variables,
+                                      const IndexVector *selected_particles)
+{
+    total_real_particles_ = selected_particles == nullptr ? base_particles.TotalRealParticles()
+                                                          : selected_particles->size();
+    positions_.resize(total_real_particles_);
+    original_ids_.resize(total_real_particles_);
+    StdLargeVec<Vecd> &positions = base_particles.ParticlePositions();
+    StdLargeVec<size_t> &original_ids = base_particles.ParticleOriginalIds();
+    parallel_for(
+        IndexRange(0, total_real_particles_),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                size_t index_i = selected_particles == nullptr ? i : (*selected_particles)[i];
+                positions_[i] = positions[index_i];
+                original_ids_[i] = original_ids[index_i];
+            }
+        },
+        ap);
+
+    OperationOnDataAssemble<const ParticleVariables, CopyParticleVariable> copy_particle_variables(variables);
+    copy_particle_variables(this, selected_particles);
+}
+//=============================================================================================//
+} // namespace SPH
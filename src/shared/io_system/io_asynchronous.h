@@ -0,0 +1,125 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_asynchronous.h
+ * @brief 	Asynchronous writing of the particle states by a dedicated I/O thread.
+ * @details The states are copied into snapshots at the call site,
+ *          and the snapshots are serialized and written while the simulation continues.
+ * @author	agent
+ */
+
+#ifndef IO_ASYNCHRONOUS_H
+#define IO_ASYNCHRONOUS_H
+
+#include "base_data_package.h"
+#include "base_variable.h"
+#include "io_environment.h"
+#include "sph_data_containers.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace SPH
+{
+class BaseParticles;
+
+/**
+ * @class AsynchronousWriter
+ * @brief A dedicated I/O thread executing the submitted writing tasks in order.
+ * The number of pending tasks, including the one being executed, is bounded
+ * so that the simulation waits for the I/O instead of accumulating snapshots.
+ * An exception thrown by a task is kept and rethrown on the calling thread
+ * by the next waitForFreeSlot, submit or flush.
+ */
+class AsynchronousWriter : public BufferedOutput
+{
+  public:
+    explicit AsynchronousWriter(size_t max_pending_tasks = 2);
+    virtual ~AsynchronousWriter();
+
+    size_t MaxPendingTasks() { return max_pending_tasks_; };
+    /** wait until fewer than the maximum number of tasks are pending,
+     *  after which the data used by the task submitted max_pending_tasks before can be reused */
+    void waitForFreeSlot();
+    void submit(const std::function<void()> &task);
+    /** wait until all submitted tasks are finished */
+    virtual void flush() override;
+
+  protected:
+    size_t max_pending_tasks_;
+    size_t pending_tasks_; /**< queued tasks and the one being executed */
+    bool is_stopping_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable task_submitted_;
+    std::condition_variable task_finished_;
+    std::exception_ptr task_exception_; /**< the first exception thrown by a task and not rethrown yet */
+    std::thread io_thread_;
+
+    void executeTasks();
+    /** called with the mutex locked */
+    void rethrowTaskException();
+};
+
+/**
+ * @class ParticleStatesSnapshot
+ * @brief Copy of the positions, original IDs and the variables to write of the real particles,
+ * taken in parallel. The memory is kept and reused by the following snapshots.
+ * A snapshot of selected particles is the gathered, contiguous copy written by filtered outputs.
+ */
+class ParticleStatesSnapshot
+{
+  public:
+    ParticleStatesSnapshot() : total_real_particles_(0){};
+    virtual ~ParticleStatesSnapshot(){};
+
+    void copyFrom(BaseParticles &base_particles);
+    /** copy the given variables of the selected real particles only, or of all if none is selected */
+    void copyFrom(BaseParticles &base_particles, const ParticleVariables &variables,
+                  const IndexVector *selected_particles = nullptr);
+    size_t TotalRealParticles() { return total_real_particles_; };
+    StdLargeVec<Vecd> &ParticlePositions() { return positions_; };
+    StdLargeVec<size_t> &ParticleOriginalIds() { return original_ids_; };
+    const ParticleVariables &getVariablesToWrite() const { return variables_to_write_; };
+
+  protected:
+    size_t total_real_particles_;
+    StdLargeVec<Vecd> positions_;
+    StdLargeVec<size_t> original_ids_;
+    DataContainerUniquePtrAssemble<DiscreteVariable> variable_ptrs_;
+    ParticleVariables copied_variables_;   /**< all variables ever copied */
+    ParticleVariables variables_to_write_; /**< the copies of the current variables to write */
+
+    struct CopyParticleVariable
+    {
+        template <typename DataType>
+        void operator()(const DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        ParticleStatesSnapshot *snapshot, const IndexVector *selected_particles);
+    };
+};
+} // namespace SPH
+#endif // IO_ASYNCHRONOUS_H
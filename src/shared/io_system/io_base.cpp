@@ -48,9 +48,169 @@ void BodyStatesRecording::writeToFile(size_t iteration_step)
     writeWithFileName(padValueWithZeros(iteration_step));
 };
 //=============================================================================================//
-RestartIO::RestartIO(SPHSystem &sph_system)
-    : BaseIO(sph_system), bodies_(sph_system.getRealBodies()),
-      overall_file_path_(io_environment_.restart_folder_ + "/Restart_time_")
+BufferedRecordingFile::BufferedRecordingFile(IOEnvironment &io_environment,
+                                             const std::string &file_path_without_extension)
+    : io_environment_(io_environment), file_path_without_extension_(file_path_without_extension),
+      recording_format_(RecordingFormat::text), records_per_flush_(100), buffered_records_(0),
+      is_opened_(false), series_id_(0),
+      default_flags_(text_buffer_.flags()), default_precision_(text_buffer_.precision())
+{
+    io_environment_.addBufferedOutput(this);
+}
+//=============================================================================================//
+BufferedRecordingFile::~BufferedRecordingFile()
+{
+    flush();
+    io_environment_.removeBufferedOutput(this);
+}
+//=============================================================================================//
+void BufferedRecordingFile::setRecordingFormat(RecordingFormat recording_format, size_t records_per_flush)
+{
+    if (isOpened())
+    {
+        std::cout << "\n Error: the recording format of " << FilePath()
+                  << " can not be changed after the first record!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    recording_format_ = recording_format;
+    records_per_flush_ = SMAX(records_per_flush, size_t(1));
+}
+//=============================================================================================//
+std::string BufferedRecordingFile::FilePath()
+{
+    if (recording_format_ == RecordingFormat::time_series)
+        return io_environment_.getTimeSeriesStore().FilePath();
+    return file_path_without_extension_ + (isBinary() ? ".bin" : ".dat");
+}
+//=============================================================================================//
+std::string BufferedRecordingFile::SeriesName()
+{
+    return fs::path(file_path_without_extension_).filename().string();
+}
+//=============================================================================================//
+void BufferedRecordingFile::addColumn(const std::string &column_name, const Real &quantity)
+{
+    column_names_.push_back(column_name);
+}
+//=============================================================================================//
+void BufferedRecordingFile::addColumn(const std::string &column_name, const Vecd &quantity)
+{
+    for (int i = 0; i != Dimensions; ++i)
+        column_names_.push_back(column_name + "[" + std::to_string(i) + "]");
+}
+//=============================================================================================//
+void BufferedRecordingFile::open()
+{
+    is_opened_ = true;
+    std::string file_path = FilePath();
+    if (recording_format_ == RecordingFormat::time_series)
+    {
+        series_id_ = io_environment_.getTimeSeriesStore().addSeries(SeriesName(), column_names_);
+        text_buffer_.str("");
+        binary_buffer_.reserve(column_names_.size() * records_per_flush_);
+    }
+    else if (isBinary())
+    {
+        // records after a restart are appended to the binary file with the same columns
+        bool has_header = fs::exists(file_path) && fs::file_size(file_path) != 0;
+        out_file_.open(file_path.c_str(), std::ios::app | std::ios::binary);
+        if (!has_header)
+        {
+            out_file_.write("SPHREC01", 8);
+            uint64_t number_of_columns = column_names_.size();
+            out_file_.write(reinterpret_cast<const char *>(&number_of_columns), sizeof(uint64_t));
+            for (const std::string &column_name : column_names_)
+            {
+                uint64_t length = column_name.size();
+                out_file_.write(reinterpret_cast<const char *>(&length), sizeof(uint64_t));
+                out_file_.write(column_name.data(), length);
+            }
+        }
+        text_buffer_.str("");
+        binary_buffer_.reserve(column_names_.size() * records_per_flush_);
+    }
+    else
+    {
+        // as before, the header is appended to an existing file, e.g. after a restart
+        out_file_.open(file_path.c_str(), std::ios::app);
+        text_buffer_ << "\n";
+    }
+    flush();
+}
+//=============================================================================================//
+void BufferedRecordingFile::beginRecord(Real physical_time)
+{
+    if (isBinary())
+    {
+        binary_buffer_.push_back(physical_time);
+        return;
+    }
+    text_buffer_ << physical_time << "   ";
+}
+//=============================================================================================//
+void BufferedRecordingFile::appendValue(const Real &value)
+{
+    if (isBinary())
+    {
+        binary_buffer_.push_back(value);
+        return;
+    }
+    text_buffer_ << std::fixed << std::setprecision(9) << value << "   ";
+}
+//=============================================================================================//
+void BufferedRecordingFile::appendValue(const Vecd &value)
+{
+    for (int i = 0; i != Dimensions; ++i)
+        appendValue(value[i]);
+}
+//=============================================================================================//
+void BufferedRecordingFile::endRecord()
+{
+    if (!isBinary())
+    {
+        text_buffer_ << "\n";
+        // the run time at the beginning of the next record is written with the default format
+        text_buffer_.flags(default_flags_);
+        text_buffer_.precision(default_precision_);
+    }
+    buffered_records_++;
+    if (buffered_records_ >= records_per_flush_)
+    {
+        flush();
+    }
+}
+//=============================================================================================//
+void BufferedRecordingFile::flush()
+{
+    if (!isOpened())
+        return;
+
+    if (recording_format_ == RecordingFormat::time_series)
+    {
+        io_environment_.getTimeSeriesStore().appendRecords(series_id_, binary_buffer_);
+        binary_buffer_.clear();
+    }
+    else if (isBinary())
+    {
+        out_file_.write(reinterpret_cast<const char *>(binary_buffer_.data()),
+                        binary_buffer_.size() * sizeof(double));
+        binary_buffer_.clear();
+        out_file_.flush();
+    }
+    else
+    {
+        out_file_ << text_buffer_.str();
+        text_buffer_.str("");
+        out_file_.flush();
+    }
+    buffered_records_ = 0;
+}
+//=============================================================================================//
+RestartIO::RestartIO(SPHSystem &sph_system, RestartFormat restart_format)
+    : BaseIO(sph_system), bodies_(sph_system.getRealBodies()), restart_format_(restart_format),
+      overall_file_path_(io_environment_.restart_folder_ + "/Restart_time_"), restart_time_from_files_(0),
+      full_checkpoint_interval_(1), number_of_checkpoints_(0)
 {
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
@@ -64,6 +224,9 @@ RestartIO::RestartIO(SPHSystem &sph_system)
 //=============================================================================================//
 void RestartIO::writeToFile(size_t iteration_step)
 {
+    // the recorded states and observations are complete up to the restart point
+    io_environment_.flushBufferedOutputs();
+
     std::string overall_filefullpath = overall_file_path_ + padValueWithZeros(iteration_step) + ".dat";
     if (fs::exists(overall_filefullpath))
     {
@@ -73,16 +236,46 @@ void RestartIO::writeToFile(size_t iteration_step)
     out_file << std::fixed << std::setprecision(9) << GlobalStaticVariables::physical_time_ << "   \n";
     out_file.close();
 
+    bool is_incremental = number_of_checkpoints_ % full_checkpoint_interval_ != 0;
+    number_of_checkpoints_++;
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
-        std::string filefullpath = file_names_[i] + padValueWithZeros(iteration_step) + ".xml";
+        std::string filefullpath = file_names_[i] + padValueWithZeros(iteration_step) + restartFileExtension();
 
         if (fs::exists(filefullpath))
         {
             fs::remove(filefullpath);
         }
-        bodies_[i]->writeParticlesToXmlForRestart(filefullpath);
+        if (restart_format_ == RestartFormat::binary)
+        {
+            bodies_[i]->writeParticlesToBinaryForRestart(filefullpath, GlobalStaticVariables::physical_time_,
+                                                         is_incremental, full_checkpoint_interval_ > 1);
+        }
+        else
+        {
+            bodies_[i]->writeParticlesToXmlForRestart(filefullpath);
+        }
+    }
+
+    if (sph_system_.MemoryReporting())
+    {
+        MemoryReport memory_report;
+        sph_system_.reportMemoryUsage(memory_report);
+        memory_report.writeToJson(io_environment_.restart_folder_ + "/MemoryReport_" +
+                                      padValueWithZeros(iteration_step) + ".json",
+                                  GlobalStaticVariables::physical_time_);
+    }
+}
+//=============================================================================================//
+void RestartIO::setIncrementalCheckpoints(size_t full_checkpoint_interval)
+{
+    if (restart_format_ != RestartFormat::binary)
+    {
+        std::cout << "\n Error: incremental checkpoints require the binary restart format!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
     }
+    full_checkpoint_interval_ = SMAX(full_checkpoint_interval, size_t(1));
 }
 //=============================================================================================//
 Real RestartIO::readRestartTime(size_t restart_step)
@@ -107,7 +300,7 @@ void RestartIO::readFromFile(size_t restart_step)
 {
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
-        std::string filefullpath = file_names_[i] + padValueWithZeros(restart_step) + ".xml";
+        std::string filefullpath = file_names_[i] + padValueWithZeros(restart_step) + restartFileExtension();
 
         if (!fs::exists(filefullpath))
         {
@@ -116,10 +309,22 @@ void RestartIO::readFromFile(size_t restart_step)
             exit(1);
         }
 
-        bodies_[i]->readParticlesFromXmlForRestart(filefullpath);
+        if (restart_format_ == RestartFormat::binary)
+        {
+            restart_time_from_files_ = bodies_[i]->readParticlesFromBinaryForRestart(filefullpath);
+        }
+        else
+        {
+            bodies_[i]->readParticlesFromXmlForRestart(filefullpath);
+        }
     }
 }
 //=============================================================================================//
+std::string RestartIO::restartFileExtension()
+{
+    return restart_format_ == RestartFormat::binary ? ".bin" : ".xml";
+}
+//=============================================================================================//
 ReloadParticleIO::ReloadParticleIO(SPHBodyVector bodies)
     : BaseIO(bodies[0]->getSPHSystem()), bodies_(bodies)
 {
@@ -151,6 +356,55 @@ void ReloadParticleIO::writeToFile(size_t iteration_step)
     }
 }
 //=============================================================================================//
+ParticleCacheIO::ParticleCacheIO(SPHBody &sph_body, const std::string &description)
+    : BaseIO(sph_body.getSPHSystem()), sph_body_(sph_body), is_cacheable_(false), cache_key_(0)
+{
+    ContentHash content_hash;
+    const std::string &cache_folder = sph_system_.GeometryCacheFolder();
+    if (!cache_folder.empty() && sph_body.getInitialShape().hashGeometry(content_hash))
+    {
+        SPHAdaptation &sph_adaptation = *sph_body.sph_adaptation_;
+        content_hash.add(std::string(typeid(sph_adaptation).name()))
+            .add(sph_adaptation.ReferenceSpacing())
+            .add(sph_adaptation.ReferenceSmoothingLength())
+            .add(sph_adaptation.LocalRefinementLevel())
+            .add(sph_adaptation.getKernel()->Name())
+            .add(sph_system_.system_domain_bounds_.first_)
+            .add(sph_system_.system_domain_bounds_.second_)
+            .add(description);
+        is_cacheable_ = true;
+        cache_key_ = content_hash.Value();
+        file_path_ = cache_folder + "/particles_" + sph_body.getName() + "_" + content_hash.HexDigest() + ".bin";
+    }
+}
+//=============================================================================================//
+bool ParticleCacheIO::isCached()
+{
+    return is_cacheable_ && CacheFileReader(file_path_, cache_key_).isValid();
+}
+//=============================================================================================//
+void ParticleCacheIO::writeToFile(size_t iteration_step)
+{
+    if (!is_cacheable_)
+    {
+        std::cout << "\n Warning: the particles of " << sph_body_.getName()
+                  << " are not cached, as the geometry cache is not set or the shape can not be hashed." << std::endl;
+        return;
+    }
+
+    BaseParticles &base_particles = sph_body_.getBaseParticles();
+    StdLargeVec<Vecd> &pos = base_particles.ParticlePositions();
+    StdLargeVec<Real> &Vol = base_particles.VolumetricMeasures();
+    size_t total_real_particles = base_particles.TotalRealParticles();
+
+    CacheFileWriter cache_file_writer(file_path_, cache_key_);
+    cache_file_writer.write(total_real_particles);
+    cache_file_writer.writeBytes(pos.data(), total_real_particles * sizeof(Vecd));
+    cache_file_writer.writeBytes(Vol.data(), total_real_particles * sizeof(Real));
+    if (!cache_file_writer.commit())
+        std::cout << "\n Warning: the particles of " << sph_body_.getName() << " are not cached!" << std::endl;
+}
+//=============================================================================================//
 ParticleGenerationRecording::ParticleGenerationRecording(SPHBody &sph_body)
     : BaseIO(sph_body.getSPHSystem()), sph_body_(sph_body),
       state_recording_(sph_system_.StateRecording()) {}
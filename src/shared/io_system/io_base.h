@@ -137,22 +137,96 @@ class BodyStatesRecording : public BaseIO
     UniquePtrsKeeper<BaseDynamics<void>> derived_variables_keeper_;
 };
 
+/** Text recordings are Tecplot-like .dat files, binary ones hold rows of doubles for long monitoring runs,
+ *  and the time series ones are series in the single columnar store of the system, see io_time_series.h */
+enum class RecordingFormat
+{
+    text,
+    binary,
+    time_series
+};
+
+/**
+ * @class BufferedRecordingFile
+ * @brief A recording file kept open with the records buffered in memory.
+ * The buffer is written out every records_per_flush records, at checkpoints and on destruction.
+ * The binary file starts with the magic "SPHREC01", the number of columns and
+ * the column names, each given by its length and characters, followed by the records.
+ */
+class BufferedRecordingFile : public BufferedOutput
+{
+  public:
+    BufferedRecordingFile(IOEnvironment &io_environment, const std::string &file_path_without_extension);
+    virtual ~BufferedRecordingFile();
+    /** to be set before the file is opened by the first record */
+    void setRecordingFormat(RecordingFormat recording_format, size_t records_per_flush);
+    RecordingFormat Format() { return recording_format_; };
+    bool isBinary() { return recording_format_ != RecordingFormat::text; };
+    bool isOpened() { return is_opened_; };
+    std::string FilePath();
+    /** the name of the series in the time series store */
+    std::string SeriesName();
+    /** the text header is written into this stream */
+    std::ostream &TextBuffer() { return text_buffer_; };
+    /** the columns of the binary header */
+    void addColumn(const std::string &column_name, const Real &quantity);
+    void addColumn(const std::string &column_name, const Vecd &quantity);
+    /** open the file and write the header from the text buffer or the binary columns */
+    void open();
+    void beginRecord(Real physical_time);
+    void appendValue(const Real &value);
+    void appendValue(const Vecd &value);
+    void endRecord();
+    virtual void flush() override;
+
+  protected:
+    IOEnvironment &io_environment_;
+    std::string file_path_without_extension_;
+    RecordingFormat recording_format_;
+    size_t records_per_flush_;
+    size_t buffered_records_;
+    bool is_opened_;
+    std::ofstream out_file_;
+    size_t series_id_;
+    std::ostringstream text_buffer_;
+    std::ios::fmtflags default_flags_;
+    std::streamsize default_precision_;
+    StdVec<std::string> column_names_;
+    StdVec<double> binary_buffer_;
+};
+
+/** XML restart files are portable, binary ones are exact and much faster to write and read */
+enum class RestartFormat
+{
+    xml,
+    binary
+};
+
 /**
  * @class RestartIO
- * @brief Write and read the restart files in XML format.
+ * @brief Write and read the restart files in XML or binary format.
  */
 class RestartIO : public BaseIO
 {
   protected:
     SPHBodyVector bodies_;
+    RestartFormat restart_format_;
     std::string overall_file_path_;
     StdVec<std::string> file_names_;
+    Real restart_time_from_files_; /**< as stored in the binary restart files */
+    size_t full_checkpoint_interval_;
+    size_t number_of_checkpoints_;
 
     Real readRestartTime(size_t restart_step);
+    std::string restartFileExtension();
 
   public:
-    RestartIO(SPHSystem &sph_system);
+    RestartIO(SPHSystem &sph_system, RestartFormat restart_format = RestartFormat::xml);
     virtual ~RestartIO(){};
+    /** Only every full_checkpoint_interval-th binary restart file is complete, the others hold
+     *  the variables changed since the last restart file and refer to the earlier files for the others.
+     *  Large static bodies, e.g. walls, are then written once per full checkpoint only. */
+    void setIncrementalCheckpoints(size_t full_checkpoint_interval);
 
     virtual void writeToFile(size_t iteration_step = 0) override;
     virtual void readFromFile(size_t iteration_step = 0);
@@ -160,7 +234,7 @@ class RestartIO : public BaseIO
     virtual Real readRestartFiles(size_t restart_step)
     {
         readFromFile(restart_step);
-        return readRestartTime(restart_step);
+        return restart_format_ == RestartFormat::binary ? restart_time_from_files_ : readRestartTime(restart_step);
     };
 };
 
@@ -199,6 +273,32 @@ class ReloadParticleIO : public BaseIO
     virtual void writeToFile(size_t iteration_step = 0) override;
 };
 
+/**
+ * @class ParticleCacheIO
+ * @brief Write the particle positions and volumetric measures of a body to the geometry cache
+ * and check whether they are cached already, e.g. to skip the particle relaxation.
+ * The cache key combines the hash of the initial shape of the body, the adaptation, the kernel
+ * and a description of the particle generation given by the user, such as the number of relaxation steps.
+ * Bodies with shapes which can not be hashed are never cached.
+ */
+class ParticleCacheIO : public BaseIO
+{
+  protected:
+    SPHBody &sph_body_;
+    bool is_cacheable_;
+    uint64_t cache_key_;
+    std::string file_path_;
+
+  public:
+    ParticleCacheIO(SPHBody &sph_body, const std::string &description = "");
+    virtual ~ParticleCacheIO(){};
+
+    bool isCached();
+    const std::string &FilePath() { return file_path_; };
+    uint64_t CacheKey() { return cache_key_; };
+    virtual void writeToFile(size_t iteration_step = 0) override;
+};
+
 class ParticleGenerationRecording : public BaseIO
 {
 
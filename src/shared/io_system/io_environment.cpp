@@ -9,7 +9,7 @@ namespace SPH
 IOEnvironment::IOEnvironment(SPHSystem &sph_system, bool delete_output)
     : sph_system_(sph_system),
       input_folder_("./input"), output_folder_("./output"),
-      restart_folder_("./restart"), reload_folder_("./reload")
+      restart_folder_("./restart"), reload_folder_("./reload"), time_series_store_(nullptr)
 {
     if (!fs::exists(input_folder_))
     {
@@ -49,5 +49,34 @@ ParameterizationIO &IOEnvironment::defineParameterizationIO()
 {
     return parameterization_io_ptr_keeper_.createRef<ParameterizationIO>(input_folder_);
 }
+//=============================================================================================//
+TimeSeriesStore &IOEnvironment::getTimeSeriesStore()
+{
+    if (time_series_store_ == nullptr)
+    {
+        time_series_store_ = time_series_store_ptr_keeper_.createPtr<TimeSeriesStore>(output_folder_ + "/TimeSeries.sts");
+    }
+    return *time_series_store_;
+}
+//=============================================================================================//
+void IOEnvironment::addBufferedOutput(BufferedOutput *buffered_output)
+{
+    buffered_outputs_.push_back(buffered_output);
+}
+//=============================================================================================//
+void IOEnvironment::removeBufferedOutput(BufferedOutput *buffered_output)
+{
+    buffered_outputs_.erase(
+        std::remove(buffered_outputs_.begin(), buffered_outputs_.end(), buffered_output),
+        buffered_outputs_.end());
+}
+//=============================================================================================//
+void IOEnvironment::flushBufferedOutputs()
+{
+    for (BufferedOutput *buffered_output : buffered_outputs_)
+    {
+        buffered_output->flush();
+    }
+}
 //=================================================================================================//
 } // namespace SPH
@@ -29,6 +29,7 @@
 #ifndef IO_ENVIRONMENT_H
 #define IO_ENVIRONMENT_H
 
+#include "io_time_series.h"
 #include "ownership.h"
 #include "parameterization.h"
 
@@ -42,6 +43,19 @@ namespace SPH
 {
 class SPHSystem;
 
+/**
+ * @class BufferedOutput
+ * @brief Output which is held in memory or pending in the background
+ * and has to be written out completely at checkpoints.
+ */
+class BufferedOutput
+{
+  public:
+    BufferedOutput(){};
+    virtual ~BufferedOutput(){};
+    virtual void flush() = 0;
+};
+
 /**
  * @class IOEnvironment
  * @brief The base class which defines folders for output,
@@ -51,6 +65,7 @@ class IOEnvironment
 {
   private:
     UniquePtrKeeper<ParameterizationIO> parameterization_io_ptr_keeper_;
+    UniquePtrKeeper<TimeSeriesStore> time_series_store_ptr_keeper_;
 
   public:
     SPHSystem &sph_system_;
@@ -62,6 +77,16 @@ class IOEnvironment
     explicit IOEnvironment(SPHSystem &sph_system, bool delete_output = true);
     virtual ~IOEnvironment(){};
     ParameterizationIO &defineParameterizationIO();
+    /** the store in the output folder shared by the recordings in the time series format */
+    TimeSeriesStore &getTimeSeriesStore();
+    void addBufferedOutput(BufferedOutput *buffered_output);
+    void removeBufferedOutput(BufferedOutput *buffered_output);
+    /** write out all buffered and pending output, e.g. before restart files */
+    void flushBufferedOutputs();
+
+  private:
+    TimeSeriesStore *time_series_store_;
+    StdVec<BufferedOutput *> buffered_outputs_;
 };
 } // namespace SPH
 #endif // IO_ENVIRONMENT_H
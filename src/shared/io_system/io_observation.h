@@ -49,7 +49,22 @@ class ObservedQuantityRecording : public BodyStatesRecording,
     BaseParticles &base_particles_;
     std::string dynamics_identifier_name_;
     const std::string quantity_name_;
-    std::string filefullpath_output_;
+    BufferedRecordingFile recording_file_;
+
+    void openRecordingFile()
+    {
+        std::ostream &header = recording_file_.TextBuffer();
+        header << "run_time"
+               << "   ";
+        recording_file_.addColumn("run_time", Real(0));
+        for (size_t i = 0; i != base_particles_.TotalRealParticles(); ++i)
+        {
+            std::string quantity_name_i = quantity_name_ + "[" + std::to_string(i) + "]";
+            plt_engine_.writeAQuantityHeader(header, (*this->interpolated_quantities_)[i], quantity_name_i);
+            recording_file_.addColumn(quantity_name_i, (*this->interpolated_quantities_)[i]);
+        }
+        recording_file_.open();
+    };
 
   public:
     VariableType type_indicator_; /*< this is an indicator to identify the variable type. */
@@ -61,34 +76,29 @@ class ObservedQuantityRecording : public BodyStatesRecording,
           observer_(contact_relation.getSPHBody()), plt_engine_(),
           base_particles_(observer_.getBaseParticles()),
           dynamics_identifier_name_(contact_relation.getSPHBody().getName()),
-          quantity_name_(quantity_name)
+          quantity_name_(quantity_name),
+          recording_file_(io_environment_, io_environment_.output_folder_ + "/" +
+                                               dynamics_identifier_name_ + "_" + quantity_name){};
+    virtual ~ObservedQuantityRecording(){};
+    /** the file is written every records_per_flush records, at restart files and at the end */
+    void setRecordingFormat(RecordingFormat recording_format, size_t records_per_flush = 100)
     {
-        /** Output for .dat file. */
-        filefullpath_output_ = io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name + ".dat";
-        std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-        out_file << "run_time"
-                 << "   ";
-        for (size_t i = 0; i != base_particles_.TotalRealParticles(); ++i)
-        {
-            std::string quantity_name_i = quantity_name + "[" + std::to_string(i) + "]";
-            plt_engine_.writeAQuantityHeader(out_file, (*this->interpolated_quantities_)[i], quantity_name_i);
-        }
-        out_file << "\n";
-        out_file.close();
+        recording_file_.setRecordingFormat(recording_format, records_per_flush);
     };
-    virtual ~ObservedQuantityRecording(){};
 
     virtual void writeWithFileName(const std::string &sequence) override
     {
         this->exec();
-        std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-        out_file << GlobalStaticVariables::physical_time_ << "   ";
+        if (!recording_file_.isOpened())
+        {
+            openRecordingFile();
+        }
+        recording_file_.beginRecord(GlobalStaticVariables::physical_time_);
         for (size_t i = 0; i != base_particles_.TotalRealParticles(); ++i)
         {
-            plt_engine_.writeAQuantity(out_file, (*this->interpolated_quantities_)[i]);
+            recording_file_.appendValue((*this->interpolated_quantities_)[i]);
         }
-        out_file << "\n";
-        out_file.close();
+        recording_file_.endRecord();
     };
 
     StdLargeVec<VariableType> *getObservedQuantity()
@@ -109,7 +119,18 @@ class ReducedQuantityRecording : public BaseIO
     ReduceDynamics<LocalReduceMethodType> reduce_method_;
     std::string dynamics_identifier_name_;
     const std::string quantity_name_;
-    std::string filefullpath_output_;
+    BufferedRecordingFile recording_file_;
+
+    void openRecordingFile()
+    {
+        std::ostream &header = recording_file_.TextBuffer();
+        header << "\"run_time\""
+               << "   ";
+        recording_file_.addColumn("run_time", Real(0));
+        plt_engine_.writeAQuantityHeader(header, reduce_method_.Reference(), quantity_name_);
+        recording_file_.addColumn(quantity_name_, reduce_method_.Reference());
+        recording_file_.open();
+    };
 
   public:
     /*< deduce variable type from reduce method. */
@@ -122,26 +143,25 @@ class ReducedQuantityRecording : public BaseIO
         : BaseIO(identifier.getSPHBody().getSPHSystem()), plt_engine_(),
           reduce_method_(identifier, std::forward<Args>(args)...),
           dynamics_identifier_name_(reduce_method_.DynamicsIdentifierName()),
-          quantity_name_(reduce_method_.QuantityName())
+          quantity_name_(reduce_method_.QuantityName()),
+          recording_file_(io_environment_, io_environment_.output_folder_ + "/" +
+                                               dynamics_identifier_name_ + "_" + quantity_name_){};
+    virtual ~ReducedQuantityRecording(){};
+    /** the file is written every records_per_flush records, at restart files and at the end */
+    void setRecordingFormat(RecordingFormat recording_format, size_t records_per_flush = 100)
     {
-        /** output for .dat file. */
-        filefullpath_output_ = io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name_ + ".dat";
-        std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-        out_file << "\"run_time\""
-                 << "   ";
-        plt_engine_.writeAQuantityHeader(out_file, reduce_method_.Reference(), quantity_name_);
-        out_file << "\n";
-        out_file.close();
+        recording_file_.setRecordingFormat(recording_format, records_per_flush);
     };
-    virtual ~ReducedQuantityRecording(){};
 
     virtual void writeToFile(size_t iteration_step = 0) override
     {
-        std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-        out_file << GlobalStaticVariables::physical_time_ << "   ";
-        plt_engine_.writeAQuantity(out_file, reduce_method_.exec());
-        out_file << "\n";
-        out_file.close();
+        if (!recording_file_.isOpened())
+        {
+            openRecordingFile();
+        }
+        recording_file_.beginRecord(GlobalStaticVariables::physical_time_);
+        recording_file_.appendValue(reduce_method_.exec());
+        recording_file_.endRecord();
     };
 };
 } // namespace SPH
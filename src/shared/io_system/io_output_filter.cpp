@@ -0,0 +1,85 @@
+/**
+ * @file 	io_output_filter.cpp
+ * @author	agent
+ */
+
+#include "io_output_filter.h"
+
+#include "base_particles.h"
+
+#include "tbb/parallel_scan.h"
+
+namespace SPH
+{
+//=============================================================================================//
+void OutputFilter::selectParticles(BaseParticles &base_particles, IndexVector &selected_particles)
+{
+    size_t total_real_particles = base_particles.TotalRealParticles();
+    StdLargeVec<Vecd> &positions = base_particles.ParticlePositions();
+    StdLargeVec<size_t> &original_ids = base_particles.ParticleOriginalIds();
+    is_selected_.resize(total_real_particles);
+    parallel_for(
+        IndexRange(0, total_real_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+                is_selected_[i] = isSelected(positions[i], original_ids[i]);
+        },
+        ap);
+
+    // a prefix sum over the selections keeps the selected particles in the order of their indices
+    selected_particles.resize(total_real_particles);
+    size_t number_of_selected = tbb::parallel_scan(
+        IndexRange(0, total_real_particles), size_t(0),
+        [&](const IndexRange &r, size_t sum, bool is_final_scan) -> size_t
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                if (is_selected_[i])
+                {
+                    if (is_final_scan)
+                        selected_particles[sum] = i;
+                    sum++;
+                }
+            }
+            return sum;
+        },
+        [](size_t left, size_t right) -> size_t
+        { return left + right; });
+    selected_particles.resize(number_of_selected);
+}
+//=============================================================================================//
+StrideOutputFilter::StrideOutputFilter(size_t stride)
+    : OutputFilter(), stride_(SMAX(stride, size_t(1))) {}
+//=============================================================================================//
+bool StrideOutputFilter::isSelected(const Vecd &position, size_t original_id)
+{
+    return original_id % stride_ == 0;
+}
+//=============================================================================================//
+RandomSubsampleOutputFilter::RandomSubsampleOutputFilter(Real fraction, size_t seed)
+    : OutputFilter(), fraction_(fraction), seed_(seed) {}
+//=============================================================================================//
+bool RandomSubsampleOutputFilter::isSelected(const Vecd &position, size_t original_id)
+{
+    // the splitmix64 finalizer gives uniformly distributed bits for consecutive IDs
+    uint64_t hash = uint64_t(original_id) + (seed_ + 1) * 0x9E3779B97F4A7C15ULL;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    hash = hash ^ (hash >> 31);
+    return Real(hash >> 11) * Real(1.0 / 9007199254740992.0) < fraction_;
+}
+//=============================================================================================//
+RegionOutputFilter::RegionOutputFilter(Shape &region_shape, size_t outside_stride)
+    : OutputFilter(), region_shape_(region_shape), outside_stride_(outside_stride) {}
+//=============================================================================================//
+RegionOutputFilter::RegionOutputFilter(BodyRegionByParticle &body_region, size_t outside_stride)
+    : RegionOutputFilter(body_region.getBodyPartShape(), outside_stride) {}
+//=============================================================================================//
+bool RegionOutputFilter::isSelected(const Vecd &position, size_t original_id)
+{
+    return region_shape_.checkContain(position) ||
+           (outside_stride_ != 0 && original_id % outside_stride_ == 0);
+}
+//=================================================================================================//
+} // namespace SPH
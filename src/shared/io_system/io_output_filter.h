@@ -0,0 +1,108 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_output_filter.h
+ * @brief 	Filters selecting the particles of a body written by the state recordings,
+ *          e.g. full resolution in a region of interest and decimated elsewhere.
+ * @details The decimations select particles by their original IDs, so that
+ *          the same particles are written at all time steps independent of sorting.
+ * @author	agent
+ */
+
+#ifndef IO_OUTPUT_FILTER_H
+#define IO_OUTPUT_FILTER_H
+
+#include "base_body_part.h"
+
+namespace SPH
+{
+/**
+ * @class OutputFilter
+ * @brief Base class for the selection of the real particles of a body to be written.
+ */
+class OutputFilter
+{
+  public:
+    OutputFilter(){};
+    virtual ~OutputFilter(){};
+    /** select the real particles to be written in the order of their indices */
+    void selectParticles(BaseParticles &base_particles, IndexVector &selected_particles);
+
+  protected:
+    StdLargeVec<char> is_selected_; /**< kept for the following selections */
+    virtual bool isSelected(const Vecd &position, size_t original_id) = 0;
+};
+
+/**
+ * @class StrideOutputFilter
+ * @brief Every stride-th particle by original ID.
+ */
+class StrideOutputFilter : public OutputFilter
+{
+  public:
+    explicit StrideOutputFilter(size_t stride);
+    virtual ~StrideOutputFilter(){};
+
+  protected:
+    size_t stride_;
+    virtual bool isSelected(const Vecd &position, size_t original_id) override;
+};
+
+/**
+ * @class RandomSubsampleOutputFilter
+ * @brief A random subsample with the given fraction of the particles.
+ * A particle is selected or not at all time steps, as the selection is given by a hash of its original ID.
+ */
+class RandomSubsampleOutputFilter : public OutputFilter
+{
+  public:
+    explicit RandomSubsampleOutputFilter(Real fraction, size_t seed = 0);
+    virtual ~RandomSubsampleOutputFilter(){};
+
+  protected:
+    Real fraction_;
+    uint64_t seed_;
+    virtual bool isSelected(const Vecd &position, size_t original_id) override;
+};
+
+/**
+ * @class RegionOutputFilter
+ * @brief All particles in the region of interest, given by a shape or a body region such as
+ * BodyAlignedBoxByParticle, and every outside_stride-th particle by original ID outside.
+ * Only the particles in the region are written with the default outside_stride of zero.
+ * The region is checked at each output, so that the particles moving into the region are written.
+ */
+class RegionOutputFilter : public OutputFilter
+{
+  public:
+    explicit RegionOutputFilter(Shape &region_shape, size_t outside_stride = 0);
+    explicit RegionOutputFilter(BodyRegionByParticle &body_region, size_t outside_stride = 0);
+    virtual ~RegionOutputFilter(){};
+
+  protected:
+    Shape &region_shape_;
+    size_t outside_stride_;
+    virtual bool isSelected(const Vecd &position, size_t original_id) override;
+};
+} // namespace SPH
+#endif // IO_OUTPUT_FILTER_H
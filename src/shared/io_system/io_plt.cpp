@@ -10,26 +10,26 @@ namespace SPH
 {
 //=============================================================================================//
 void PltEngine::
-    writeAQuantityHeader(std::ofstream &out_file, const Real &quantity, const std::string &quantity_name)
+    writeAQuantityHeader(std::ostream &out_file, const Real &quantity, const std::string &quantity_name)
 {
     out_file << "\"" << quantity_name << "\""
              << "   ";
 }
 //=============================================================================================//
 void PltEngine::
-    writeAQuantityHeader(std::ofstream &out_file, const Vecd &quantity, const std::string &quantity_name)
+    writeAQuantityHeader(std::ostream &out_file, const Vecd &quantity, const std::string &quantity_name)
 {
     for (int i = 0; i != Dimensions; ++i)
         out_file << "\"" << quantity_name << "[" << i << "]\""
                  << "   ";
 }
 //=============================================================================================//
-void PltEngine::writeAQuantity(std::ofstream &out_file, const Real &quantity)
+void PltEngine::writeAQuantity(std::ostream &out_file, const Real &quantity)
 {
     out_file << std::fixed << std::setprecision(9) << quantity << "   ";
 }
 //=============================================================================================//
-void PltEngine::writeAQuantity(std::ofstream &out_file, const Vecd &quantity)
+void PltEngine::writeAQuantity(std::ostream &out_file, const Vecd &quantity)
 {
     for (int i = 0; i < Dimensions; ++i)
         out_file << std::fixed << std::setprecision(9) << quantity[i] << "   ";
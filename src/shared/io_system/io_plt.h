@@ -43,10 +43,10 @@ class PltEngine
     PltEngine(){};
     virtual ~PltEngine(){};
 
-    void writeAQuantityHeader(std::ofstream &out_file, const Real &quantity, const std::string &quantity_name);
-    void writeAQuantityHeader(std::ofstream &out_file, const Vecd &quantity, const std::string &quantity_name);
-    void writeAQuantity(std::ofstream &out_file, const Real &quantity);
-    void writeAQuantity(std::ofstream &out_file, const Vecd &quantity);
+    void writeAQuantityHeader(std::ostream &out_file, const Real &quantity, const std::string &quantity_name);
+    void writeAQuantityHeader(std::ostream &out_file, const Vecd &quantity, const std::string &quantity_name);
+    void writeAQuantity(std::ostream &out_file, const Real &quantity);
+    void writeAQuantity(std::ostream &out_file, const Vecd &quantity);
 };
 
 /**
@@ -0,0 +1,264 @@
+/**
+ * @file 	io_time_series.cpp
+ * @author	agent
+ */
+
+#include "io_time_series.h"
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace SPH
+{
+//=============================================================================================//
+namespace
+{
+const char time_series_magic[8] = {'S', 'P', 'H', 'T', 'S', '0', '0', '1'};
+//=============================================================================================//
+template <typename T>
+void writeValue(std::ostream &out_file, const T &value)
+{
+    out_file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+//=============================================================================================//
+void writeString(std::ostream &out_file, const std::string &value)
+{
+    writeValue(out_file, uint64_t(value.size()));
+    out_file.write(value.data(), value.size());
+}
+//=============================================================================================//
+template <typename T>
+T readValue(std::istream &in_file)
+{
+    T value{};
+    in_file.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return value;
+}
+//=============================================================================================//
+std::string readString(std::istream &in_file)
+{
+    std::string value(readValue<uint64_t>(in_file), ' ');
+    in_file.read(&value[0], value.size());
+    return value;
+}
+} // namespace
+//=============================================================================================//
+std::streamoff scanTimeSeriesStore(std::ifstream &in_file, std::map<std::string, size_t> &series_ids,
+                                   StdVec<StdVec<std::string>> &series_columns,
+                                   const std::function<void(const TimeSeriesChunkHeader &, std::streamoff)> &data_chunk_found)
+{
+    in_file.seekg(0, std::ios::end);
+    std::streamoff file_size = in_file.tellg();
+    in_file.seekg(0);
+    char magic[8];
+    if (!in_file.read(magic, 8) || !std::equal(magic, magic + 8, time_series_magic))
+        return 0;
+
+    std::streamoff chunk_end = 8;
+    TimeSeriesChunkHeader header;
+    while (in_file.read(reinterpret_cast<char *>(&header), sizeof(TimeSeriesChunkHeader)))
+    {
+        std::streamoff payload_offset = chunk_end + sizeof(TimeSeriesChunkHeader);
+        if (payload_offset + std::streamoff(header.payload_size_) > file_size)
+            break;
+
+        if (header.chunk_type_ == uint32_t(TimeSeriesChunkType::schema))
+        {
+            std::string series_name = readString(in_file);
+            StdVec<std::string> column_names(readValue<uint64_t>(in_file));
+            for (std::string &column_name : column_names)
+            {
+                readValue<uint32_t>(in_file); // column type, float64 only by now
+                column_name = readString(in_file);
+            }
+            // a series added again after a restart keeps its id
+            if (header.series_id_ == series_columns.size())
+            {
+                series_ids[series_name] = header.series_id_;
+                series_columns.push_back(column_names);
+            }
+        }
+        else if (header.chunk_type_ == uint32_t(TimeSeriesChunkType::data) &&
+                 header.series_id_ < series_columns.size())
+        {
+            data_chunk_found(header, payload_offset);
+        }
+        chunk_end = payload_offset + header.payload_size_;
+        in_file.seekg(chunk_end);
+    }
+    in_file.clear();
+    return chunk_end;
+}
+//=============================================================================================//
+TimeSeriesStore::TimeSeriesStore(const std::string &file_path) : file_path_(file_path)
+{
+    std::streamoff valid_size = 0;
+    if (fs::exists(file_path_))
+    {
+        std::ifstream in_file(file_path_, std::ios::binary);
+        valid_size = scanTimeSeriesStore(in_file, series_ids_, series_columns_,
+                                         [](const TimeSeriesChunkHeader &, std::streamoff) {});
+    }
+
+    if (valid_size == 0)
+    {
+        out_file_.open(file_path_, std::ios::trunc | std::ios::binary);
+        out_file_.write(time_series_magic, 8);
+        out_file_.flush();
+        return;
+    }
+    // a chunk truncated by an aborted run is removed before appending
+    fs::resize_file(file_path_, valid_size);
+    out_file_.open(file_path_, std::ios::app | std::ios::binary);
+}
+//=============================================================================================//
+size_t TimeSeriesStore::addSeries(const std::string &series_name, const StdVec<std::string> &column_names)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = series_ids_.find(series_name);
+    if (found != series_ids_.end())
+    {
+        if (series_columns_[found->second] != column_names)
+        {
+            std::cout << "\n Error: the series " << series_name << " is already in "
+                      << file_path_ << " with different columns!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        return found->second;
+    }
+
+    size_t series_id = series_columns_.size();
+    series_ids_[series_name] = series_id;
+    series_columns_.push_back(column_names);
+
+    std::ostringstream payload;
+    writeString(payload, series_name);
+    writeValue(payload, uint64_t(column_names.size()));
+    for (const std::string &column_name : column_names)
+    {
+        writeValue(payload, uint32_t(TimeSeriesColumnType::float64));
+        writeString(payload, column_name);
+    }
+    std::string payload_bytes = payload.str();
+    TimeSeriesChunkHeader header{uint32_t(TimeSeriesChunkType::schema), uint32_t(series_id),
+                                 payload_bytes.size(), 0, 0.0, 0.0};
+    writeValue(out_file_, header);
+    out_file_.write(payload_bytes.data(), payload_bytes.size());
+    out_file_.flush();
+    return series_id;
+}
+//=============================================================================================//
+void TimeSeriesStore::appendRecords(size_t series_id, const StdVec<double> &records)
+{
+    size_t number_of_columns = series_columns_[series_id].size();
+    size_t number_of_records = records.size() / number_of_columns;
+    if (number_of_records == 0)
+        return;
+
+    // transposed so that a column of the chunk is read at once
+    StdVec<double> columns(number_of_records * number_of_columns);
+    for (size_t i = 0; i != number_of_records; ++i)
+        for (size_t j = 0; j != number_of_columns; ++j)
+            columns[j * number_of_records + i] = records[i * number_of_columns + j];
+
+    TimeSeriesChunkHeader header{uint32_t(TimeSeriesChunkType::data), uint32_t(series_id),
+                                 columns.size() * sizeof(double), number_of_records,
+                                 columns.front(), columns[number_of_records - 1]};
+    std::lock_guard<std::mutex> lock(mutex_);
+    writeValue(out_file_, header);
+    out_file_.write(reinterpret_cast<const char *>(columns.data()), columns.size() * sizeof(double));
+    out_file_.flush();
+}
+//=============================================================================================//
+TimeSeriesReader::TimeSeriesReader(const std::string &file_path)
+    : in_file_(file_path, std::ios::binary), is_valid_(false)
+{
+    if (!in_file_.is_open())
+        return;
+
+    is_valid_ = scanTimeSeriesStore(in_file_, series_ids_, series_columns_,
+                                    [&](const TimeSeriesChunkHeader &header, std::streamoff payload_offset)
+                                    {
+                                        series_chunks_.resize(series_columns_.size());
+                                        series_chunks_[header.series_id_].push_back(
+                                            {payload_offset, header.number_of_records_,
+                                             header.first_time_, header.last_time_});
+                                    }) != 0;
+    series_chunks_.resize(series_columns_.size());
+}
+//=============================================================================================//
+StdVec<std::string> TimeSeriesReader::SeriesNames()
+{
+    StdVec<std::string> series_names;
+    for (auto &series : series_ids_)
+        series_names.push_back(series.first);
+    return series_names;
+}
+//=============================================================================================//
+bool TimeSeriesReader::hasSeries(const std::string &series_name)
+{
+    return series_ids_.find(series_name) != series_ids_.end();
+}
+//=============================================================================================//
+size_t TimeSeriesReader::getSeriesID(const std::string &series_name)
+{
+    if (!hasSeries(series_name))
+    {
+        std::cout << "\n Error: the series " << series_name << " is not in the time series store!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    return series_ids_[series_name];
+}
+//=============================================================================================//
+const StdVec<std::string> &TimeSeriesReader::ColumnNames(const std::string &series_name)
+{
+    return series_columns_[getSeriesID(series_name)];
+}
+//=============================================================================================//
+StdVec<StdVec<double>> TimeSeriesReader::readColumns(const std::string &series_name, Real start_time, Real end_time)
+{
+    size_t series_id = getSeriesID(series_name);
+    const StdVec<DataChunk> &chunks = series_chunks_[series_id];
+    // the records of a chunk from this time on are recorded again by a later, restarted run
+    StdVec<double> superseded_time(chunks.size(), MaxReal);
+    for (size_t k = chunks.size(); k > 1; --k)
+        superseded_time[k - 2] = SMIN(superseded_time[k - 1], chunks[k - 1].first_time_);
+
+    StdVec<StdVec<double>> columns(series_columns_[series_id].size());
+    StdVec<double> chunk_columns;
+    for (size_t k = 0; k != chunks.size(); ++k)
+    {
+        const DataChunk &chunk = chunks[k];
+        if (chunk.last_time_ < start_time || chunk.first_time_ > end_time || chunk.first_time_ >= superseded_time[k])
+            continue;
+
+        size_t number_of_records = chunk.number_of_records_;
+        chunk_columns.resize(number_of_records * columns.size());
+        in_file_.seekg(chunk.offset_);
+        in_file_.read(reinterpret_cast<char *>(chunk_columns.data()), chunk_columns.size() * sizeof(double));
+        for (size_t i = 0; i != number_of_records; ++i)
+        {
+            double time = chunk_columns[i];
+            if (time < start_time || time > end_time || time >= superseded_time[k])
+                continue;
+            for (size_t j = 0; j != columns.size(); ++j)
+                columns[j].push_back(chunk_columns[j * number_of_records + i]);
+        }
+    }
+    return columns;
+}
+//=============================================================================================//
+void TimeSeriesReader::getQuantity(const StdVec<StdVec<double>> &columns, size_t record, size_t &column, Real &quantity)
+{
+    quantity = columns[column++][record];
+}
+//=============================================================================================//
+void TimeSeriesReader::getQuantity(const StdVec<StdVec<double>> &columns, size_t record, size_t &column, Vecd &quantity)
+{
+    for (int i = 0; i != Dimensions; ++i)
+        quantity[i] = columns[column++][record];
+}
+//=================================================================================================//
+} // namespace SPH
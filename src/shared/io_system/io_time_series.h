@@ -0,0 +1,142 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_time_series.h
+ * @brief 	A single-file columnar store for the time series of observers and reduced quantities.
+ * @details The file starts with the magic "SPHTS001" followed by appended chunks.
+ *          Each chunk has a TimeSeriesChunkHeader. A schema chunk gives the name of a series
+ *          and its typed columns, a data chunk holds records of a series column by column,
+ *          with the physical time as the first column. Readers find the chunks of a time range
+ *          from the headers only. A chunk truncated by an aborted run is ignored.
+ *          See PythonScriptStore/TimeSeries/time_series_reader.py for the Python reader.
+ * @author	agent
+ */
+
+#ifndef IO_TIME_SERIES_H
+#define IO_TIME_SERIES_H
+
+#include "base_data_package.h"
+#include "sph_data_containers.h"
+
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+
+namespace SPH
+{
+enum class TimeSeriesChunkType : uint32_t
+{
+    schema = 1,
+    data = 2
+};
+
+/** the values are stored as float64, the type is recorded for readers of later extended stores */
+enum class TimeSeriesColumnType : uint32_t
+{
+    float64 = 0
+};
+
+struct TimeSeriesChunkHeader
+{
+    uint32_t chunk_type_;
+    uint32_t series_id_;
+    uint64_t payload_size_;
+    uint64_t number_of_records_;
+    double first_time_;
+    double last_time_;
+};
+
+/**
+ * @class TimeSeriesStore
+ * @brief Appends the schemas and the records of all series of a system to one file.
+ * The file is appended after a restart and a series with an existing name keeps its id.
+ */
+class TimeSeriesStore
+{
+  public:
+    explicit TimeSeriesStore(const std::string &file_path);
+    virtual ~TimeSeriesStore(){};
+
+    const std::string &FilePath() { return file_path_; };
+    /** the first column is the physical time, returns the id of the series */
+    size_t addSeries(const std::string &series_name, const StdVec<std::string> &column_names);
+    /** write the records, given row by row, as a data chunk */
+    void appendRecords(size_t series_id, const StdVec<double> &records);
+
+  protected:
+    std::string file_path_;
+    std::ofstream out_file_;
+    std::mutex mutex_;
+    std::map<std::string, size_t> series_ids_;
+    StdVec<StdVec<std::string>> series_columns_;
+};
+
+/**
+ * @class TimeSeriesReader
+ * @brief Reads the records of a series within a time range from the chunks overlapping it.
+ */
+class TimeSeriesReader
+{
+  public:
+    explicit TimeSeriesReader(const std::string &file_path);
+    virtual ~TimeSeriesReader(){};
+
+    bool isValid() { return is_valid_; };
+    StdVec<std::string> SeriesNames();
+    bool hasSeries(const std::string &series_name);
+    const StdVec<std::string> &ColumnNames(const std::string &series_name);
+    /** the columns of the records with start_time <= time <= end_time, the first is the time.
+     *  A restarted run records again from its restart time, so that only the latest run is read,
+     *  i.e. the records at or after the first time of a later chunk of the series are dropped. */
+    StdVec<StdVec<double>> readColumns(const std::string &series_name,
+                                       Real start_time = -MaxReal, Real end_time = MaxReal);
+    /** assemble a quantity from the columns starting at column of a record, column is advanced */
+    static void getQuantity(const StdVec<StdVec<double>> &columns, size_t record, size_t &column, Real &quantity);
+    static void getQuantity(const StdVec<StdVec<double>> &columns, size_t record, size_t &column, Vecd &quantity);
+
+  protected:
+    struct DataChunk
+    {
+        std::streamoff offset_; /**< of the payload */
+        size_t number_of_records_;
+        double first_time_;
+        double last_time_;
+    };
+
+    std::ifstream in_file_;
+    bool is_valid_;
+    std::map<std::string, size_t> series_ids_;
+    StdVec<StdVec<std::string>> series_columns_;
+    StdVec<StdVec<DataChunk>> series_chunks_;
+
+    size_t getSeriesID(const std::string &series_name);
+};
+
+/** scan the schemas and the data chunk headers of a store,
+ *  returns the end of the last complete chunk or 0 if the file is not a time series store */
+std::streamoff scanTimeSeriesStore(std::ifstream &in_file, std::map<std::string, size_t> &series_ids,
+                                   StdVec<StdVec<std::string>> &series_columns,
+                                   const std::function<void(const TimeSeriesChunkHeader &, std::streamoff)> &data_chunk_found);
+} // namespace SPH
+#endif // IO_TIME_SERIES_H
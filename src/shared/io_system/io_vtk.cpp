@@ -10,76 +10,407 @@ namespace SPH
 //=============================================================================================//
 void BodyStatesRecordingToVtp::writeWithFileName(const std::string &sequence)
 {
-    for (SPHBody *body : bodies_)
+    output_sequence_ = std::stoul(sequence);
+    bool is_any_body_written = false;
+    for (size_t i = 0; i != bodies_.size(); ++i)
     {
+        SPHBody *body = bodies_[i];
         if (body->checkNewlyUpdated())
         {
-            BaseParticles &base_particles = body->getBaseParticles();
-
             if (state_recording_)
             {
-                std::string filefullpath = io_environment_.output_folder_ + "/" + body->getName() + "_" + sequence + ".vtp";
-                if (fs::exists(filefullpath))
-                {
-                    fs::remove(filefullpath);
-                }
-                std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
-                // begin of the XML file
-                out_file << "<?xml version=\"1.0\"?>\n";
-                out_file << "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
-                out_file << " <PolyData>\n";
-
-                size_t total_real_particles = base_particles.TotalRealParticles();
-                out_file << "  <Piece Name =\"" << body->getName() << "\" NumberOfPoints=\"" << total_real_particles
-                         << "\" NumberOfVerts=\"" << total_real_particles << "\">\n";
-
-                // write current/final particle positions first
-                out_file << "   <Points>\n";
-                out_file << "    <DataArray Name=\"Position\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
-                out_file << "    ";
-                for (size_t i = 0; i != total_real_particles; ++i)
+                is_any_body_written = true;
+                std::string file_name = body->getName() + "_" + sequence;
+                if (encoding_ == VtkEncoding::ascii)
                 {
-                    Vec3d particle_position = upgradeToVec3d(base_particles.ParticlePositions()[i]);
-                    out_file << particle_position[0] << " " << particle_position[1] << " " << particle_position[2] << " ";
+                    std::string filefullpath = io_environment_.output_folder_ + "/" + file_name + ".vtp";
+                    if (fs::exists(filefullpath))
+                    {
+                        fs::remove(filefullpath);
+                    }
+                    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+                    writeAsciiVtp(out_file, *body);
+                    out_file.close();
                 }
-                out_file << std::endl;
-                out_file << "    </DataArray>\n";
-                out_file << "   </Points>\n";
-
-                // write header of particles data
-                out_file << "   <PointData  Vectors=\"vector\">\n";
-                body->writeParticlesToVtpFile(out_file);
-                out_file << "   </PointData>\n";
-
-                // write empty cells
-                out_file << "   <Verts>\n";
-                out_file << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
-                out_file << "    ";
-                for (size_t i = 0; i != total_real_particles; ++i)
+                else if (output_filters_[i] != nullptr)
                 {
-                    out_file << i << " ";
+                    ParticleStatesSnapshot &snapshot = *filtered_snapshots_[i];
+                    copyParticleStates(i, snapshot);
+                    writeVtpFiles(io_environment_.output_folder_, file_name, body->getName(),
+                                  snapshot.TotalRealParticles(), snapshot.ParticlePositions(),
+                                  snapshot.ParticleOriginalIds(), snapshot.getVariablesToWrite());
                 }
-                out_file << std::endl;
-                out_file << "    </DataArray>\n";
-                out_file << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
-                out_file << "    ";
-                for (size_t i = 0; i != total_real_particles; ++i)
+                else
                 {
-                    out_file << i + 1 << " ";
+                    BaseParticles &base_particles = body->getBaseParticles();
+                    writeVtpFiles(io_environment_.output_folder_, file_name, body->getName(),
+                                  base_particles.TotalRealParticles(), base_particles.ParticlePositions(),
+                                  base_particles.ParticleOriginalIds(), getVariablesDue(base_particles));
                 }
-                out_file << std::endl;
-                out_file << "    </DataArray>\n";
-                out_file << "   </Verts>\n";
+            }
+        }
+        body->setNotNewlyUpdated();
+    }
+
+    if (is_any_body_written)
+    {
+        previous_output_sequence_ = output_sequence_;
+    }
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtp::setNumberOfPieces(size_t number_of_pieces)
+{
+    if (encoding_ == VtkEncoding::ascii && number_of_pieces > 1)
+    {
+        std::cout << "\n Error: the partitioned output writes binary data only, "
+                  << "please choose the raw or base64 encoding." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    number_of_pieces_ = SMAX(number_of_pieces, size_t(1));
+}
+//=============================================================================================//
+size_t BodyStatesRecordingToVtp::getBinaryOutputBodyIndex(SPHBody &sph_body)
+{
+    if (encoding_ == VtkEncoding::ascii)
+    {
+        std::cout << "\n Error: the filtered output writes binary data only, "
+                  << "please choose the raw or base64 encoding." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    auto found = std::find(bodies_.begin(), bodies_.end(), &sph_body);
+    if (found == bodies_.end())
+    {
+        std::cout << "\n Error: the body:" << sph_body.getName()
+                  << " is not in the recording list" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    return found - bodies_.begin();
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtp::setOutputInterval(const std::string &variable_name, size_t output_interval)
+{
+    if (encoding_ == VtkEncoding::ascii)
+    {
+        std::cout << "\n Error: the output intervals of variables apply to binary data only, "
+                  << "please choose the raw or base64 encoding." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    output_intervals_[variable_name] = SMAX(output_interval, size_t(1));
+}
+//=============================================================================================//
+bool BodyStatesRecordingToVtp::isOutputIntervalDue(size_t output_interval)
+{
+    return previous_output_sequence_ == MaxSize_t ||
+           output_sequence_ / output_interval != previous_output_sequence_ / output_interval;
+}
+//=============================================================================================//
+template <typename DataType>
+void BodyStatesRecordingToVtp::SelectVariablesDue::
+operator()(const DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           BodyStatesRecordingToVtp *recording, ParticleVariables &variables_due)
+{
+    constexpr int type_index = DataTypeIndex<DataType>::value;
+    for (DiscreteVariable<DataType> *variable : variables)
+    {
+        auto output_interval = recording->output_intervals_.find(variable->Name());
+        if (output_interval == recording->output_intervals_.end() ||
+            recording->isOutputIntervalDue(output_interval->second))
+        {
+            std::get<type_index>(variables_due).push_back(variable);
+        }
+    }
+}
+//=============================================================================================//
+ParticleVariables BodyStatesRecordingToVtp::getVariablesDue(BaseParticles &base_particles)
+{
+    if (output_intervals_.empty())
+    {
+        return base_particles.getVariablesToWrite();
+    }
+
+    ParticleVariables variables_due;
+    OperationOnDataAssemble<const ParticleVariables, SelectVariablesDue>
+        select_variables_due(base_particles.getVariablesToWrite());
+    select_variables_due(this, variables_due);
+    return variables_due;
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtp::copyParticleStates(size_t body_index, ParticleStatesSnapshot &snapshot)
+{
+    BaseParticles &base_particles = bodies_[body_index]->getBaseParticles();
+    OutputFilter *output_filter = output_filters_[body_index];
+    if (output_filter == nullptr)
+    {
+        snapshot.copyFrom(base_particles, getVariablesDue(base_particles));
+        return;
+    }
+    output_filter->selectParticles(base_particles, selected_particles_);
+    snapshot.copyFrom(base_particles, getVariablesDue(base_particles), &selected_particles_);
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtp::writeVtpFiles(const std::string &folder, const std::string &file_name,
+                                             const std::string &body_name, size_t total_real_particles,
+                                             const StdLargeVec<Vecd> &positions,
+                                             const StdLargeVec<size_t> &original_ids,
+                                             const ParticleVariables &variables)
+{
+    // the pieces are kept in a folder next to the parallel file referring to them
+    std::string pieces_folder = folder + "/" + file_name;
+    if (number_of_pieces_ == 1)
+    {
+        // a partitioned output with the same name from an earlier run is replaced
+        fs::remove_all(pieces_folder);
+        fs::remove(folder + "/" + file_name + ".pvtp");
+        std::ofstream out_file((folder + "/" + file_name + ".vtp").c_str(), std::ios::trunc | std::ios::binary);
+        writeAppendedDataVtp(out_file, body_name, 0, total_real_particles, positions, original_ids, variables);
+        out_file.close();
+        return;
+    }
 
-                out_file << "  </Piece>\n";
-                out_file << " </PolyData>\n";
-                out_file << "</VTKFile>\n";
+    if (!fs::exists(pieces_folder))
+    {
+        fs::create_directory(pieces_folder);
+    }
+    StdVec<std::string> piece_names;
+    for (size_t k = 0; k != number_of_pieces_; ++k)
+    {
+        piece_names.push_back(file_name + "/" + file_name + "_" + std::to_string(k) + ".vtp");
+    }
 
+    parallel_for(
+        IndexRange(0, number_of_pieces_),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+            {
+                size_t first_particle = k * total_real_particles / number_of_pieces_;
+                size_t end_particle = (k + 1) * total_real_particles / number_of_pieces_;
+                std::ofstream out_file((folder + "/" + piece_names[k]).c_str(), std::ios::trunc | std::ios::binary);
+                writeAppendedDataVtp(out_file, body_name, first_particle, end_particle - first_particle,
+                                     positions, original_ids, variables);
                 out_file.close();
             }
+        });
+
+    // the pieces beyond the current number from an earlier output with more pieces are removed
+    for (size_t k = number_of_pieces_;; ++k)
+    {
+        std::string stale_piece = pieces_folder + "/" + file_name + "_" + std::to_string(k) + ".vtp";
+        if (!fs::remove(stale_piece))
+            break;
+    }
+    fs::remove(folder + "/" + file_name + ".vtp");
+
+    // the parallel file only declares the data arrays, no data is written
+    VtkAppendedData appended_data(encoding_);
+    std::ofstream out_file((folder + "/" + file_name + ".pvtp").c_str(), std::ios::trunc);
+    out_file << "<?xml version=\"1.0\"?>\n";
+    out_file << "<VTKFile type=\"PPolyData\" " << appended_data.FileAttributes() << ">\n";
+    out_file << " <PPolyData GhostLevel=\"0\">\n";
+    out_file << "  <PPoints>\n";
+    appended_data.addDataArray("Position", positions, 0);
+    out_file << appended_data.takeParallelDataArrays();
+    out_file << "  </PPoints>\n";
+    out_file << "  <PPointData  Vectors=\"vector\">\n";
+    appended_data.addParticleVariables(0, 0, original_ids, variables);
+    out_file << appended_data.takeParallelDataArrays();
+    out_file << "  </PPointData>\n";
+    for (const std::string &piece_name : piece_names)
+    {
+        out_file << "  <Piece Source=\"" << piece_name << "\"/>\n";
+    }
+    out_file << " </PPolyData>\n";
+    out_file << "</VTKFile>\n";
+    out_file.close();
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtp::writeAsciiVtp(std::ofstream &out_file, SPHBody &body)
+{
+    BaseParticles &base_particles = body.getBaseParticles();
+
+    // begin of the XML file
+    out_file << "<?xml version=\"1.0\"?>\n";
+    out_file << "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+    out_file << " <PolyData>\n";
+
+    size_t total_real_particles = base_particles.TotalRealParticles();
+    out_file << "  <Piece Name =\"" << body.getName() << "\" NumberOfPoints=\"" << total_real_particles
+             << "\" NumberOfVerts=\"" << total_real_particles << "\">\n";
+
+    // write current/final particle positions first
+    out_file << "   <Points>\n";
+    out_file << "    <DataArray Name=\"Position\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
+    out_file << "    ";
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Vec3d particle_position = upgradeToVec3d(base_particles.ParticlePositions()[i]);
+        out_file << particle_position[0] << " " << particle_position[1] << " " << particle_position[2] << " ";
+    }
+    out_file << std::endl;
+    out_file << "    </DataArray>\n";
+    out_file << "   </Points>\n";
+
+    // write header of particles data
+    out_file << "   <PointData  Vectors=\"vector\">\n";
+    body.writeParticlesToVtpFile(out_file);
+    out_file << "   </PointData>\n";
+
+    // write empty cells
+    out_file << "   <Verts>\n";
+    out_file << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
+    out_file << "    ";
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        out_file << i << " ";
+    }
+    out_file << std::endl;
+    out_file << "    </DataArray>\n";
+    out_file << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
+    out_file << "    ";
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        out_file << i + 1 << " ";
+    }
+    out_file << std::endl;
+    out_file << "    </DataArray>\n";
+    out_file << "   </Verts>\n";
+
+    out_file << "  </Piece>\n";
+    out_file << " </PolyData>\n";
+    out_file << "</VTKFile>\n";
+}
+//=============================================================================================//
+void BodyStatesRecordingToVtp::writeAppendedDataVtp(std::ofstream &out_file, const std::string &body_name,
+                                                    size_t first_particle, size_t number_of_particles,
+                                                    const StdLargeVec<Vecd> &positions,
+                                                    const StdLargeVec<size_t> &original_ids,
+                                                    const ParticleVariables &variables)
+{
+    VtkAppendedData appended_data(encoding_);
+
+    // begin of the XML file
+    out_file << "<?xml version=\"1.0\"?>\n";
+    out_file << "<VTKFile type=\"PolyData\" " << appended_data.FileAttributes() << ">\n";
+    out_file << " <PolyData>\n";
+    out_file << "  <Piece Name =\"" << body_name << "\" NumberOfPoints=\"" << number_of_particles
+             << "\" NumberOfVerts=\"" << number_of_particles << "\">\n";
+
+    // write current/final particle positions first
+    out_file << "   <Points>\n";
+    out_file << appended_data.addDataArray("Position", positions, number_of_particles, first_particle);
+    out_file << "   </Points>\n";
+
+    // write header of particles data
+    out_file << "   <PointData  Vectors=\"vector\">\n";
+    out_file << appended_data.addParticleVariables(first_particle, number_of_particles, original_ids, variables);
+    out_file << "   </PointData>\n";
+
+    // write vertex cells, one for each particle
+    out_file << "   <Verts>\n";
+    out_file << appended_data.addInt32Array("connectivity", 1, number_of_particles,
+                                            [](size_t begin, size_t end, int *values)
+                                            {
+                                                for (size_t i = begin; i != end; ++i)
+                                                    *values++ = int(i);
+                                            });
+    out_file << appended_data.addInt32Array("offsets", 1, number_of_particles,
+                                            [](size_t begin, size_t end, int *values)
+                                            {
+                                                for (size_t i = begin; i != end; ++i)
+                                                    *values++ = int(i + 1);
+                                            });
+    out_file << "   </Verts>\n";
+
+    out_file << "  </Piece>\n";
+    out_file << " </PolyData>\n";
+    appended_data.writeAppendedData(out_file);
+    out_file << "</VTKFile>\n";
+}
+//=============================================================================================//
+AsynchronousBodyStatesRecordingToVtp::
+    AsynchronousBodyStatesRecordingToVtp(SPHBody &body, VtkEncoding encoding, size_t number_of_buffers)
+    : BodyStatesRecordingToVtp(body, encoding), asynchronous_writer_(number_of_buffers), current_buffer_(0)
+{
+    initializeSnapshotBuffers();
+}
+//=============================================================================================//
+AsynchronousBodyStatesRecordingToVtp::
+    AsynchronousBodyStatesRecordingToVtp(SPHSystem &sph_system, VtkEncoding encoding, size_t number_of_buffers)
+    : BodyStatesRecordingToVtp(sph_system, encoding), asynchronous_writer_(number_of_buffers), current_buffer_(0)
+{
+    initializeSnapshotBuffers();
+}
+//=============================================================================================//
+AsynchronousBodyStatesRecordingToVtp::~AsynchronousBodyStatesRecordingToVtp()
+{
+    // the snapshots are still used by the pending writes
+    asynchronous_writer_.flush();
+    io_environment_.removeBufferedOutput(&asynchronous_writer_);
+}
+//=============================================================================================//
+void AsynchronousBodyStatesRecordingToVtp::initializeSnapshotBuffers()
+{
+    if (encoding_ == VtkEncoding::ascii)
+    {
+        std::cout << "\n Error: the asynchronous recording writes binary data only, "
+                  << "please choose the raw or base64 encoding." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    snapshot_buffers_.resize(asynchronous_writer_.MaxPendingTasks());
+    for (StdVec<ParticleStatesSnapshot *> &snapshots : snapshot_buffers_)
+    {
+        for (size_t i = 0; i != bodies_.size(); ++i)
+        {
+            snapshots.push_back(snapshots_keeper_.createPtr<ParticleStatesSnapshot>());
+        }
+    }
+    io_environment_.addBufferedOutput(&asynchronous_writer_);
+}
+//=============================================================================================//
+void AsynchronousBodyStatesRecordingToVtp::writeWithFileName(const std::string &sequence)
+{
+    // the buffer is free once the write submitted a full rotation before is finished
+    asynchronous_writer_.waitForFreeSlot();
+    output_sequence_ = std::stoul(sequence);
+    StdVec<ParticleStatesSnapshot *> &snapshots = snapshot_buffers_[current_buffer_];
+
+    // file name, body name and snapshot of the bodies to write
+    StdVec<std::tuple<std::string, std::string, ParticleStatesSnapshot *>> files_to_write;
+    for (size_t i = 0; i != bodies_.size(); ++i)
+    {
+        SPHBody *body = bodies_[i];
+        if (body->checkNewlyUpdated() && state_recording_)
+        {
+            copyParticleStates(i, *snapshots[i]);
+            std::string file_name = body->getName() + "_" + sequence;
+            files_to_write.push_back(std::make_tuple(file_name, body->getName(), snapshots[i]));
         }
         body->setNotNewlyUpdated();
     }
+
+    if (!files_to_write.empty())
+    {
+        std::string output_folder = io_environment_.output_folder_;
+        asynchronous_writer_.submit(
+            [this, output_folder, files_to_write]()
+            {
+                for (auto &file_to_write : files_to_write)
+                {
+                    ParticleStatesSnapshot &snapshot = *std::get<2>(file_to_write);
+                    writeVtpFiles(output_folder, std::get<0>(file_to_write), std::get<1>(file_to_write),
+                                  snapshot.TotalRealParticles(), snapshot.ParticlePositions(),
+                                  snapshot.ParticleOriginalIds(), snapshot.getVariablesToWrite());
+                }
+            });
+        current_buffer_ = (current_buffer_ + 1) % snapshot_buffers_.size();
+        previous_output_sequence_ = output_sequence_;
+    }
 }
 //=============================================================================================//
 void BodyStatesRecordingToVtpString::writeWithFileName(const std::string &sequence)
@@ -225,4 +556,13 @@ void ParticleGenerationRecordingToVtp::writeWithFileName(const std::string &sequ
     }
 }
 //=================================================================================================//
+MeshRecordingToVtk::MeshRecordingToVtk(SPHSystem &sph_system, BaseMeshField &mesh_field)
+    : BaseIO(sph_system), mesh_field_(mesh_field),
+      filefullpath_without_extension_(io_environment_.output_folder_ + "/" + mesh_field.Name()) {}
+//=============================================================================================//
+void MeshRecordingToVtk::writeToFile(size_t iteration_step)
+{
+    mesh_field_.writeMeshFieldToVtk(filefullpath_without_extension_ + "_" + padValueWithZeros(iteration_step));
+}
+//=============================================================================================//
 } // namespace SPH
@@ -29,7 +29,10 @@
 #ifndef IO_VTK_H
 #define IO_VTK_H
 
+#include "io_asynchronous.h"
 #include "io_base.h"
+#include "io_output_filter.h"
+#include "io_vtk_binary.h"
 
 using VtuStringData = std::map<std::string, std::string>;
 
@@ -39,16 +42,114 @@ namespace SPH
  * @class BodyStatesRecordingToVtp
  * @brief  Write files for bodies
  * the output file is VTK XML format can visualized by ParaView the data type vtkPolyData
+ * The data are written as ascii text by default, or as binary appended data,
+ * which is much faster to write and read and gives much smaller files for large bodies.
  */
 class BodyStatesRecordingToVtp : public BodyStatesRecording
 {
   public:
-    BodyStatesRecordingToVtp(SPHBody &body) : BodyStatesRecording(body){};
-    BodyStatesRecordingToVtp(SPHSystem &sph_system) : BodyStatesRecording(sph_system){};
+    BodyStatesRecordingToVtp(SPHBody &body, VtkEncoding encoding = VtkEncoding::ascii)
+        : BodyStatesRecording(body), encoding_(encoding), number_of_pieces_(1),
+          output_filters_(bodies_.size(), nullptr), filtered_snapshots_(bodies_.size(), nullptr),
+          output_sequence_(0), previous_output_sequence_(MaxSize_t){};
+    BodyStatesRecordingToVtp(SPHSystem &sph_system, VtkEncoding encoding = VtkEncoding::ascii)
+        : BodyStatesRecording(sph_system), encoding_(encoding), number_of_pieces_(1),
+          output_filters_(bodies_.size(), nullptr), filtered_snapshots_(bodies_.size(), nullptr),
+          output_sequence_(0), previous_output_sequence_(MaxSize_t){};
     virtual ~BodyStatesRecordingToVtp(){};
+    /** Split the particles of each body into contiguous pieces written concurrently to their own files,
+     *  and a .pvtp file which is opened by ParaView as one dataset. Binary encodings only. */
+    void setNumberOfPieces(size_t number_of_pieces);
+
+    /** Write only the particles of the body selected by the filter, see io_output_filter.h.
+     *  Binary encodings only. */
+    template <class OutputFilterType, typename... Args>
+    OutputFilterType &addOutputFilter(SPHBody &sph_body, Args &&...args)
+    {
+        size_t body_index = getBinaryOutputBodyIndex(sph_body);
+        OutputFilterType *output_filter =
+            output_filters_keeper_.createPtr<OutputFilterType>(std::forward<Args>(args)...);
+        output_filters_[body_index] = output_filter;
+        if (filtered_snapshots_[body_index] == nullptr)
+        {
+            filtered_snapshots_[body_index] = filtered_snapshots_keeper_.createPtr<ParticleStatesSnapshot>();
+        }
+        return *output_filter;
+    };
+
+    /** Write the variable, e.g. a large or slowly changing one, only once in each output_interval of the
+     *  output sequence, i.e. of the iteration step given to writeToFile(iteration_step) or of the physical time
+     *  in microseconds used by writeToFile(). The intervals are counted from sequence zero, so that they keep
+     *  aligned after a restart, and the variable is always written with the first output of a run.
+     *  Binary encodings only. */
+    void setOutputInterval(const std::string &variable_name, size_t output_interval);
 
   protected:
+    VtkEncoding encoding_;
+    size_t number_of_pieces_;
+    StdVec<OutputFilter *> output_filters_;                /**< of each body, nullptr for all particles */
+    StdVec<ParticleStatesSnapshot *> filtered_snapshots_; /**< the gathered selected particles of each body */
+    IndexVector selected_particles_;
+    std::map<std::string, size_t> output_intervals_;
+    size_t output_sequence_;          /**< of the current output */
+    size_t previous_output_sequence_; /**< of the last output with any body written, MaxSize_t before */
+
     virtual void writeWithFileName(const std::string &sequence) override;
+    void writeAsciiVtp(std::ofstream &out_file, SPHBody &body);
+    /** write the .vtp file, or the pieces and the .pvtp file, named file_name in the folder */
+    void writeVtpFiles(const std::string &folder, const std::string &file_name, const std::string &body_name,
+                       size_t total_real_particles, const StdLargeVec<Vecd> &positions,
+                       const StdLargeVec<size_t> &original_ids, const ParticleVariables &variables);
+    void writeAppendedDataVtp(std::ofstream &out_file, const std::string &body_name,
+                              size_t first_particle, size_t number_of_particles, const StdLargeVec<Vecd> &positions,
+                              const StdLargeVec<size_t> &original_ids, const ParticleVariables &variables);
+    /** the variables to write due at the current output */
+    bool isOutputIntervalDue(size_t output_interval);
+    ParticleVariables getVariablesDue(BaseParticles &base_particles);
+    /** take the snapshot of the filtered particles and variables due, or copy all of them */
+    void copyParticleStates(size_t body_index, ParticleStatesSnapshot &snapshot);
+
+  private:
+    UniquePtrsKeeper<OutputFilter> output_filters_keeper_;
+    UniquePtrsKeeper<ParticleStatesSnapshot> filtered_snapshots_keeper_;
+    size_t getBinaryOutputBodyIndex(SPHBody &sph_body);
+
+    struct SelectVariablesDue
+    {
+        template <typename DataType>
+        void operator()(const DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        BodyStatesRecordingToVtp *recording, ParticleVariables &variables_due);
+    };
+};
+
+/**
+ * @class AsynchronousBodyStatesRecordingToVtp
+ * @brief Write the body states as binary VTP files by a dedicated I/O thread.
+ * At the call site, the states are only copied in parallel into one of the rotating snapshot buffers,
+ * and the simulation continues while the files are written.
+ * The number of buffers bounds the pending writes, the default two gives double buffering.
+ * The pending files are written before restart files and when the recording is destroyed.
+ */
+class AsynchronousBodyStatesRecordingToVtp : public BodyStatesRecordingToVtp
+{
+  public:
+    AsynchronousBodyStatesRecordingToVtp(SPHBody &body, VtkEncoding encoding = VtkEncoding::raw,
+                                         size_t number_of_buffers = 2);
+    AsynchronousBodyStatesRecordingToVtp(SPHSystem &sph_system, VtkEncoding encoding = VtkEncoding::raw,
+                                         size_t number_of_buffers = 2);
+    virtual ~AsynchronousBodyStatesRecordingToVtp();
+    /** wait until all pending files are written */
+    void flush() { asynchronous_writer_.flush(); };
+
+  protected:
+    AsynchronousWriter asynchronous_writer_;
+    UniquePtrsKeeper<ParticleStatesSnapshot> snapshots_keeper_;
+    StdVec<StdVec<ParticleStatesSnapshot *>> snapshot_buffers_; /**< snapshots of all bodies in each buffer */
+    size_t current_buffer_;
+    virtual void writeWithFileName(const std::string &sequence) override;
+
+  private:
+    void initializeSnapshotBuffers();
 };
 
 /**
@@ -110,5 +211,21 @@ class ParticleGenerationRecordingToVtp : public ParticleGenerationRecording
     StdLargeVec<Vecd> &position_;
     virtual void writeWithFileName(const std::string &sequence) override;
 };
+
+/**
+ * @class MeshRecordingToVtk
+ * @brief write the mesh data in binary VTK format, e.g. image data for level sets
+ */
+class MeshRecordingToVtk : public BaseIO
+{
+  protected:
+    BaseMeshField &mesh_field_;
+    std::string filefullpath_without_extension_;
+
+  public:
+    MeshRecordingToVtk(SPHSystem &sph_system, BaseMeshField &mesh_field);
+    virtual ~MeshRecordingToVtk(){};
+    virtual void writeToFile(size_t iteration_step = 0) override;
+};
 } // namespace SPH
 #endif // IO_VTK_H
@@ -0,0 +1,192 @@
+/**
+ * @file 	io_vtk_binary.cpp
+ * @author	agent
+ */
+
+#include "io_vtk_binary.h"
+
+namespace SPH
+{
+//=============================================================================================//
+std::string VtkAppendedData::FileAttributes()
+{
+    return "version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\"";
+}
+//=============================================================================================//
+std::string VtkAppendedData::addFloat32Array(const std::string &name, int number_of_components,
+                                             size_t number_of_entries, const DataFiller<float> &data_filler)
+{
+    return addArray(name, "Float32", number_of_components, number_of_entries,
+                    [data_filler](size_t begin, size_t end, char *buffer)
+                    { data_filler(begin, end, reinterpret_cast<float *>(buffer)); });
+}
+//=============================================================================================//
+std::string VtkAppendedData::addInt32Array(const std::string &name, int number_of_components,
+                                           size_t number_of_entries, const DataFiller<int> &data_filler)
+{
+    return addArray(name, "Int32", number_of_components, number_of_entries,
+                    [data_filler](size_t begin, size_t end, char *buffer)
+                    { data_filler(begin, end, reinterpret_cast<int *>(buffer)); });
+}
+//=============================================================================================//
+std::string VtkAppendedData::addDataArray(const std::string &name, const StdLargeVec<int> &data,
+                                          size_t number_of_entries, size_t first_entry)
+{
+    const int *data_ptr = data.data() + first_entry;
+    return addInt32Array(name, 1, number_of_entries,
+                         [data_ptr](size_t begin, size_t end, int *values)
+                         { std::copy(data_ptr + begin, data_ptr + end, values); });
+}
+//=============================================================================================//
+std::string VtkAppendedData::addParticleVariables(size_t first_particle, size_t number_of_particles,
+                                                  const StdLargeVec<size_t> &original_ids,
+                                                  const ParticleVariables &variables)
+{
+    std::string data_arrays;
+    // write sorted particles ID
+    data_arrays += addInt32Array("SortedParticle_ID", 1, number_of_particles,
+                                 [first_particle](size_t begin, size_t end, int *values)
+                                 {
+                                     for (size_t i = begin; i != end; ++i)
+                                         *values++ = int(first_particle + i);
+                                 });
+
+    // write original particles ID
+    const size_t *original_ids_ptr = original_ids.data() + first_particle;
+    data_arrays += addInt32Array("OriginalParticle_ID", 1, number_of_particles,
+                                 [original_ids_ptr](size_t begin, size_t end, int *values)
+                                 {
+                                     for (size_t i = begin; i != end; ++i)
+                                         *values++ = int(original_ids_ptr[i]);
+                                 });
+
+    constexpr int type_index_int = DataTypeIndex<int>::value;
+    for (DiscreteVariable<int> *variable : std::get<type_index_int>(variables))
+        data_arrays += addDataArray(variable->Name(), *variable->DataField(), number_of_particles, first_particle);
+
+    constexpr int type_index_Real = DataTypeIndex<Real>::value;
+    for (DiscreteVariable<Real> *variable : std::get<type_index_Real>(variables))
+        data_arrays += addDataArray(variable->Name(), *variable->DataField(), number_of_particles, first_particle);
+
+    constexpr int type_index_Vecd = DataTypeIndex<Vecd>::value;
+    for (DiscreteVariable<Vecd> *variable : std::get<type_index_Vecd>(variables))
+        data_arrays += addDataArray(variable->Name(), *variable->DataField(), number_of_particles, first_particle);
+
+#if !SPHINXSYS_USE_FLOAT
+    constexpr int type_index_reduced_Real = DataTypeIndex<ReducedData<Real>>::value;
+    for (DiscreteVariable<ReducedData<Real>> *variable : std::get<type_index_reduced_Real>(variables))
+        data_arrays += addDataArray(variable->Name(), *variable->DataField(), number_of_particles, first_particle);
+
+    constexpr int type_index_reduced_Vecd = DataTypeIndex<ReducedData<Vecd>>::value;
+    for (DiscreteVariable<ReducedData<Vecd>> *variable : std::get<type_index_reduced_Vecd>(variables))
+        data_arrays += addDataArray(variable->Name(), *variable->DataField(), number_of_particles, first_particle);
+#endif
+
+    constexpr int type_index_Matd = DataTypeIndex<Matd>::value;
+    for (DiscreteVariable<Matd> *variable : std::get<type_index_Matd>(variables))
+        data_arrays += addDataArray(variable->Name(), *variable->DataField(), number_of_particles, first_particle);
+
+    return data_arrays;
+}
+//=============================================================================================//
+std::string VtkAppendedData::addArray(const std::string &name, const std::string &type, int number_of_components,
+                                      size_t number_of_entries,
+                                      const std::function<void(size_t, size_t, char *)> &data_filler)
+{
+    std::stringstream data_array;
+    data_array << "    <DataArray Name=\"" << name << "\" type=\"" << type
+               << "\" NumberOfComponents=\"" << number_of_components
+               << "\" format=\"appended\" offset=\"" << offset_ << "\"/>\n";
+
+    size_t bytes_per_entry = 4 * number_of_components;
+    data_arrays_.push_back({name, type, number_of_components, bytes_per_entry, number_of_entries, data_filler});
+    offset_ += EncodedSize(sizeof(uint64_t)) + EncodedSize(bytes_per_entry * number_of_entries);
+    return data_array.str();
+}
+//=============================================================================================//
+std::string VtkAppendedData::takeParallelDataArrays()
+{
+    std::stringstream parallel_data_arrays;
+    for (DataArray &data_array : data_arrays_)
+    {
+        parallel_data_arrays << "    <PDataArray Name=\"" << data_array.name_ << "\" type=\"" << data_array.type_
+                             << "\" NumberOfComponents=\"" << data_array.number_of_components_ << "\"/>\n";
+    }
+    data_arrays_.clear();
+    offset_ = 0;
+    return parallel_data_arrays.str();
+}
+//=============================================================================================//
+size_t VtkAppendedData::EncodedSize(size_t number_of_bytes)
+{
+    return encoding_ == VtkEncoding::base64 ? 4 * ((number_of_bytes + 2) / 3) : number_of_bytes;
+}
+//=============================================================================================//
+void VtkAppendedData::writeEncoded(std::ostream &output_stream, const char *data, size_t number_of_bytes)
+{
+    if (encoding_ != VtkEncoding::base64)
+    {
+        output_stream.write(data, number_of_bytes);
+        return;
+    }
+
+    static const char base64_table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+    std::string encoded(EncodedSize(number_of_bytes), '=');
+    size_t position = 0;
+    for (size_t i = 0; i < number_of_bytes; i += 3)
+    {
+        uint32_t triple = uint32_t(bytes[i]) << 16;
+        if (i + 1 < number_of_bytes)
+            triple |= uint32_t(bytes[i + 1]) << 8;
+        if (i + 2 < number_of_bytes)
+            triple |= uint32_t(bytes[i + 2]);
+        encoded[position] = base64_table[(triple >> 18) & 0x3F];
+        encoded[position + 1] = base64_table[(triple >> 12) & 0x3F];
+        if (i + 1 < number_of_bytes)
+            encoded[position + 2] = base64_table[(triple >> 6) & 0x3F];
+        if (i + 2 < number_of_bytes)
+            encoded[position + 3] = base64_table[triple & 0x3F];
+        position += 4;
+    }
+    output_stream.write(encoded.data(), encoded.size());
+}
+//=============================================================================================//
+void VtkAppendedData::writeAppendedData(std::ostream &output_stream)
+{
+    output_stream << " <AppendedData encoding=\"" << (encoding_ == VtkEncoding::base64 ? "base64" : "raw") << "\">\n";
+    output_stream << "  _";
+    StdVec<char> buffer;
+    for (DataArray &data_array : data_arrays_)
+    {
+        // the header with the number of bytes is encoded separately from the data
+        uint64_t number_of_bytes = data_array.bytes_per_entry_ * data_array.number_of_entries_;
+        writeEncoded(output_stream, reinterpret_cast<const char *>(&number_of_bytes), sizeof(uint64_t));
+
+        // the chunks of a batch are filled in parallel and written in sequence
+        size_t entries_per_batch = entries_per_chunk_ * chunks_per_batch_;
+        buffer.resize(data_array.bytes_per_entry_ * entries_per_batch);
+        for (size_t batch_begin = 0; batch_begin < data_array.number_of_entries_; batch_begin += entries_per_batch)
+        {
+            size_t batch_end = SMIN(batch_begin + entries_per_batch, data_array.number_of_entries_);
+            size_t number_of_chunks = (batch_end - batch_begin + entries_per_chunk_ - 1) / entries_per_chunk_;
+            parallel_for(
+                IndexRange(0, number_of_chunks),
+                [&](const IndexRange &r)
+                {
+                    for (size_t n = r.begin(); n != r.end(); ++n)
+                    {
+                        size_t begin = batch_begin + n * entries_per_chunk_;
+                        size_t end = SMIN(begin + entries_per_chunk_, batch_end);
+                        data_array.data_filler_(begin, end, buffer.data() + data_array.bytes_per_entry_ * (begin - batch_begin));
+                    }
+                });
+            writeEncoded(output_stream, buffer.data(), data_array.bytes_per_entry_ * (batch_end - batch_begin));
+        }
+    }
+    output_stream << "\n </AppendedData>\n";
+    data_arrays_.clear();
+    offset_ = 0;
+}
+//=============================================================================================//
+} // namespace SPH
@@ -0,0 +1,181 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_vtk_binary.h
+ * @brief 	Binary data arrays in the appended data section of VTK XML files.
+ * @details The arrays are declared with their offsets in the XML part first.
+ *			Their values are converted and written chunk by chunk afterwards,
+ *			so that no converted copy of the whole data is kept in memory.
+ * @author	agent
+ */
+
+#ifndef IO_VTK_BINARY_H
+#define IO_VTK_BINARY_H
+
+#include "base_data_package.h"
+#include "sph_data_containers.h"
+#include "vector_functions.h"
+
+#include <functional>
+#include <ostream>
+
+namespace SPH
+{
+/** ascii data arrays inline, or binary ones in the appended data section encoded raw or by base64 */
+enum class VtkEncoding
+{
+    ascii,
+    raw,
+    base64
+};
+
+/** number of Float32 components and their conversion for the particle data types */
+template <typename DataType>
+struct VtkComponents;
+template <>
+struct VtkComponents<Real>
+{
+    static constexpr int value = 1;
+    static float *copy(const Real &data, float *values)
+    {
+        *values = float(data);
+        return values + 1;
+    };
+};
+template <>
+struct VtkComponents<Vecd>
+{
+    static constexpr int value = 3;
+    static float *copy(const Vecd &data, float *values)
+    {
+        Vec3d vector_value = upgradeToVec3d(data);
+        for (int k = 0; k != 3; ++k)
+            *values++ = float(vector_value[k]);
+        return values;
+    };
+};
+template <>
+struct VtkComponents<Matd>
+{
+    static constexpr int value = 9;
+    static float *copy(const Matd &data, float *values)
+    {
+        Mat3d matrix_value = upgradeToMat3d(data);
+        for (int k = 0; k != 3; ++k)
+            for (int l = 0; l != 3; ++l)
+                *values++ = float(matrix_value(l, k));
+        return values;
+    };
+};
+#if !SPHINXSYS_USE_FLOAT
+template <>
+struct VtkComponents<ReducedData<Real>>
+{
+    static constexpr int value = 1;
+    static float *copy(const ReducedData<Real> &data, float *values)
+    {
+        *values = data;
+        return values + 1;
+    };
+};
+template <>
+struct VtkComponents<ReducedData<Vecd>>
+{
+    static constexpr int value = 3;
+    static float *copy(const ReducedData<Vecd> &data, float *values)
+    {
+        return VtkComponents<Vecd>::copy(precisionCast<Vecd>(data), values);
+    };
+};
+#endif
+
+/**
+ * @class VtkAppendedData
+ * @brief Collects the data arrays of a VTK XML file, version 1.0 with 64-bit headers,
+ * and writes them into its appended data section.
+ */
+class VtkAppendedData
+{
+  public:
+    /** fills the buffer with the values of the entries in [begin, end), called concurrently for different ranges */
+    template <typename OutputType>
+    using DataFiller = std::function<void(size_t, size_t, OutputType *)>;
+
+    explicit VtkAppendedData(VtkEncoding encoding) : encoding_(encoding), offset_(0){};
+    virtual ~VtkAppendedData(){};
+
+    /** attributes of the VTKFile element required by the appended data */
+    std::string FileAttributes();
+    /** register an array and return its DataArray element referring to the appended data */
+    std::string addFloat32Array(const std::string &name, int number_of_components,
+                                size_t number_of_entries, const DataFiller<float> &data_filler);
+    std::string addInt32Array(const std::string &name, int number_of_components,
+                              size_t number_of_entries, const DataFiller<int> &data_filler);
+    /** the array holds the number_of_entries entries of the data starting from first_entry */
+    std::string addDataArray(const std::string &name, const StdLargeVec<int> &data,
+                             size_t number_of_entries, size_t first_entry = 0);
+    template <typename DataType>
+    std::string addDataArray(const std::string &name, const StdLargeVec<DataType> &data,
+                             size_t number_of_entries, size_t first_entry = 0)
+    {
+        const DataType *data_ptr = data.data() + first_entry;
+        return addFloat32Array(name, VtkComponents<DataType>::value, number_of_entries,
+                               [data_ptr](size_t begin, size_t end, float *values)
+                               {
+                                   for (size_t i = begin; i != end; ++i)
+                                       values = VtkComponents<DataType>::copy(data_ptr[i], values);
+                               });
+    };
+    /** register the particle IDs and the listed variables of the particles in [first_particle, first_particle + number_of_particles) */
+    std::string addParticleVariables(size_t first_particle, size_t number_of_particles,
+                                     const StdLargeVec<size_t> &original_ids, const ParticleVariables &variables);
+    /** the PDataArray elements of the parallel file referring to the pieces
+     *  for the arrays registered since the last call, which are removed afterwards */
+    std::string takeParallelDataArrays();
+    /** write the appended data section and clear the registered arrays */
+    void writeAppendedData(std::ostream &output_stream);
+
+  protected:
+    struct DataArray
+    {
+        std::string name_;
+        std::string type_;
+        int number_of_components_;
+        size_t bytes_per_entry_;
+        size_t number_of_entries_;
+        std::function<void(size_t, size_t, char *)> data_filler_;
+    };
+
+    VtkEncoding encoding_;
+    size_t offset_; /**< of the next array in the appended data */
+    StdVec<DataArray> data_arrays_;
+    const size_t entries_per_chunk_ = 3 * 8192; /**< a multiple of 3 for continuous base64 encoding */
+    const size_t chunks_per_batch_ = 32;        /**< filled in parallel before being written */
+
+    std::string addArray(const std::string &name, const std::string &type, int number_of_components,
+                         size_t number_of_entries, const std::function<void(size_t, size_t, char *)> &data_filler);
+    size_t EncodedSize(size_t number_of_bytes);
+    void writeEncoded(std::ostream &output_stream, const char *data, size_t number_of_bytes);
+};
+} // namespace SPH
+#endif // IO_VTK_BINARY_H
@@ -0,0 +1,218 @@
+/**
+ * @file 	io_xdmf.cpp
+ * @author	agent
+ */
+
+#include "io_xdmf.h"
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+namespace SPH
+{
+//=============================================================================================//
+BodyStatesRecordingToXdmf::BodyStatesRecordingToXdmf(SPHBody &body)
+    : BodyStatesRecording(body),
+      xdmf_file_path_(io_environment_.output_folder_ + "/" + body.getName() + "_states.xdmf"),
+      heavy_data_file_names_({body.getName() + "_states.bin"}), heavy_data_sizes_({0}),
+      is_series_started_(false) {}
+//=============================================================================================//
+BodyStatesRecordingToXdmf::BodyStatesRecordingToXdmf(SPHSystem &sph_system)
+    : BodyStatesRecording(sph_system),
+      xdmf_file_path_(io_environment_.output_folder_ + "/BodyStates.xdmf"), is_series_started_(false)
+{
+    for (SPHBody *body : bodies_)
+    {
+        heavy_data_file_names_.push_back(body->getName() + "_states.bin");
+        heavy_data_sizes_.push_back(0);
+    }
+}
+//=============================================================================================//
+void BodyStatesRecordingToXdmf::startSeries()
+{
+    is_series_started_ = true;
+    // after restart, the arrays are appended to those of the earlier run
+    bool is_restarted = sph_system_.RestartStep() != 0;
+    for (size_t k = 0; k != heavy_data_file_names_.size(); ++k)
+    {
+        std::string heavy_data_file_path = io_environment_.output_folder_ + "/" + heavy_data_file_names_[k];
+        heavy_data_sizes_[k] = is_restarted && fs::exists(heavy_data_file_path) ? fs::file_size(heavy_data_file_path) : 0;
+        if (heavy_data_sizes_[k] == 0)
+        {
+            std::ofstream heavy_data_file(heavy_data_file_path.c_str(), std::ios::binary | std::ios::trunc);
+        }
+    }
+
+    // and the time steps to the index of the earlier run if it is complete
+    std::ifstream in_file(xdmf_file_path_.c_str(), std::ios::binary);
+    std::string closing_tags(xdmf_closing_tags_.size(), ' ');
+    if (is_restarted && in_file.seekg(-std::streamoff(closing_tags.size()), std::ios::end) &&
+        in_file.read(&closing_tags[0], closing_tags.size()) && closing_tags == xdmf_closing_tags_)
+    {
+        return;
+    }
+    in_file.close();
+
+    std::ofstream out_file(xdmf_file_path_.c_str(), std::ios::trunc);
+    out_file << "<?xml version=\"1.0\" ?>\n";
+    out_file << "<Xdmf Version=\"3.0\">\n";
+    out_file << " <Domain>\n";
+    out_file << "  <Grid Name=\"TimeSeries\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+    out_file << xdmf_closing_tags_;
+    out_file.close();
+}
+//=============================================================================================//
+std::string BodyStatesRecordingToXdmf::
+    appendDataItem(size_t body_index, std::ofstream &heavy_data_file, const std::string &number_type,
+                   int number_of_components, size_t number_of_entries,
+                   const std::function<void(size_t, size_t, char *)> &data_filler)
+{
+    std::stringstream data_item;
+    data_item << "      <DataItem Format=\"Binary\" NumberType=\"" << number_type
+              << "\" Precision=\"4\" Endian=\"Little\" Seek=\"" << heavy_data_sizes_[body_index]
+              << "\" Dimensions=\"" << number_of_entries;
+    if (number_of_components != 1)
+    {
+        data_item << " " << number_of_components;
+    }
+    data_item << "\">" << heavy_data_file_names_[body_index] << "</DataItem>\n";
+
+    size_t bytes_per_entry = 4 * number_of_components;
+    StdVec<char> buffer(bytes_per_entry * entries_per_chunk_);
+    for (size_t begin = 0; begin < number_of_entries; begin += entries_per_chunk_)
+    {
+        size_t end = SMIN(begin + entries_per_chunk_, number_of_entries);
+        data_filler(begin, end, buffer.data());
+        heavy_data_file.write(buffer.data(), bytes_per_entry * (end - begin));
+    }
+    heavy_data_sizes_[body_index] += bytes_per_entry * number_of_entries;
+    return data_item.str();
+}
+//=============================================================================================//
+template <typename DataType>
+std::string BodyStatesRecordingToXdmf::
+    appendAttributes(size_t body_index, std::ofstream &heavy_data_file,
+                     const ParticleVariables &variables, size_t number_of_entries)
+{
+    std::string attributes;
+    constexpr int type_index = DataTypeIndex<DataType>::value;
+    for (DiscreteVariable<DataType> *variable : std::get<type_index>(variables))
+    {
+        StdLargeVec<DataType> *data = variable->DataField();
+        int number_of_components = VtkComponents<DataType>::value;
+        std::string attribute_type = number_of_components == 1 ? "Scalar" : (number_of_components == 3 ? "Vector" : "Tensor");
+        attributes += "     <Attribute Name=\"" + variable->Name() + "\" AttributeType=\"" +
+                      attribute_type + "\" Center=\"Node\">\n";
+        attributes += appendDataItem(body_index, heavy_data_file, "Float", number_of_components, number_of_entries,
+                                     [data](size_t begin, size_t end, char *buffer)
+                                     {
+                                         float *values = reinterpret_cast<float *>(buffer);
+                                         for (size_t i = begin; i != end; ++i)
+                                             values = VtkComponents<DataType>::copy((*data)[i], values);
+                                     });
+        attributes += "     </Attribute>\n";
+    }
+    return attributes;
+}
+//=============================================================================================//
+template <>
+std::string BodyStatesRecordingToXdmf::
+    appendAttributes<int>(size_t body_index, std::ofstream &heavy_data_file,
+                          const ParticleVariables &variables, size_t number_of_entries)
+{
+    std::string attributes;
+    constexpr int type_index = DataTypeIndex<int>::value;
+    for (DiscreteVariable<int> *variable : std::get<type_index>(variables))
+    {
+        StdLargeVec<int> *data = variable->DataField();
+        attributes += "     <Attribute Name=\"" + variable->Name() + "\" AttributeType=\"Scalar\" Center=\"Node\">\n";
+        attributes += appendDataItem(body_index, heavy_data_file, "Int", 1, number_of_entries,
+                                     [data](size_t begin, size_t end, char *buffer)
+                                     { std::copy(data->begin() + begin, data->begin() + end, reinterpret_cast<int *>(buffer)); });
+        attributes += "     </Attribute>\n";
+    }
+    return attributes;
+}
+//=============================================================================================//
+void BodyStatesRecordingToXdmf::writeWithFileName(const std::string &sequence)
+{
+    if (!is_series_started_)
+    {
+        startSeries();
+    }
+
+    std::stringstream time_step_grid;
+    time_step_grid << "   <Grid Name=\"Step_" << sequence << "\" GridType=\"Collection\" CollectionType=\"Spatial\">\n";
+    time_step_grid << "    <Time Value=\"" << std::setprecision(9) << GlobalStaticVariables::physical_time_ << "\"/>\n";
+
+    bool is_any_body_written = false;
+    for (size_t k = 0; k != bodies_.size(); ++k)
+    {
+        SPHBody *body = bodies_[k];
+        if (body->checkNewlyUpdated() && state_recording_)
+        {
+            is_any_body_written = true;
+            BaseParticles &base_particles = body->getBaseParticles();
+            size_t total_real_particles = base_particles.TotalRealParticles();
+            std::string heavy_data_file_path = io_environment_.output_folder_ + "/" + heavy_data_file_names_[k];
+            std::ofstream heavy_data_file(heavy_data_file_path.c_str(), std::ios::binary | std::ios::app);
+
+            time_step_grid << "    <Grid Name=\"" << body->getName() << "\" GridType=\"Uniform\">\n";
+            time_step_grid << "     <Topology TopologyType=\"Polyvertex\" NumberOfElements=\"" << total_real_particles
+                           << "\" NodesPerElement=\"1\"/>\n";
+
+            // the positions in 2D are padded by zero as in VTK output
+            StdLargeVec<Vecd> *positions = &base_particles.ParticlePositions();
+            time_step_grid << "     <Geometry GeometryType=\"XYZ\">\n";
+            time_step_grid << appendDataItem(k, heavy_data_file, "Float", 3, total_real_particles,
+                                             [positions](size_t begin, size_t end, char *buffer)
+                                             {
+                                                 float *values = reinterpret_cast<float *>(buffer);
+                                                 for (size_t i = begin; i != end; ++i)
+                                                     values = VtkComponents<Vecd>::copy((*positions)[i], values);
+                                             });
+            time_step_grid << "     </Geometry>\n";
+
+            StdLargeVec<size_t> *original_ids = &base_particles.ParticleOriginalIds();
+            time_step_grid << "     <Attribute Name=\"OriginalParticle_ID\" AttributeType=\"Scalar\" Center=\"Node\">\n";
+            time_step_grid << appendDataItem(k, heavy_data_file, "Int", 1, total_real_particles,
+                                             [original_ids](size_t begin, size_t end, char *buffer)
+                                             {
+                                                 int *values = reinterpret_cast<int *>(buffer);
+                                                 for (size_t i = begin; i != end; ++i)
+                                                     *values++ = int((*original_ids)[i]);
+                                             });
+            time_step_grid << "     </Attribute>\n";
+
+            const ParticleVariables &variables = base_particles.getVariablesToWrite();
+            time_step_grid << appendAttributes<int>(k, heavy_data_file, variables, total_real_particles);
+            time_step_grid << appendAttributes<Real>(k, heavy_data_file, variables, total_real_particles);
+            time_step_grid << appendAttributes<Vecd>(k, heavy_data_file, variables, total_real_particles);
+#if !SPHINXSYS_USE_FLOAT
+            time_step_grid << appendAttributes<ReducedData<Real>>(k, heavy_data_file, variables, total_real_particles);
+            time_step_grid << appendAttributes<ReducedData<Vecd>>(k, heavy_data_file, variables, total_real_particles);
+#endif
+            time_step_grid << appendAttributes<Matd>(k, heavy_data_file, variables, total_real_particles);
+            time_step_grid << "    </Grid>\n";
+            heavy_data_file.close();
+        }
+        body->setNotNewlyUpdated();
+    }
+    time_step_grid << "   </Grid>\n";
+
+    if (is_any_body_written)
+    {
+        appendToXdmfFile(time_step_grid.str());
+    }
+}
+//=============================================================================================//
+void BodyStatesRecordingToXdmf::appendToXdmfFile(const std::string &time_step_grid)
+{
+    // the new grid overwrites the closing tags, which are written again after it
+    std::fstream out_file(xdmf_file_path_.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    out_file.seekp(-std::streamoff(xdmf_closing_tags_.size()), std::ios::end);
+    out_file << time_step_grid << xdmf_closing_tags_;
+    out_file.close();
+}
+//=============================================================================================//
+} // namespace SPH
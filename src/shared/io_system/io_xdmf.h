@@ -0,0 +1,74 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_xdmf.h
+ * @brief 	Classes for writing body states as XDMF with raw binary heavy data.
+ * @author	agent
+ */
+
+#ifndef IO_XDMF_H
+#define IO_XDMF_H
+
+#include "io_base.h"
+#include "io_vtk_binary.h"
+
+namespace SPH
+{
+/**
+ * @class BodyStatesRecordingToXdmf
+ * @brief Write the body states of all time steps into one appendable binary container for each body,
+ * which holds the raw little-endian arrays, and a single XDMF file indexing all time steps.
+ * Visualization tools read the arrays at their offsets without parsing, and no HDF5 is required.
+ * The grid of each time step is appended to the index before its closing tags,
+ * which are rewritten so that the index is always complete.
+ * A restarted run appends to the containers and the index of the earlier run.
+ */
+class BodyStatesRecordingToXdmf : public BodyStatesRecording
+{
+  public:
+    BodyStatesRecordingToXdmf(SPHBody &body);
+    BodyStatesRecordingToXdmf(SPHSystem &sph_system);
+    virtual ~BodyStatesRecordingToXdmf(){};
+
+  protected:
+    std::string xdmf_file_path_;
+    StdVec<std::string> heavy_data_file_names_; /**< of the binary container of each body */
+    StdVec<size_t> heavy_data_sizes_;           /**< i.e. the offsets of the next array in the containers */
+    bool is_series_started_;                    /**< the containers and the index are opened by this run */
+    const size_t entries_per_chunk_ = 8192;
+    const std::string xdmf_closing_tags_ = "  </Grid>\n </Domain>\n</Xdmf>\n";
+
+    virtual void writeWithFileName(const std::string &sequence) override;
+    /** start a new series, or continue the series of the earlier run after restart */
+    void startSeries();
+    void appendToXdmfFile(const std::string &time_step_grid);
+    /** append the array to the container and return the DataItem element referring to it */
+    std::string appendDataItem(size_t body_index, std::ofstream &heavy_data_file, const std::string &number_type,
+                               int number_of_components, size_t number_of_entries,
+                               const std::function<void(size_t, size_t, char *)> &data_filler);
+    template <typename DataType>
+    std::string appendAttributes(size_t body_index, std::ofstream &heavy_data_file,
+                                 const ParticleVariables &variables, size_t number_of_entries);
+};
+} // namespace SPH
+#endif // IO_XDMF_H
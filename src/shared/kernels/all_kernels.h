@@ -29,10 +29,12 @@
 #ifndef ALL_KERNELS_H
 #define ALL_KERNELS_H
 
+#include "inlined_kernel.h"
 #include "kernel_cubic_B_spline.h"
 #include "kernel_hyperbolic.h"
 #include "kernel_laguerre_gauss.h"
 #include "kernel_tabulated.h"
+#include "kernel_tabulated_squared.h"
 #include "kernel_wenland_c2.h"
 #include "anisotropic_kernel.hpp"
  
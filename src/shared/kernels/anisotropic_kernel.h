@@ -88,6 +88,15 @@ class AnisotropicKernel : public KernelType
         this->factor_d2W_3D_ = this->factor_W_3D_;
     };
 
+    /** The coordinate transformation tensor for the dimension of the build. **/
+    Matd TransformedTensor() const
+    {
+        if constexpr (Dimensions == 2)
+            return transformed_tensor_2d_;
+        else
+            return transformed_tensor_3d_;
+    };
+
     /** Calculates the transform tensor form anisotropic space to isotropic space **/
     Mat2d getCoordinateTransformationTensorG(Vec2d kernel_vector, Vec2d transform_vector);
     Mat3d getCoordinateTransformationTensorG(Vec3d kernel_vector, Vec3d transform_vector);
@@ -125,6 +134,9 @@ class AnisotropicKernel : public KernelType
     virtual Real d2W(const Real &r_ij, const Vec2d &displacement) const override;
     virtual Real d2W(const Real &r_ij, const Vec3d &displacement) const override;
 
+    /** Not available, as the anisotropic kernel depends on the displacement, not only on the distance. */
+    virtual void evaluateBatch(const Real *r_sqr, size_t size, Real *W, Real *dW) const override;
+
     virtual ~AnisotropicKernel(){};
 };
 
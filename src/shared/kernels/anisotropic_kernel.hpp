@@ -137,5 +137,14 @@ Real AnisotropicKernel<KernelType>::d2W(const Real &r_ij, const Vec3d &displacem
     return this->factor_d2W_3D_ * derivate_parameter3D_ * derivate_parameter3D_ * this->d2W_3D(q);
 }
 //=========================================================================================//
+template <class KernelType>
+void AnisotropicKernel<KernelType>::evaluateBatch(const Real *r_sqr, size_t size, Real *W, Real *dW) const
+{
+    std::cout << "\n Error: the anisotropic kernel " << this->kernel_name_
+              << " can not be evaluated from squared distances, please use W and dW with displacements!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=========================================================================================//
 } // namespace SPH
 #endif
@@ -79,6 +79,7 @@ class Kernel
     std::string Name() const { return kernel_name_; };
     void resetSmoothingLength(Real h);
     Real SmoothingLength() const { return h_; };
+    Real InverseSmoothingLength() const { return inv_h_; };
     /**< non-dimensional size of the kernel, generally 2.0 **/
     Real KernelSize() const { return kernel_size_; };
     Real Truncation() const { return truncation_; };
@@ -87,6 +88,9 @@ class Kernel
     Real FactorW1D() const { return factor_W_1D_; };
     Real FactorW2D() const { return factor_W_2D_; };
     Real FactorW3D() const { return factor_W_3D_; };
+    Real FactordW1D() const { return factor_dW_1D_; };
+    Real FactordW2D() const { return factor_dW_2D_; };
+    Real FactordW3D() const { return factor_dW_3D_; };
     
     /**
      * unit vector pointing from j to i or inter-particle surface direction
@@ -170,21 +174,19 @@ class Kernel
     //		to the variable smoothing length.
     //----------------------------------------------------------------------
   protected:
-    /** Functor for variable smoothing length. */
-    typedef std::function<Real(const Real &)> FactorFunctor;
-    FactorFunctor h_factor_W_1D_, h_factor_W_2D_, h_factor_W_3D_;
-    FactorFunctor h_factor_dW_1D_, h_factor_dW_2D_, h_factor_dW_3D_;
-    FactorFunctor h_factor_d2W_1D_, h_factor_d2W_2D_, h_factor_d2W_3D_;
-
-    Real factorW1D(const Real &h_ratio) const { return h_ratio; };
-    Real factorW2D(const Real &h_ratio) const { return h_ratio * h_ratio; };
-    Real factorW3D(const Real &h_ratio) const { return h_ratio * h_ratio * h_ratio; };
-    Real factordW1D(const Real &h_ratio) const { return factorW1D(h_ratio) * h_ratio; };
-    Real factordW2D(const Real &h_ratio) const { return factorW2D(h_ratio) * h_ratio; };
-    Real factordW3D(const Real &h_ratio) const { return factorW3D(h_ratio) * h_ratio; };
-    Real factord2W1D(const Real &h_ratio) const { return factordW1D(h_ratio) * h_ratio; };
-    Real factord2W2D(const Real &h_ratio) const { return factordW2D(h_ratio) * h_ratio; };
-    Real factord2W3D(const Real &h_ratio) const { return factordW3D(h_ratio) * h_ratio; };
+    /** Dimensions of the smoothing length factors, which are lowered for reduced kernels.
+     *  Plain integers, instead of function objects, keep the factors inlined. */
+    int h_dimension_1D_, h_dimension_2D_, h_dimension_3D_;
+
+    Real factorW(const Real &h_ratio, int dimension) const
+    {
+        Real factor = h_ratio;
+        for (int i = 1; i < dimension; ++i)
+            factor *= h_ratio;
+        return factor;
+    };
+    Real factordW(const Real &h_ratio, int dimension) const { return factorW(h_ratio, dimension) * h_ratio; };
+    Real factord2W(const Real &h_ratio, int dimension) const { return factordW(h_ratio, dimension) * h_ratio; };
 
   public:
     Real CutOffRadius(Real h_ratio) const { return rc_ref_ / h_ratio; };
@@ -209,6 +211,18 @@ class Kernel
     Real d2W(const Real &h_ratio, const Real &r_ij, const Vec2d &displacement) const;
     Real d2W(const Real &h_ratio, const Real &r_ij, const Vec3d &displacement) const;
     //----------------------------------------------------------------------
+    //		Below are for batched evaluation in the build dimension.
+    //----------------------------------------------------------------------
+  protected:
+    using RealArray = Eigen::Array<Real, Eigen::Dynamic, 1>;
+
+  public:
+    Real FactorW() const { return Dimensions == 2 ? factor_W_2D_ : factor_W_3D_; };
+    Real FactordW() const { return Dimensions == 2 ? factor_dW_2D_ : factor_dW_3D_; };
+    /** Kernel values and derivatives for contiguous squared distances, zero beyond the cut-off radius.
+     *  The default evaluates pair by pair, while specific kernels use vectorized array expressions. */
+    virtual void evaluateBatch(const Real *r_sqr, size_t size, Real *W, Real *dW) const;
+    //----------------------------------------------------------------------
     //		Below are for reduced kernels.
     //----------------------------------------------------------------------
   public:
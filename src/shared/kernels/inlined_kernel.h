@@ -0,0 +1,184 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	inlined_kernel.h
+ * @brief 	Statically dispatched kernel evaluation for the hot loops,
+ * 			such as neighbor building, on a concrete kernel type.
+ * @details	The kernel functions of Kernel are virtual, and are called several times
+ * 			per particle pair when the configuration is updated.
+ * 			InlinedKernel evaluates a concrete kernel with its inlined shape functions.
+ * 			Anisotropic kernels read their transformation tensors from the kernel.
+ * 			The generic InlinedKernel<Kernel> forwards to the virtual functions
+ * 			and is the fallback for user-defined and other derived kernels.
+ * 			DispatchedKernel chooses among them once, according to the exact kernel type.
+ * @author	agent
+ */
+
+#ifndef INLINED_KERNEL_H
+#define INLINED_KERNEL_H
+
+#include "anisotropic_kernel.h"
+#include "kernel_cubic_B_spline.h"
+#include "kernel_wenland_c2.h"
+
+#include <typeinfo>
+#include <variant>
+
+namespace SPH
+{
+/**
+ * @class InlinedKernel
+ * @brief Kernel evaluation without virtual calls.
+ * The kernel type provides the static shape functions shapeW and shapedW.
+ * The factors are read from the kernel so that reduced kernels are also handled.
+ */
+template <class KernelType>
+class InlinedKernel
+{
+    const KernelType *kernel_;
+
+  public:
+    explicit InlinedKernel(const KernelType &kernel) : kernel_(&kernel){};
+
+    Real CutOffRadiusSqr() const { return kernel_->CutOffRadiusSqr(); };
+    bool checkIfWithinCutOffRadius(const Vecd &displacement) const
+    {
+        return displacement.squaredNorm() < kernel_->CutOffRadiusSqr();
+    };
+    Real W(const Real &r_ij, const Vec2d &displacement) const
+    {
+        return kernel_->FactorW2D() * KernelType::shapeW(r_ij * kernel_->InverseSmoothingLength());
+    };
+    Real W(const Real &r_ij, const Vec3d &displacement) const
+    {
+        return kernel_->FactorW3D() * KernelType::shapeW(r_ij * kernel_->InverseSmoothingLength());
+    };
+    Real dW(const Real &r_ij, const Vec2d &displacement) const
+    {
+        return kernel_->FactordW2D() * KernelType::shapedW(r_ij * kernel_->InverseSmoothingLength());
+    };
+    Real dW(const Real &r_ij, const Vec3d &displacement) const
+    {
+        return kernel_->FactordW3D() * KernelType::shapedW(r_ij * kernel_->InverseSmoothingLength());
+    };
+    Vecd e(const Real &distance, const Vecd &displacement) const
+    {
+        return displacement / (distance + TinyReal);
+    };
+};
+
+/**
+ * @class InlinedKernel<AnisotropicKernel<KernelType>>
+ * @brief Anisotropic kernel evaluation without virtual calls.
+ * The transformation tensor, the smoothing length and the factors are read from the kernel,
+ * so that resetting the kernel is followed.
+ * The evaluation follows AnisotropicKernel, i.e. q = |G r| and e = G (h G r) / |h G r|,
+ * and evaluatePair transforms the displacement only once for W, dW and e,
+ * which agrees with the separate evaluations up to round-off.
+ */
+template <class KernelType>
+class InlinedKernel<AnisotropicKernel<KernelType>>
+{
+    const AnisotropicKernel<KernelType> *kernel_;
+
+  public:
+    explicit InlinedKernel(const AnisotropicKernel<KernelType> &kernel) : kernel_(&kernel){};
+
+    Real CutOffRadiusSqr() const { return kernel_->CutOffRadiusSqr(); };
+    bool checkIfWithinCutOffRadius(const Vecd &displacement) const
+    {
+        Vecd transformed_displacement = kernel_->SmoothingLength() * kernel_->TransformedTensor() * displacement;
+        return transformed_displacement.squaredNorm() < kernel_->CutOffRadiusSqr();
+    };
+    Real W(const Real &r_ij, const Vecd &displacement) const
+    {
+        return kernel_->FactorW() * KernelType::shapeW((kernel_->TransformedTensor() * displacement).norm());
+    };
+    Real dW(const Real &r_ij, const Vecd &displacement) const
+    {
+        return kernel_->FactordW() * KernelType::shapedW((kernel_->TransformedTensor() * displacement).norm());
+    };
+    Vecd e(const Real &distance, const Vecd &displacement) const
+    {
+        Matd transformed_tensor = kernel_->TransformedTensor();
+        Vecd transformed_displacement = kernel_->SmoothingLength() * transformed_tensor * displacement;
+        return transformed_tensor * transformed_displacement / (transformed_displacement.norm() + TinyReal);
+    };
+    void evaluatePair(const Vecd &displacement, Real &W_ij, Real &dW_ij, Vecd &e_ij) const
+    {
+        Matd transformed_tensor = kernel_->TransformedTensor();
+        Vecd transformed_displacement = transformed_tensor * displacement;
+        Real q = transformed_displacement.norm();
+        W_ij = kernel_->FactorW() * KernelType::shapeW(q);
+        dW_ij = kernel_->FactordW() * KernelType::shapedW(q);
+        Vecd scaled_displacement = kernel_->SmoothingLength() * transformed_displacement;
+        e_ij = transformed_tensor * scaled_displacement / (scaled_displacement.norm() + TinyReal);
+    };
+};
+
+/**
+ * @class InlinedKernel<Kernel>
+ * @brief Fallback with virtual calls for any kernel.
+ */
+template <>
+class InlinedKernel<Kernel>
+{
+    Kernel *kernel_;
+
+  public:
+    explicit InlinedKernel(Kernel &kernel) : kernel_(&kernel){};
+
+    Real CutOffRadiusSqr() const { return kernel_->CutOffRadiusSqr(); };
+    bool checkIfWithinCutOffRadius(const Vecd &displacement) const
+    {
+        return kernel_->checkIfWithinCutOffRadius(displacement);
+    };
+    Real W(const Real &r_ij, const Vecd &displacement) const { return kernel_->W(r_ij, displacement); };
+    Real dW(const Real &r_ij, const Vecd &displacement) const { return kernel_->dW(r_ij, displacement); };
+    Vecd e(const Real &distance, const Vecd &displacement) const { return kernel_->e(distance, displacement); };
+};
+
+/** The kernels with statically dispatched evaluation and the generic fallback. */
+using DispatchedKernel = std::variant<InlinedKernel<KernelWendlandC2>,
+                                      InlinedKernel<KernelCubicBSpline>,
+                                      InlinedKernel<AnisotropicKernel<KernelWendlandC2>>,
+                                      InlinedKernel<AnisotropicKernel<KernelCubicBSpline>>,
+                                      InlinedKernel<Kernel>>;
+
+/** Only the exact kernel types are dispatched statically, as derived kernels may override the evaluation. */
+inline DispatchedKernel dispatchKernel(Kernel &kernel)
+{
+    if (typeid(kernel) == typeid(KernelWendlandC2))
+        return InlinedKernel<KernelWendlandC2>(static_cast<const KernelWendlandC2 &>(kernel));
+    if (typeid(kernel) == typeid(KernelCubicBSpline))
+        return InlinedKernel<KernelCubicBSpline>(static_cast<const KernelCubicBSpline &>(kernel));
+    if (typeid(kernel) == typeid(AnisotropicKernel<KernelWendlandC2>))
+        return InlinedKernel<AnisotropicKernel<KernelWendlandC2>>(
+            static_cast<const AnisotropicKernel<KernelWendlandC2> &>(kernel));
+    if (typeid(kernel) == typeid(AnisotropicKernel<KernelCubicBSpline>))
+        return InlinedKernel<AnisotropicKernel<KernelCubicBSpline>>(
+            static_cast<const AnisotropicKernel<KernelCubicBSpline> &>(kernel));
+    return InlinedKernel<Kernel>(kernel);
+}
+} // namespace SPH
+#endif // INLINED_KERNEL_H
@@ -16,14 +16,7 @@ KernelCubicBSpline::KernelCubicBSpline(Real h)
 //=================================================================================================//
 Real KernelCubicBSpline::W_1D(const Real q) const
 {
-    if (q < 1.0)
-    {
-        return (1.0 - 3.0 * pow(q, 2) * (1.0 - q / 2.0) / 2.0);
-    }
-    else
-    {
-        return pow(2.0 - q, 3) / 4.0;
-    }
+    return shapeW(q);
 }
 //=================================================================================================//
 Real KernelCubicBSpline::W_2D(const Real q) const
@@ -38,14 +31,7 @@ Real KernelCubicBSpline::W_3D(const Real q) const
 //=================================================================================================//
 Real KernelCubicBSpline::dW_1D(const Real q) const
 {
-    if (q < 1.0)
-    {
-        return (9.0 * pow(q, 2) / 4.0 - 3.0 * q);
-    }
-    else
-    {
-        return (-1.0) * 3.0 * pow(2.0 - q, 2) / 4.0;
-    }
+    return shapedW(q);
 }
 //=================================================================================================//
 Real KernelCubicBSpline::dW_2D(const Real q) const
@@ -60,14 +46,7 @@ Real KernelCubicBSpline::dW_3D(const Real q) const
 //=================================================================================================//
 Real KernelCubicBSpline::d2W_1D(const Real q) const
 {
-    if (q < 1.0)
-    {
-        return 9.0 * q / 2.0 - 3.0;
-    }
-    else
-    {
-        return 3.0 * (2.0 - q) / 2.0;
-    }
+    return shaped2W(q);
 }
 //=================================================================================================//
 Real KernelCubicBSpline::d2W_2D(const Real q) const
@@ -80,4 +59,19 @@ Real KernelCubicBSpline::d2W_3D(const Real q) const
     return d2W_2D(q);
 }
 //=================================================================================================//
+void KernelCubicBSpline::evaluateBatch(const Real *r_sqr, size_t size, Real *W, Real *dW) const
+{
+    Eigen::Map<const RealArray> r_sqr_array(r_sqr, size);
+    Eigen::Map<RealArray> W_array(W, size), dW_array(dW, size);
+    W_array = r_sqr_array.sqrt() * inv_h_; // normalized distance q
+    dW_array = (r_sqr_array < rc_ref_sqr_)
+                   .select(FactordW() * (W_array < 1.0).select(2.25 * W_array.square() - 3.0 * W_array,
+                                                              -0.75 * (2.0 - W_array).square()),
+                           0.0);
+    W_array = (r_sqr_array < rc_ref_sqr_)
+                  .select(FactorW() * (W_array < 1.0).select(1.0 - 1.5 * W_array.square() * (1.0 - 0.5 * W_array),
+                                                             0.25 * (2.0 - W_array).cube()),
+                          0.0);
+}
+//=================================================================================================//
 } // namespace SPH
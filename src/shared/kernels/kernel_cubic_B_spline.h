@@ -31,6 +31,8 @@
 
 #include "base_kernel.h"
 
+#include <cmath>
+
 namespace SPH
 {
 /**
@@ -57,6 +59,23 @@ class KernelCubicBSpline : public Kernel
     virtual Real d2W_1D(const Real q) const override;
     virtual Real d2W_2D(const Real q) const override;
     virtual Real d2W_3D(const Real q) const override;
+
+    /** Shape functions, identical for all dimensions, inlined for InlinedKernel. */
+    static Real shapeW(const Real q)
+    {
+        return q < 1.0 ? (1.0 - 3.0 * pow(q, 2) * (1.0 - q / 2.0) / 2.0) : pow(2.0 - q, 3) / 4.0;
+    };
+    static Real shapedW(const Real q)
+    {
+        return q < 1.0 ? (9.0 * pow(q, 2) / 4.0 - 3.0 * q) : (-1.0) * 3.0 * pow(2.0 - q, 2) / 4.0;
+    };
+    static Real shaped2W(const Real q)
+    {
+        return q < 1.0 ? 9.0 * q / 2.0 - 3.0 : 3.0 * (2.0 - q) / 2.0;
+    };
+
+    /** vectorized with Eigen array expressions */
+    virtual void evaluateBatch(const Real *r_sqr, size_t size, Real *W, Real *dW) const override;
 };
 } // namespace SPH
 #endif // KERNEL_CUBIC_B_SPLINE_H
\ No newline at end of file
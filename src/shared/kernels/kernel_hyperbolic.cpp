@@ -80,4 +80,19 @@ Real KernelHyperbolic::d2W_3D(const Real q) const
     return d2W_1D(q);
 }
 //=================================================================================================//
+void KernelHyperbolic::evaluateBatch(const Real *r_sqr, size_t size, Real *W, Real *dW) const
+{
+    Eigen::Map<const RealArray> r_sqr_array(r_sqr, size);
+    Eigen::Map<RealArray> W_array(W, size), dW_array(dW, size);
+    W_array = r_sqr_array.sqrt() * inv_h_; // normalized distance q
+    dW_array = (r_sqr_array < rc_ref_sqr_)
+                   .select(FactordW() * (W_array < 1.0).select(-6.0 + 3.0 * W_array.square(),
+                                                              -(2.0 - W_array).square()),
+                           0.0);
+    W_array = (r_sqr_array < rc_ref_sqr_)
+                  .select(FactorW() * (W_array < 1.0).select(6.0 - 6.0 * W_array + W_array.cube(),
+                                                             (2.0 - W_array).cube()),
+                          0.0);
+}
+//=================================================================================================//
 } // namespace SPH
@@ -57,6 +57,9 @@ class KernelHyperbolic : public Kernel
     virtual Real d2W_1D(const Real q) const override;
     virtual Real d2W_2D(const Real q) const override;
     virtual Real d2W_3D(const Real q) const override;
+
+    /** vectorized with Eigen array expressions */
+    virtual void evaluateBatch(const Real *r_sqr, size_t size, Real *W, Real *dW) const override;
 };
 } // namespace SPH
 
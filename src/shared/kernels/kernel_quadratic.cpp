@@ -73,4 +73,24 @@ Real KernelQuadratic::d2W_3D(const Real q) const
     return 15.0 / 32.0;
 }
 //=================================================================================================//
+void KernelQuadratic::evaluateBatch(const Real *r_sqr, size_t size, Real *W, Real *dW) const
+{
+    Eigen::Map<const RealArray> r_sqr_array(r_sqr, size);
+    Eigen::Map<RealArray> W_array(W, size), dW_array(dW, size);
+    W_array = r_sqr_array.sqrt() * inv_h_; // normalized distance q
+    if (Dimensions == 3)
+    {
+        dW_array = (r_sqr_array < rc_ref_sqr_).select(FactordW() * 15.0 * (W_array - 2.0) / 32.0, 0.0);
+    }
+    else
+    {
+        dW_array = (r_sqr_array < rc_ref_sqr_)
+                       .select(FactordW() * (W_array < 1.0).select(-6.0 + 3.0 * W_array.square(),
+                                                                  -(2.0 - W_array).square()),
+                               0.0);
+    }
+    W_array = (r_sqr_array < rc_ref_sqr_)
+                  .select(FactorW() * 5.0 * (3.0 * W_array.square() - 12.0 * W_array + 12.0) / 64.0, 0.0);
+}
+//=================================================================================================//
 } // namespace SPH
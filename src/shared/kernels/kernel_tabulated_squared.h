@@ -0,0 +1,152 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	kernel_tabulated_squared.h
+ * @brief 	Tabulated kernels indexed by the squared normalized distance.
+ * @details	A neighbor candidate only needs the squared distance for the cut-off test,
+ * 			kernel value and derivative divided by distance, i.e. dW/r.
+ * 			Both are interpolated from the tables sampled at uniform r^2/h^2
+ * 			with one computation of the interpolation stencil,
+ * 			so that no square root is required.
+ * 			Only very close to the origin, where the half powers of r^2/h^2
+ * 			spoil the interpolation, the original kernel is evaluated.
+ * 			The tables are for the build dimension.
+ * @author	agent
+ */
+
+#ifndef KERNEL_TABULATED_SQUARED_H
+#define KERNEL_TABULATED_SQUARED_H
+
+#include "base_kernel.h"
+
+#include <cmath>
+
+namespace SPH
+{
+template <class KernelType>
+class KernelTabulatedSquared : public Kernel
+{
+  protected:
+    KernelType original_kernel_;
+    int kernel_resolution_;
+    Real ds_, inv_ds_;                 /**< spacing of the normalized squared distance */
+    StdVec<Real> w_, dw_over_q_;       /**< kernel shape and its derivative divided by q */
+    Real factor_W_, factor_dW_over_r_; /**< normalization factors of the build dimension */
+    Real s_analytic_;                  /**< below which the original kernel is evaluated */
+
+    Real shapeW(Real q) const { return Dimensions == 2 ? original_kernel_.W_2D(q) : original_kernel_.W_3D(q); };
+    Real shapedW(Real q) const { return Dimensions == 2 ? original_kernel_.dW_2D(q) : original_kernel_.dW_3D(q); };
+
+    /** Four-point Lagrangian interpolation, the stencil is kept within the table. */
+    void interpolationStencil(Real s, int &base, Real (&weights)[4]) const
+    {
+        int location = (int)floor(s * inv_ds_);
+        base = SMAX(0, SMIN(location - 1, kernel_resolution_ - 3));
+        Real t = s * inv_ds_ - Real(base);
+        weights[0] = -(t - 1.0) * (t - 2.0) * (t - 3.0) / 6.0;
+        weights[1] = t * (t - 2.0) * (t - 3.0) / 2.0;
+        weights[2] = -t * (t - 1.0) * (t - 3.0) / 2.0;
+        weights[3] = t * (t - 1.0) * (t - 2.0) / 6.0;
+    };
+
+    Real interpolate(const StdVec<Real> &data, int base, const Real (&weights)[4]) const
+    {
+        return weights[0] * data[base] + weights[1] * data[base + 1] +
+               weights[2] * data[base + 2] + weights[3] * data[base + 3];
+    };
+
+  public:
+    explicit KernelTabulatedSquared(Real h, int kernel_resolution);
+
+    virtual Real W_1D(const Real q) const override { return original_kernel_.W_1D(q); };
+    virtual Real W_2D(const Real q) const override { return original_kernel_.W_2D(q); };
+    virtual Real W_3D(const Real q) const override { return original_kernel_.W_3D(q); };
+
+    virtual Real dW_1D(const Real q) const override { return original_kernel_.dW_1D(q); };
+    virtual Real dW_2D(const Real q) const override { return original_kernel_.dW_2D(q); };
+    virtual Real dW_3D(const Real q) const override { return original_kernel_.dW_3D(q); };
+
+    virtual Real d2W_1D(const Real q) const override { return original_kernel_.d2W_1D(q); };
+    virtual Real d2W_2D(const Real q) const override { return original_kernel_.d2W_2D(q); };
+    virtual Real d2W_3D(const Real q) const override { return original_kernel_.d2W_3D(q); };
+
+    /** Cut-off test, kernel value and dW/r from the squared distance with one table lookup.
+     *  Returns false, and leaves the outputs unchanged, beyond the cut-off radius. */
+    bool evaluateSquared(const Real &r_sqr, Real &W, Real &dW_over_r) const
+    {
+        if (r_sqr >= rc_ref_sqr_)
+            return false;
+
+        Real s = r_sqr * inv_h_ * inv_h_;
+        if (s < s_analytic_)
+        {
+            Real q = SMAX(std::sqrt(s), SqrtEps);
+            W = factor_W_ * shapeW(q);
+            dW_over_r = factor_dW_over_r_ * shapedW(q) / q;
+            return true;
+        }
+
+        int base;
+        Real weights[4];
+        interpolationStencil(s, base, weights);
+        W = factor_W_ * interpolate(w_, base, weights);
+        dW_over_r = factor_dW_over_r_ * interpolate(dw_over_q_, base, weights);
+        return true;
+    };
+};
+//=================================================================================================//
+template <class KernelType>
+KernelTabulatedSquared<KernelType>::KernelTabulatedSquared(Real h, int kernel_resolution)
+    : Kernel(h, 2.0, 2.0, "TabulatedSquared"), original_kernel_(h),
+      kernel_resolution_(kernel_resolution)
+{
+    kernel_name_ += original_kernel_.Name();
+    kernel_size_ = original_kernel_.KernelSize();
+    truncation_ = original_kernel_.Truncation();
+    rc_ref_ = original_kernel_.CutOffRadius();
+    rc_ref_sqr_ = original_kernel_.CutOffRadiusSqr();
+
+    factor_W_1D_ = original_kernel_.FactorW1D();
+    factor_W_2D_ = original_kernel_.FactorW2D();
+    factor_W_3D_ = original_kernel_.FactorW3D();
+
+    setDerivativeParameters();
+    factor_W_ = FactorW();
+    factor_dW_over_r_ = FactordW() * inv_h_;
+
+    ds_ = truncation_ * truncation_ / Real(kernel_resolution_);
+    inv_ds_ = 1.0 / ds_;
+    for (int i = 0; i <= kernel_resolution_; i++)
+    {
+        Real q = std::sqrt(Real(i) * ds_);
+        w_.push_back(shapeW(q));
+        // the limit of dW/q at the origin is approximated with a tiny q
+        Real q_nonzero = SMAX(q, SqrtEps);
+        dw_over_q_.push_back(shapedW(q_nonzero) / q_nonzero);
+    }
+    // odd powers of q, i.e. half powers of s, in polynomial kernels spoil the interpolation near the origin
+    s_analytic_ = 4.0 * ds_;
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // KERNEL_TABULATED_SQUARED_H
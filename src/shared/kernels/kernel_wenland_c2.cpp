@@ -16,7 +16,7 @@ KernelWendlandC2::KernelWendlandC2(Real h)
 //=================================================================================================//
 Real KernelWendlandC2::W_1D(const Real q) const
 {
-    return pow(1.0 - 0.5 * q, 4) * (1.0 + 2.0 * q);
+    return shapeW(q);
 }
 //=================================================================================================//
 Real KernelWendlandC2::W_2D(const Real q) const
@@ -31,7 +31,7 @@ Real KernelWendlandC2::W_3D(const Real q) const
 //=================================================================================================//
 Real KernelWendlandC2::dW_1D(const Real q) const
 {
-    return 0.625 * pow(q - 2.0, 3) * q;
+    return shapedW(q);
 }
 //=================================================================================================//
 Real KernelWendlandC2::dW_2D(const Real q) const
@@ -46,7 +46,7 @@ Real KernelWendlandC2::dW_3D(const Real q) const
 //=================================================================================================//
 Real KernelWendlandC2::d2W_1D(const Real q) const
 {
-    return 1.25 * pow(q - 2.0, 2) * (2.0 * q - 1.0);
+    return shaped2W(q);
 }
 //=================================================================================================//
 Real KernelWendlandC2::d2W_2D(const Real q) const
@@ -59,4 +59,13 @@ Real KernelWendlandC2::d2W_3D(const Real q) const
     return d2W_2D(q);
 }
 //=================================================================================================//
+void KernelWendlandC2::evaluateBatch(const Real *r_sqr, size_t size, Real *W, Real *dW) const
+{
+    Eigen::Map<const RealArray> r_sqr_array(r_sqr, size);
+    Eigen::Map<RealArray> W_array(W, size), dW_array(dW, size);
+    W_array = r_sqr_array.sqrt() * inv_h_; // normalized distance q
+    dW_array = (r_sqr_array < rc_ref_sqr_).select(FactordW() * 0.625 * (W_array - 2.0).cube() * W_array, 0.0);
+    W_array = (r_sqr_array < rc_ref_sqr_).select(FactorW() * (1.0 - 0.5 * W_array).square().square() * (1.0 + 2.0 * W_array), 0.0);
+}
+//=================================================================================================//
 } // namespace SPH
@@ -31,6 +31,8 @@
 
 #include "base_kernel.h"
 
+#include <cmath>
+
 namespace SPH
 {
 /**
@@ -57,6 +59,14 @@ class KernelWendlandC2 : public Kernel
     virtual Real d2W_1D(const Real q) const override;
     virtual Real d2W_2D(const Real q) const override;
     virtual Real d2W_3D(const Real q) const override;
+
+    /** Shape functions, identical for all dimensions, inlined for InlinedKernel. */
+    static Real shapeW(const Real q) { return pow(1.0 - 0.5 * q, 4) * (1.0 + 2.0 * q); };
+    static Real shapedW(const Real q) { return 0.625 * pow(q - 2.0, 3) * q; };
+    static Real shaped2W(const Real q) { return 1.25 * pow(q - 2.0, 2) * (2.0 * q - 1.0); };
+
+    /** vectorized with Eigen array expressions */
+    virtual void evaluateBatch(const Real *r_sqr, size_t size, Real *W, Real *dW) const override;
 };
 } // namespace SPH
 #endif // KERNEL_WENLAND_C2_H
\ No newline at end of file
@@ -35,6 +35,7 @@
 #define BASE_MESH_H
 
 #include "base_data_package.h"
+#include "memory_report.h"
 #include "my_memory_pool.h"
 #include "sph_data_containers.h"
 
@@ -143,6 +144,15 @@ class BaseMeshField
     std::string Name() { return name_; };
     /** output mesh data for Tecplot visualization */
     virtual void writeMeshFieldToPlt(std::ofstream &output_file) = 0;
+    /** output mesh data as binary VTK files, the extension is given by the data set type */
+    virtual void writeMeshFieldToVtk(const std::string &file_path_without_extension)
+    {
+        std::cout << "\n Error: the mesh field " << name_ << " has no VTK output!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    };
+    /** add the memory allocated and used by the mesh field to the report */
+    virtual void reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name){};
 };
 
 /**
@@ -187,6 +197,18 @@ class MultilevelMesh : public MeshFieldType
     size_t total_levels_;                    /**< level 0 is the coarsest */
     StdVec<CoarsestMeshType *> mesh_levels_; /**< Mesh in different coarse level. */
 
+    /** constructor without mesh levels, which are added by the derived class, e.g. from cached data */
+    template <typename... Args>
+    explicit MultilevelMesh(size_t total_levels, Args &&...args)
+        : MeshFieldType(std::forward<Args>(args)...), total_levels_(total_levels){};
+
+    template <typename... Args>
+    void addMeshLevel(Args &&...args)
+    {
+        mesh_levels_.push_back(
+            mesh_level_ptr_vector_keeper_.template createPtr<CoarsestMeshType>(std::forward<Args>(args)...));
+    };
+
   public:
     /** Return the mesh at different level. */
     StdVec<CoarsestMeshType *> getMeshLevels() { return mesh_levels_; };
@@ -198,6 +220,33 @@ class MultilevelMesh : public MeshFieldType
             mesh_levels_[l]->writeMeshFieldToPlt(output_file);
         }
     }
+    /** Write each mesh level to an image data file and a multi-block file collecting them. */
+    void writeMeshFieldToVtk(const std::string &file_path_without_extension) override
+    {
+        size_t file_name_begin = file_path_without_extension.find_last_of("/\\") + 1;
+        std::string file_name = file_path_without_extension.substr(file_name_begin);
+        std::ofstream out_file(file_path_without_extension + ".vtm", std::ios::trunc);
+        out_file << "<?xml version=\"1.0\"?>\n";
+        out_file << "<VTKFile type=\"vtkMultiBlockDataSet\" version=\"1.0\">\n";
+        out_file << " <vtkMultiBlockDataSet>\n";
+        for (size_t l = 0; l != total_levels_; ++l)
+        {
+            std::string level_suffix = "_level_" + std::to_string(l);
+            mesh_levels_[l]->writeMeshFieldToVtk(file_path_without_extension + level_suffix);
+            out_file << "  <DataSet index=\"" << l << "\" name=\"level_" << l
+                     << "\" file=\"" << file_name + level_suffix << ".vti\"/>\n";
+        }
+        out_file << " </vtkMultiBlockDataSet>\n";
+        out_file << "</VTKFile>\n";
+    }
+
+    void reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name) override
+    {
+        for (size_t l = 0; l != total_levels_; ++l)
+        {
+            mesh_levels_[l]->reportMemoryUsage(memory_report, owner_name);
+        }
+    }
 };
 } // namespace SPH
 #endif // BASE_MESH_H
\ No newline at end of file
@@ -53,6 +53,23 @@ void CellLinkedList ::allocateMeshDataMatrix()
     cell_data_lists_ = new ListDataVector[number_of_all_cells];
 }
 //=================================================================================================//
+void CellLinkedList::reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name)
+{
+    size_t number_of_all_cells = transferMeshIndexTo1D(all_cells_, all_cells_);
+    MemoryUsage index_lists_usage(number_of_all_cells * sizeof(ConcurrentIndexVector),
+                                  number_of_all_cells * sizeof(ConcurrentIndexVector));
+    MemoryUsage data_lists_usage(number_of_all_cells * sizeof(ListDataVector),
+                                 number_of_all_cells * sizeof(ListDataVector));
+    for (size_t i = 0; i != number_of_all_cells; ++i)
+    {
+        index_lists_usage += MemoryUsage(cell_index_lists_[i].capacity() * sizeof(size_t),
+                                         cell_index_lists_[i].size() * sizeof(size_t));
+        data_lists_usage += vectorMemoryUsage(cell_data_lists_[i]);
+    }
+    memory_report.addEntry(owner_name, "cell_linked_list", name_ + "_cell_index_lists", index_lists_usage);
+    memory_report.addEntry(owner_name, "cell_linked_list", name_ + "_cell_data_lists", data_lists_usage);
+}
+//=================================================================================================//
 void CellLinkedList ::deleteMeshDataMatrix()
 {
     delete[] cell_index_lists_;
@@ -128,6 +128,7 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
     virtual void tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) override;
     virtual void tagBoundingCells(StdVec<CellLists> &cell_data_lists, const BoundingBox &bounding_bounds, int axis) override;
     virtual void writeMeshFieldToPlt(std::ofstream &output_file) override;
+    virtual void reportMemoryUsage(MemoryReport &memory_report, const std::string &owner_name) override;
     virtual StdVec<CellLinkedList *> CellLinkedListLevels() override { return single_cell_linked_list_level_; };
 
     /** generalized particle search algorithm */
@@ -31,12 +31,14 @@
 
 #include "base_mesh.h"
 #include "base_variable.h"
+#include "cache_file.h"
 #include "my_memory_pool.h"
 
 #include <algorithm>
 #include <fstream>
 #include <functional>
 #include <mutex>
+
 using namespace std::placeholders;
 
 namespace SPH
@@ -171,6 +173,13 @@ class MeshWithGridDataPackages : public Mesh
     /** This function probe a mesh value */
     template <class DataType>
     DataType probeMesh(MeshVariable<DataType> &mesh_variable, const Vecd &position);
+    /** This function probe the mesh values at the positions of the given indices.
+     *  The probes are grouped by data packages so that the interpolation stencil of a
+     *  package is gathered once and reused by all positions within the package.
+     *  The probed values are identical to those from the single-position version. */
+    template <class DataType>
+    void probeMesh(MeshVariable<DataType> &mesh_variable, const StdLargeVec<Vecd> &positions,
+                   const IndexVector &indices, StdLargeVec<DataType> &probed_values);
     /** This function find the value of data from its index from global mesh. */
     template <typename DataType>
     DataType DataValueFromGlobalIndex(MeshVariable<DataType> &mesh_variable,
@@ -198,6 +207,144 @@ class MeshWithGridDataPackages : public Mesh
         resize_mesh_variable_data_(all_mesh_variables_, num_grid_pkgs_);
     }
 
+    /** report memory of all mesh variables with `num_grid_pkgs_` packages */
+    template <typename DataType>
+    struct ReportMeshVariableMemory
+    {
+        void operator()(MeshVariableAssemble &all_mesh_variables_, const size_t num_grid_pkgs_,
+                        MemoryReport &memory_report, const std::string &owner_name,
+                        const std::string &subsystem_name, const std::string &field_name)
+        {
+            constexpr int type_index = DataTypeIndex<DataType>::value;
+            for (size_t l = 0; l != std::get<type_index>(all_mesh_variables_).size(); ++l)
+            {
+                MeshVariable<DataType> *variable = std::get<type_index>(all_mesh_variables_)[l];
+                if (variable->DataField() != nullptr)
+                {
+                    size_t package_bytes = sizeof(typename MeshVariable<DataType>::PackageData);
+                    memory_report.addEntry(owner_name, subsystem_name, field_name + "_" + variable->Name(),
+                                           MemoryUsage(variable->AllocatedSize() * package_bytes,
+                                                       num_grid_pkgs_ * package_bytes));
+                }
+            }
+        };
+    };
+    DataAssembleOperation<ReportMeshVariableMemory> report_mesh_variable_memory_;
+
+    /** add the memory of the metadata and the mesh variables to the report */
+    void reportMeshDataMemory(MemoryReport &memory_report, const std::string &owner_name,
+                              const std::string &subsystem_name, const std::string &field_name)
+    {
+        size_t meta_data_mesh_bytes = (size_t)all_cells_.prod() * sizeof(MetaData);
+        memory_report.addEntry(owner_name, subsystem_name, field_name + "_meta_data_mesh",
+                               MemoryUsage(meta_data_mesh_bytes, meta_data_mesh_bytes));
+        size_t package_meta_data_bytes = num_grid_pkgs_ * (sizeof(CellNeighborhood) + sizeof(std::pair<Arrayi, int>));
+        memory_report.addEntry(owner_name, subsystem_name, field_name + "_package_meta_data",
+                               MemoryUsage(package_meta_data_bytes, package_meta_data_bytes));
+        report_mesh_variable_memory_(all_mesh_variables_, num_grid_pkgs_,
+                                     memory_report, owner_name, subsystem_name, field_name);
+    }
+
+    /** write the data of all mesh variables in `num_grid_pkgs_` packages to a cache file */
+    template <typename DataType>
+    struct WriteMeshVariableData
+    {
+        void operator()(MeshVariableAssemble &all_mesh_variables_, const size_t num_grid_pkgs_,
+                        CacheFileWriter &cache_file_writer)
+        {
+            constexpr int type_index = DataTypeIndex<DataType>::value;
+            for (size_t l = 0; l != std::get<type_index>(all_mesh_variables_).size(); ++l)
+            {
+                MeshVariable<DataType> *variable = std::get<type_index>(all_mesh_variables_)[l];
+                cache_file_writer.write(variable->Name());
+                cache_file_writer.writeBytes(variable->DataField(),
+                                             num_grid_pkgs_ * sizeof(typename MeshVariable<DataType>::PackageData));
+            }
+        };
+    };
+    DataAssembleOperation<WriteMeshVariableData> write_mesh_variable_data_;
+
+    /** read the data written by WriteMeshVariableData into allocated mesh variables */
+    template <typename DataType>
+    struct ReadMeshVariableData
+    {
+        void operator()(MeshVariableAssemble &all_mesh_variables_, const size_t num_grid_pkgs_,
+                        CacheFileReader &cache_file_reader)
+        {
+            constexpr int type_index = DataTypeIndex<DataType>::value;
+            for (size_t l = 0; l != std::get<type_index>(all_mesh_variables_).size(); ++l)
+            {
+                MeshVariable<DataType> *variable = std::get<type_index>(all_mesh_variables_)[l];
+                if (cache_file_reader.read<std::string>() != variable->Name())
+                {
+                    std::cout << "\n Error: mesh variable " << variable->Name()
+                              << " is not found in the cache file!" << std::endl;
+                    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                    exit(1);
+                }
+                cache_file_reader.readBytes(variable->DataField(),
+                                            num_grid_pkgs_ * sizeof(typename MeshVariable<DataType>::PackageData));
+            }
+        };
+    };
+    DataAssembleOperation<ReadMeshVariableData> read_mesh_variable_data_;
+
+    /** write the metadata of all cells and the data of all packages to a cache file */
+    void writeMeshDataToCache(CacheFileWriter &cache_file_writer)
+    {
+        size_t number_of_cells = all_cells_.prod();
+        StdLargeVec<MetaData> meta_data(number_of_cells);
+        parallel_for(
+            IndexRange(0, number_of_cells),
+            [&](const IndexRange &r)
+            {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                {
+                    Arrayi cell_index = transfer1DtoMeshIndex(all_cells_, i);
+                    int category = isCoreDataPackage(cell_index) ? 2 : (isInnerDataPackage(cell_index) ? 1 : 0);
+                    meta_data[i] = MetaData(category, PackageIndexFromCellIndex(cell_index));
+                }
+            },
+            ap);
+
+        cache_file_writer.write(all_cells_);
+        cache_file_writer.write(num_grid_pkgs_);
+        cache_file_writer.writeBytes(meta_data.data(), number_of_cells * sizeof(MetaData));
+        write_mesh_variable_data_(all_mesh_variables_, num_grid_pkgs_, cache_file_writer);
+    }
+
+    /** read the data written by writeMeshDataToCache into a mesh with the same bounds and spacing,
+     *  after which the mesh variables are allocated and filled */
+    void readMeshDataFromCache(CacheFileReader &cache_file_reader)
+    {
+        if (!(cache_file_reader.read<Arrayi>() == all_cells_).all())
+        {
+            std::cout << "\n Error: the cached mesh data do not match the mesh!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        cache_file_reader.read(num_grid_pkgs_);
+
+        size_t number_of_cells = all_cells_.prod();
+        StdLargeVec<MetaData> meta_data(number_of_cells);
+        cache_file_reader.readBytes(meta_data.data(), number_of_cells * sizeof(MetaData));
+        parallel_for(
+            IndexRange(0, number_of_cells),
+            [&](const IndexRange &r)
+            {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                {
+                    Arrayi cell_index = transfer1DtoMeshIndex(all_cells_, i);
+                    assignCategoryOnMetaDataMesh(cell_index, meta_data[i].first);
+                    assignDataPackageIndex(cell_index, meta_data[i].second);
+                }
+            },
+            ap);
+
+        resizeMeshVariableData();
+        read_mesh_variable_data_(all_mesh_variables_, num_grid_pkgs_, cache_file_reader);
+    }
+
     /** void (non_value_returning) function iterate on all data points by value. */
     template <typename FunctionOnData>
     void for_each_cell_data(const FunctionOnData &function);
@@ -231,6 +378,47 @@ class MeshWithGridDataPackages : public Mesh
     /** probe by applying bi and tri-linear interpolation within the package. */
     template <class DataType>
     DataType probeDataPackage(MeshVariable<DataType> &mesh_variable, size_t package_index, const Arrayi &cell_index, const Vecd &position);
+    /** gather the data of a package and its upper neighbors required by the interpolation. */
+    template <class DataType>
+    void gatherPackageStencil(MeshVariable<DataType> &mesh_variable, size_t package_index,
+                              PackageTemporaryData<DataType> &stencil);
+    /** the same interpolation as probeDataPackage but on a gathered stencil. */
+    template <class DataType>
+    DataType probePackageStencil(const PackageTemporaryData<DataType> &stencil,
+                                 const Arrayi &cell_index, const Vecd &position);
+
+    using PackageProbe = std::pair<size_t, size_t>; /**< (size_t)package index, (size_t)position index. */
+    /** sort the probes by package index with a counting sort and find the first probe of each package,
+     *  the last entry of package_starts is the total number of probes. */
+    void groupProbesByPackage(const StdLargeVec<Vecd> &positions, const IndexVector &indices,
+                              StdVec<PackageProbe> &probes, IndexVector &package_starts)
+    {
+        IndexVector package_indices(indices.size());
+        parallel_for(
+            IndexRange(0, indices.size()),
+            [&](const IndexRange &r)
+            {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                    package_indices[i] = PackageIndexFromCellIndex(CellIndexFromPosition(positions[indices[i]]));
+            },
+            ap);
+
+        IndexVector offsets(num_grid_pkgs_ + 1, 0);
+        for (size_t i = 0; i != indices.size(); ++i)
+            offsets[package_indices[i] + 1]++;
+        package_starts.clear();
+        for (size_t package_index = 0; package_index != num_grid_pkgs_; ++package_index)
+        {
+            if (offsets[package_index + 1] != 0)
+                package_starts.push_back(offsets[package_index]);
+            offsets[package_index + 1] += offsets[package_index];
+        }
+        package_starts.push_back(indices.size());
+
+        probes.resize(indices.size());
+        for (size_t i = 0; i != indices.size(); ++i)
+            probes[offsets[package_indices[i]]++] = PackageProbe(package_indices[i], indices[i]);
+    }
 
     /** return the position of the lower bound data in a cell. */
     Vecd DataLowerBoundInCell(const Arrayi &cell_index)
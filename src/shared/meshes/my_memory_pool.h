@@ -37,12 +37,14 @@
 
 #include "tbb/enumerable_thread_specific.h"
 #include "tbb/memory_pool.h"
+#include "tbb/spin_mutex.h"
 
 #include <list>
 
 /**
  * @class MyMemoryPool
  * @brief Note that the data package T should has a default constructor.
+ * Allocation and relinquishing are guarded by a lock so that they can be called concurrently.
  */
 template <class T>
 class MyMemoryPool
@@ -57,6 +59,7 @@ class MyMemoryPool
     std::list<T, pool_allocator_t> data_list;               /**< list of all nodes allocated. */
 #endif
     std::list<T *> free_list; /**< list of all free nodes. */
+    tbb::spin_mutex mutex_;    /**< guards the two lists. */
 
   public:
 #ifdef __EMSCRIPTEN__
@@ -72,6 +75,7 @@ class MyMemoryPool
     template <typename... Args>
     T *malloc(Args &&...args)
     {
+        tbb::spin_mutex::scoped_lock lock(mutex_);
         if (free_list.empty())
         {
             data_list.emplace_back(std::forward<Args>(args)...);
@@ -87,6 +91,7 @@ class MyMemoryPool
     /** Relinquish an unused node. */
     void free(T *ptr)
     {
+        tbb::spin_mutex::scoped_lock lock(mutex_);
         free_list.push_back(ptr);
     };
     /** Return the total number of nodes allocated. */
@@ -63,7 +63,8 @@ class BaseLocalDynamics
         : identifier_(identifier){};
     virtual ~BaseLocalDynamics(){};
     DynamicsIdentifier &getDynamicsIdentifier() { return identifier_; };
-    virtual void setupDynamics(Real dt = 0.0) {}; // setup global parameters
+    virtual void setupDynamics(Real dt = 0.0) {};  // setup global parameters
+    virtual void finishDynamics(Real dt = 0.0) {}; // batched global operations after the particle loop
   protected:
     DynamicsIdentifier &identifier_;
 };
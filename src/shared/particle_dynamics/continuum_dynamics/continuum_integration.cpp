@@ -103,7 +103,7 @@ StressDiffusion::StressDiffusion(BaseInnerRelation &inner_relation)
 //====================================================================================//
 void StressDiffusion::interaction(size_t index_i, Real dt)
 {
-    Vecd acc_prior_i = force_prior_[index_i] / mass_[index_i];
+    Vecd acc_prior_i = force_prior_.value(index_i) / mass_[index_i];
     Real gravity = abs(acc_prior_i(1, 0));
     Real density = plastic_continuum_.getDensity();
     Mat3d diffusion_stress_rate_ = Mat3d::Zero();
@@ -16,7 +16,7 @@ BaseIntegration1stHalf<FluidDynamicsType>::BaseIntegration1stHalf(BaseInnerRelat
 template <class FluidDynamicsType>
 void BaseIntegration1stHalf<FluidDynamicsType>::update(size_t index_i, Real dt)
 {
-    this->vel_[index_i] += ((this->force_prior_[index_i] + this->force_[index_i]) / this->mass_[index_i] + this->acc_shear_[index_i]) * dt;
+    this->vel_[index_i] += ((this->force_prior_.value(index_i) + this->force_.value(index_i)) / this->mass_[index_i] + this->acc_shear_[index_i]) * dt;
 }
 //=================================================================================================//
 template <class DataDelegationType>
@@ -57,7 +57,7 @@ void PlasticIntegration1stHalf<Inner<>, RiemannSolverType>::initialization(size_
 template <class RiemannSolverType>
 Vecd PlasticIntegration1stHalf<Inner<>, RiemannSolverType>::computeNonConservativeForce(size_t index_i)
 {
-    Vecd force = force_prior_[index_i] * rho_[index_i];
+    Vecd force = force_prior_.value(index_i) * rho_[index_i];
     const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
     {
@@ -95,7 +95,7 @@ void PlasticIntegration1stHalf<Inner<>, RiemannSolverType>::interaction(size_t i
 template <class RiemannSolverType>
 void PlasticIntegration1stHalf<Inner<>, RiemannSolverType>::update(size_t index_i, Real dt)
 {
-    vel_[index_i] += (force_prior_[index_i] + force_[index_i]) / mass_[index_i] * dt;
+    vel_[index_i] += (force_prior_.value(index_i) + force_.value(index_i)) / mass_[index_i] * dt;
 }
 //=================================================================================================//
 template <class RiemannSolverType>
@@ -135,7 +135,7 @@ void PlasticIntegration1stHalf<Contact<Wall>, RiemannSolverType>::interaction(si
 template <class RiemannSolverType>
 Vecd PlasticIntegration1stHalf<Contact<Wall>, RiemannSolverType>::computeNonConservativeForce(size_t index_i)
 {
-    return this->force_prior_[index_i];
+    return this->force_prior_.value(index_i);
 }
 //=================================================================================================//
 template <class RiemannSolverType>
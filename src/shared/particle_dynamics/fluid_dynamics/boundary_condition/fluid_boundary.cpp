@@ -40,10 +40,10 @@ EmitterInflowCondition::
       sorted_id_(particles_->ParticleSortedIds()),
       pos_(*particles_->getVariableDataByName<Vecd>("Position")),
       vel_(*particles_->getVariableDataByName<Vecd>("Velocity")),
-      force_(*particles_->getVariableDataByName<Vecd>("Force")),
+      force_(particles_->getStoredVariableByName<Vecd>("Force")),
       rho_(*particles_->getVariableDataByName<Real>("Density")),
       p_(*particles_->getVariableDataByName<Real>("Pressure")),
-      drho_dt_(*particles_->getVariableDataByName<Real>("DensityChangeRate")),
+      drho_dt_(particles_->getStoredVariableByName<Real>("DensityChangeRate")),
       inflow_pressure_(0), rho0_(fluid_.ReferenceDensity()),
       aligned_box_(aligned_box_part.getAlignedBoxShape()),
       updated_transform_(aligned_box_.getTransform()),
@@ -80,18 +80,32 @@ void EmitterInflowInjection::update(size_t original_index_i, Real dt)
     size_t sorted_index_i = sorted_id_[original_index_i];
     if (aligned_box_.checkUpperBound(pos_[sorted_index_i]))
     {
-        mutex_switch_to_real_.lock();
-        buffer_.checkEnoughBuffer(*particles_);
-        particles_->createRealParticleFrom(sorted_index_i);
-        mutex_switch_to_real_.unlock();
-
-        /** Periodic bounding. */
-        pos_[sorted_index_i] = aligned_box_.getUpperPeriodic(pos_[sorted_index_i]);
-        rho_[sorted_index_i] = fluid_.ReferenceDensity();
-        p_[sorted_index_i] = fluid_.getPressure(rho_[sorted_index_i]);
+        injected_particles_.push_back(sorted_index_i);
     }
 }
 //=================================================================================================//
+void EmitterInflowInjection::finishDynamics(Real dt)
+{
+    buffer_.checkEnoughBuffer(*particles_, injected_particles_.size());
+    particles_->createRealParticlesFrom(injected_particles_);
+
+    parallel_for(
+        IndexRange(0, injected_particles_.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+            {
+                size_t sorted_index_i = injected_particles_[k];
+                /** Periodic bounding. */
+                pos_[sorted_index_i] = aligned_box_.getUpperPeriodic(pos_[sorted_index_i]);
+                rho_[sorted_index_i] = fluid_.ReferenceDensity();
+                p_[sorted_index_i] = fluid_.getPressure(rho_[sorted_index_i]);
+            }
+        },
+        ap);
+    injected_particles_.clear();
+}
+//=================================================================================================//
 DisposerOutflowDeletion::
     DisposerOutflowDeletion(BodyAlignedBoxByCell &aligned_box_part)
     : BaseLocalDynamics<BodyPartByCell>(aligned_box_part),
@@ -101,12 +115,17 @@ DisposerOutflowDeletion::
 //=================================================================================================//
 void DisposerOutflowDeletion::update(size_t index_i, Real dt)
 {
-    mutex_switch_to_buffer_.lock();
-    while (aligned_box_.checkUpperBound(pos_[index_i]) && index_i < particles_->TotalRealParticles())
+    if (index_i < particles_->TotalRealParticles() && aligned_box_.checkUpperBound(pos_[index_i]))
     {
-        particles_->switchToBufferParticle(index_i);
+        deleted_particles_.push_back(index_i);
     }
-    mutex_switch_to_buffer_.unlock();
 }
+//=================================================================================================//
+void DisposerOutflowDeletion::finishDynamics(Real dt)
+{
+    particles_->switchToBufferParticles(deleted_particles_);
+    deleted_particles_.clear();
+}
+//=================================================================================================//
 } // namespace fluid_dynamics
 } // namespace SPH
@@ -195,8 +195,10 @@ class EmitterInflowCondition : public BaseLocalDynamics<BodyPartByParticle>, pub
   protected:
     Fluid &fluid_;
     StdLargeVec<size_t> &sorted_id_;
-    StdLargeVec<Vecd> &pos_, &vel_, &force_;
-    StdLargeVec<Real> &rho_, &p_, &drho_dt_;
+    StdLargeVec<Vecd> &pos_, &vel_;
+    StoredVariable<Vecd> force_;
+    StdLargeVec<Real> &rho_, &p_;
+    StoredVariable<Real> drho_dt_;
     /** inflow pressure condition */
     Real inflow_pressure_;
     Real rho0_;
@@ -221,9 +223,10 @@ class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>, pub
     virtual ~EmitterInflowInjection(){};
 
     void update(size_t original_index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override;
 
   protected:
-    std::mutex mutex_switch_to_real_; /**< mutex exclusion for memory conflict */
+    ConcurrentIndexVector injected_particles_; /**< indices of the particles crossing the upper bound */
     Fluid &fluid_;
     StdLargeVec<size_t> &original_id_;
     StdLargeVec<size_t> &sorted_id_;
@@ -244,9 +247,10 @@ class DisposerOutflowDeletion : public BaseLocalDynamics<BodyPartByCell>, public
     virtual ~DisposerOutflowDeletion(){};
 
     void update(size_t index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override;
 
   protected:
-    std::mutex mutex_switch_to_buffer_; /**< mutex exclusion for memory conflict */
+    ConcurrentIndexVector deleted_particles_; /**< indices of the particles leaving the domain */
     StdLargeVec<Vecd> &pos_;
     AlignedBoxShape &aligned_box_;
 };
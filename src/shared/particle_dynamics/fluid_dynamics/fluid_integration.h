@@ -76,8 +76,10 @@ class BaseIntegration : public LocalDynamics, public DataDelegationType
 
   protected:
     Fluid &fluid_;
-    StdLargeVec<Real> &Vol_, &rho_, &mass_, &p_, &drho_dt_;
-    StdLargeVec<Vecd> &pos_, &vel_, &force_, &force_prior_;
+    StdLargeVec<Real> &Vol_, &rho_, &mass_, &p_;
+    StdLargeVec<Vecd> &pos_, &vel_;
+    StoredVariable<Real> drho_dt_;
+    StoredVariable<Vecd> force_, force_prior_;
 };
 
 template <typename... InteractionTypes>
@@ -16,11 +16,11 @@ BaseIntegration<DataDelegationType>::BaseIntegration(BaseRelationType &base_rela
       rho_(*this->particles_->template getVariableDataByName<Real>("Density")),
       mass_(*this->particles_->template getVariableDataByName<Real>("Mass")),
       p_(*this->particles_->template registerSharedVariable<Real>("Pressure")),
-      drho_dt_(*this->particles_->template registerSharedVariable<Real>("DensityChangeRate")),
       pos_(*this->particles_->template getVariableDataByName<Vecd>("Position")),
       vel_(*this->particles_->template registerSharedVariable<Vecd>("Velocity")),
-      force_(*this->particles_->template registerSharedVariable<Vecd>("Force")),
-      force_prior_(*this->particles_->template registerSharedVariable<Vecd>("ForcePrior")) {}
+      drho_dt_(this->particles_->template registerStoredVariable<Real>("DensityChangeRate")),
+      force_(this->particles_->template registerStoredVariable<Vecd>("Force")),
+      force_prior_(this->particles_->template registerStoredVariable<Vecd>("ForcePrior")) {}
 //=================================================================================================//
 template <class RiemannSolverType, class KernelCorrectionType>
 Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::
@@ -69,7 +69,7 @@ void Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::initi
 template <class RiemannSolverType, class KernelCorrectionType>
 void Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::update(size_t index_i, Real dt)
 {
-    vel_[index_i] += (force_prior_[index_i] + force_[index_i]) / mass_[index_i] * dt;
+    vel_[index_i] += (force_prior_.value(index_i) + force_.value(index_i)) / mass_[index_i] * dt;
 }
 //=================================================================================================//
 template <class RiemannSolverType, class KernelCorrectionType>
@@ -114,7 +114,7 @@ void Integration1stHalf<Contact<Wall>, RiemannSolverType, KernelCorrectionType>:
             Real dW_ijV_j = wall_neighborhood.dW_ij_[n] * wall_Vol_k[index_j];
             Real r_ij = wall_neighborhood.r_ij_[n];
 
-            Real face_wall_external_acceleration = (force_prior_[index_i] / mass_[index_i] - wall_acc_ave_k[index_j]).dot(-e_ij);
+            Real face_wall_external_acceleration = (force_prior_.value(index_i) / mass_[index_i] - wall_acc_ave_k[index_j]).dot(-e_ij);
             Real p_in_wall = p_[index_i] + rho_[index_i] * r_ij * SMAX(Real(0), face_wall_external_acceleration);
             force -= (p_[index_i] + p_in_wall) * correction_(index_i) * dW_ijV_j * e_ij;
             rho_dissipation += riemann_solver_.DissipativeUJump(p_[index_i] - p_in_wall) * dW_ijV_j;
@@ -13,15 +13,15 @@ AcousticTimeStepSize::AcousticTimeStepSize(SPHBody &sph_body, Real acousticCFL)
       p_(*particles_->getVariableDataByName<Real>("Pressure")),
       mass_(*particles_->getVariableDataByName<Real>("Mass")),
       vel_(*particles_->getVariableDataByName<Vecd>("Velocity")),
-      force_(*particles_->getVariableDataByName<Vecd>("Force")),
-      force_prior_(*particles_->getVariableDataByName<Vecd>("ForcePrior")),
+      force_(particles_->getStoredVariableByName<Vecd>("Force")),
+      force_prior_(particles_->getStoredVariableByName<Vecd>("ForcePrior")),
       smoothing_length_min_(sph_body.sph_adaptation_->MinimumSmoothingLength()),
       acousticCFL_(acousticCFL) {}
 //=================================================================================================//
 Real AcousticTimeStepSize::reduce(size_t index_i, Real dt)
 {
     Real acceleration_scale = 4.0 * smoothing_length_min_ *
-                              (force_[index_i] + force_prior_[index_i]).norm() / mass_[index_i];
+                              (force_.value(index_i) + force_prior_.value(index_i)).norm() / mass_[index_i];
     return SMAX(fluid_.getSoundSpeed(p_[index_i], rho_[index_i]) + vel_[index_i].norm(), acceleration_scale);
 }
 //=================================================================================================//
@@ -38,15 +38,15 @@ AdvectionTimeStepSizeForImplicitViscosity::
       DataDelegateSimple(sph_body),
       mass_(*particles_->getVariableDataByName<Real>("Mass")),
       vel_(*particles_->getVariableDataByName<Vecd>("Velocity")),
-      force_(*particles_->getVariableDataByName<Vecd>("Force")),
-      force_prior_(*particles_->getVariableDataByName<Vecd>("ForcePrior")),
+      force_(particles_->getStoredVariableByName<Vecd>("Force")),
+      force_prior_(particles_->getStoredVariableByName<Vecd>("ForcePrior")),
       smoothing_length_min_(sph_body.sph_adaptation_->MinimumSmoothingLength()),
       speed_ref_(U_ref), advectionCFL_(advectionCFL) {}
 //=================================================================================================//
 Real AdvectionTimeStepSizeForImplicitViscosity::reduce(size_t index_i, Real dt)
 {
     Real acceleration_scale = 4.0 * smoothing_length_min_ *
-                              (force_[index_i] + force_prior_[index_i]).norm() / mass_[index_i];
+                              (force_.value(index_i) + force_prior_.value(index_i)).norm() / mass_[index_i];
     return SMAX(vel_[index_i].squaredNorm(), acceleration_scale);
 }
 //=================================================================================================//
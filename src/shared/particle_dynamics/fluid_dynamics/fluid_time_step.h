@@ -53,7 +53,8 @@ class AcousticTimeStepSize : public LocalDynamicsReduce<ReduceMax>, public DataD
   protected:
     Fluid &fluid_;
     StdLargeVec<Real> &rho_, &p_, &mass_;
-    StdLargeVec<Vecd> &vel_, &force_, &force_prior_;
+    StdLargeVec<Vecd> &vel_;
+    StoredVariable<Vecd> force_, force_prior_;
     Real smoothing_length_min_;
     Real acousticCFL_;
 };
@@ -75,7 +76,8 @@ class AdvectionTimeStepSizeForImplicitViscosity
 
   protected:
     StdLargeVec<Real> &mass_;
-    StdLargeVec<Vecd> &vel_, &force_, &force_prior_;
+    StdLargeVec<Vecd> &vel_;
+    StoredVariable<Vecd> force_, force_prior_;
     Real smoothing_length_min_;
     Real speed_ref_, advectionCFL_;
 };
@@ -31,7 +31,7 @@ StaticConfinementIntegration1stHalf::StaticConfinementIntegration1stHalf(NearSha
       mass_(*particles_->getVariableDataByName<Real>("Mass")),
       pos_(*particles_->getVariableDataByName<Vecd>("Position")),
       vel_(*particles_->getVariableDataByName<Vecd>("Velocity")),
-      force_(*particles_->getVariableDataByName<Vecd>("Force")),
+      force_(particles_->getStoredVariableByName<Vecd>("Force")),
       level_set_shape_(&near_surface.getLevelSetShape()),
       riemann_solver_(fluid_, fluid_) {}
 //=================================================================================================//
@@ -47,7 +47,7 @@ StaticConfinementIntegration2ndHalf::StaticConfinementIntegration2ndHalf(NearSha
       fluid_(DynamicCast<Fluid>(this, particles_->getBaseMaterial())),
       rho_(*particles_->getVariableDataByName<Real>("Density")),
       p_(*particles_->getVariableDataByName<Real>("Pressure")),
-      drho_dt_(*particles_->getVariableDataByName<Real>("DensityChangeRate")),
+      drho_dt_(particles_->getStoredVariableByName<Real>("DensityChangeRate")),
       pos_(*particles_->getVariableDataByName<Vecd>("Position")),
       vel_(*particles_->getVariableDataByName<Vecd>("Velocity")),
       level_set_shape_(&near_surface.getLevelSetShape()),
@@ -70,7 +70,8 @@ class StaticConfinementIntegration1stHalf : public BaseLocalDynamics<BodyPartByC
   protected:
     Fluid &fluid_;
     StdLargeVec<Real> &rho_, &p_, &mass_;
-    StdLargeVec<Vecd> &pos_, &vel_, &force_;
+    StdLargeVec<Vecd> &pos_, &vel_;
+    StoredVariable<Vecd> force_;
     LevelSetShape *level_set_shape_;
     AcousticRiemannSolver riemann_solver_;
 };
@@ -88,7 +89,8 @@ class StaticConfinementIntegration2ndHalf : public BaseLocalDynamics<BodyPartByC
 
   protected:
     Fluid &fluid_;
-    StdLargeVec<Real> &rho_, &p_, &drho_dt_;
+    StdLargeVec<Real> &rho_, &p_;
+    StoredVariable<Real> drho_dt_;
     StdLargeVec<Vecd> &pos_, &vel_;
     LevelSetShape *level_set_shape_;
     AcousticRiemannSolver riemann_solver_;
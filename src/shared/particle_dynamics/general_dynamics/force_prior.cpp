@@ -4,7 +4,7 @@ namespace SPH
 {
 //=================================================================================================//
 ForcePrior::ForcePrior(BaseParticles *base_particles, const std::string &force_name)
-    : force_prior_(*base_particles->registerSharedVariable<Vecd>("ForcePrior")),
+    : force_prior_(base_particles->registerStoredVariable<Vecd>("ForcePrior")),
       current_force_(*base_particles->registerSharedVariable<Vecd>(force_name)),
       previous_force_(*base_particles->registerSharedVariable<Vecd>("Previous" + force_name))
 {
@@ -38,7 +38,8 @@ namespace SPH
 class ForcePrior
 {
   protected:
-    StdLargeVec<Vecd> &force_prior_, &current_force_, &previous_force_;
+    StoredVariable<Vecd> force_prior_;
+    StdLargeVec<Vecd> &current_force_, &previous_force_;
 
   public:
     ForcePrior(BaseParticles *base_particles, const std::string &force_name);
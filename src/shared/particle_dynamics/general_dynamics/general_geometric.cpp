@@ -1,5 +1,6 @@
 #include "general_geometric.h"
 #include "base_particles.hpp"
+#include "level_set_shape.h"
 
 namespace SPH
 {
@@ -7,20 +8,32 @@ namespace SPH
 NormalDirectionFromBodyShape::NormalDirectionFromBodyShape(SPHBody &sph_body)
     : LocalDynamics(sph_body), DataDelegateSimple(sph_body),
       initial_shape_(sph_body.getInitialShape()),
+      level_set_shape_(dynamic_cast<LevelSetShape *>(&initial_shape_)),
       pos_(*particles_->getVariableDataByName<Vecd>("Position")),
       n_(*particles_->registerSharedVariable<Vecd>("NormalDirection")),
       n0_(*particles_->registerSharedVariableFrom<Vecd>("InitialNormalDirection", "NormalDirection")),
       phi_(*particles_->registerSharedVariable<Real>("SignedDistance")),
       phi0_(*particles_->registerSharedVariable<Real>("InitialSignedDistance")) {}
 //=============================================================================================//
+void NormalDirectionFromBodyShape::setupDynamics(Real dt)
+{
+    if (level_set_shape_ != nullptr)
+    {
+        IndexRange all_real_particles(0, particles_->TotalRealParticles());
+        level_set_shape_->findNormalDirections(pos_, all_real_particles, n_);
+        level_set_shape_->findSignedDistances(pos_, all_real_particles, phi_);
+    }
+}
+//=============================================================================================//
 void NormalDirectionFromBodyShape::update(size_t index_i, Real dt)
 {
-    Vecd normal_direction = initial_shape_.findNormalDirection(pos_[index_i]);
-    n_[index_i] = normal_direction;
-    n0_[index_i] = normal_direction;
-    Real signed_distance = initial_shape_.findSignedDistance(pos_[index_i]);
-    phi_[index_i] = signed_distance;
-    phi0_[index_i] = signed_distance;
+    if (level_set_shape_ == nullptr)
+    {
+        n_[index_i] = initial_shape_.findNormalDirection(pos_[index_i]);
+        phi_[index_i] = initial_shape_.findSignedDistance(pos_[index_i]);
+    }
+    n0_[index_i] = n_[index_i];
+    phi0_[index_i] = phi_[index_i];
 }
 //=============================================================================================//
 NormalDirectionFromSubShapeAndOp::
@@ -33,6 +33,8 @@
 
 namespace SPH
 {
+class LevelSetShape;
+
 /**
  * @class NormalDirectionFromBodyShape
  * @brief normal direction at particles
@@ -42,10 +44,13 @@ class NormalDirectionFromBodyShape : public LocalDynamics, public DataDelegateSi
   public:
     explicit NormalDirectionFromBodyShape(SPHBody &sph_body);
     virtual ~NormalDirectionFromBodyShape(){};
+    /** a level set shape is probed in batch for all particles */
+    virtual void setupDynamics(Real dt = 0.0) override;
     void update(size_t index_i, Real dt = 0.0);
 
   protected:
     Shape &initial_shape_;
+    LevelSetShape *level_set_shape_; /**< nullptr if the shape is not a level set shape */
     StdLargeVec<Vecd> &pos_, &n_, &n0_;
     StdLargeVec<Real> &phi_, &phi0_;
 };
@@ -36,8 +36,10 @@ namespace SPH
 /**
  * @class BaseInterpolation
  * @brief Base class for interpolation.
+ * The interpolation is accumulated with DataType and
+ * the interpolated quantities are stored with StorageType, e.g. ReducedData<DataType>.
  */
-template <typename DataType>
+template <typename DataType, typename StorageType = DataType>
 class BaseInterpolation : public LocalDynamics, public DataDelegateContact
 {
   public:
@@ -74,11 +76,11 @@ class BaseInterpolation : public LocalDynamics, public DataDelegateContact
                 ttl_weight += weight_j;
             }
         }
-        (*interpolated_quantities_)[index_i] = observed_quantity / (ttl_weight + TinyReal);
+        (*interpolated_quantities_)[index_i] = precisionCast<StorageType>(DataType(observed_quantity / (ttl_weight + TinyReal)));
     };
 
   protected:
-    StdLargeVec<DataType> *interpolated_quantities_;
+    StdLargeVec<StorageType> *interpolated_quantities_;
     StdVec<StdLargeVec<Real> *> contact_Vol_;
     StdVec<StdLargeVec<DataType> *> contact_data_;
 };
@@ -87,16 +89,16 @@ class BaseInterpolation : public LocalDynamics, public DataDelegateContact
  * @class InterpolatingAQuantity
  * @brief Interpolate a given member data in the particles of a general body
  */
-template <typename DataType>
-class InterpolatingAQuantity : public BaseInterpolation<DataType>
+template <typename DataType, typename StorageType = DataType>
+class InterpolatingAQuantity : public BaseInterpolation<DataType, StorageType>
 {
   public:
     explicit InterpolatingAQuantity(BaseContactRelation &contact_relation,
                                     const std::string &interpolated_variable, const std::string &target_variable)
-        : BaseInterpolation<DataType>(contact_relation, target_variable)
+        : BaseInterpolation<DataType, StorageType>(contact_relation, target_variable)
     {
         this->interpolated_quantities_ =
-            this->particles_->template getVariableDataByName<DataType>(interpolated_variable);
+            this->particles_->template getVariableDataByName<StorageType>(interpolated_variable);
     };
     virtual ~InterpolatingAQuantity(){};
 };
@@ -105,14 +107,14 @@ class InterpolatingAQuantity : public BaseInterpolation<DataType>
  * @class ObservingAQuantity
  * @brief Observing a variable from contact bodies.
  */
-template <typename DataType>
-class ObservingAQuantity : public InteractionDynamics<BaseInterpolation<DataType>>
+template <typename DataType, typename StorageType = DataType>
+class ObservingAQuantity : public InteractionDynamics<BaseInterpolation<DataType, StorageType>>
 {
   public:
     explicit ObservingAQuantity(BaseContactRelation &contact_relation, const std::string &variable_name)
-        : InteractionDynamics<BaseInterpolation<DataType>>(contact_relation, variable_name)
+        : InteractionDynamics<BaseInterpolation<DataType, StorageType>>(contact_relation, variable_name)
     {
-        this->interpolated_quantities_ = this->particles_->template registerSharedVariable<DataType>(variable_name);
+        this->interpolated_quantities_ = this->particles_->template registerSharedVariable<StorageType>(variable_name);
     };
     virtual ~ObservingAQuantity(){};
 };
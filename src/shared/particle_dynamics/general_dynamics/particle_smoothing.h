@@ -42,13 +42,14 @@ class ParticleSmoothing : public LocalDynamics, public DataDelegateInner
 {
   public:
     explicit ParticleSmoothing(BaseInnerRelation &inner_relation, const std::string &variable_name);
-    virtual ~ParticleSmoothing(){};
+    virtual ~ParticleSmoothing();
     void interaction(size_t index_i, Real dt = 0.0);
     void update(size_t index_i, Real dt = 0.0);
 
   protected:
     const Real W0_;
     StdLargeVec<VariableType> &smoothed_, &temp_;
+    const std::string temp_name_;
 };
 
 /**
@@ -116,6 +116,7 @@ class SimpleDynamics : public LocalDynamicsType, public BaseDynamics<void>
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i) { this->update(i, dt); });
+        this->finishDynamics(dt);
     };
 };
 
@@ -278,6 +279,7 @@ class InteractionWithUpdate : public InteractionDynamics<LocalDynamicsType, Exec
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i) { this->update(i, dt); });
+        this->finishDynamics(dt);
     };
 };
 
@@ -337,6 +339,7 @@ class Dynamics1Level : public InteractionDynamics<LocalDynamicsType, ExecutionPo
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
                      [&](size_t i) { this->update(i, dt); });
+        this->finishDynamics(dt);
     };
 };
 } // namespace SPH
@@ -27,11 +27,28 @@ void RelaxationResidue<Inner<>>::interaction(size_t index_i, Real dt)
     residue_[index_i] = residue;
 };
 //=================================================================================================//
+RelaxationResidue<Inner<LevelSetCorrection>>::~RelaxationResidue()
+{
+    particles_->releaseTransientVariable<Vecd>("KernelGradientIntegral");
+}
+//=================================================================================================//
+void RelaxationResidue<Inner<LevelSetCorrection>>::setupDynamics(Real dt)
+{
+    if (is_smoothing_length_uniform_)
+    {
+        level_set_shape_.computeKernelGradientIntegrals(
+            pos_, IndexRange(0, particles_->TotalRealParticles()), kernel_gradient_integral_);
+    }
+}
+//=================================================================================================//
 void RelaxationResidue<Inner<LevelSetCorrection>>::interaction(size_t index_i, Real dt)
 {
     RelaxationResidue<Inner<>>::interaction(index_i, dt);
-    residue_[index_i] -= 2.0 * level_set_shape_.computeKernelGradientIntegral(
-                                   pos_[index_i], sph_adaptation_->SmoothingLengthRatio(index_i));
+    Vecd kernel_gradient_integral =
+        is_smoothing_length_uniform_
+            ? kernel_gradient_integral_[index_i]
+            : level_set_shape_.computeKernelGradientIntegral(pos_[index_i], sph_adaptation_->SmoothingLengthRatio(index_i));
+    residue_[index_i] -= 2.0 * kernel_gradient_integral;
 }
 //=================================================================================================//
 void RelaxationResidue<Contact<>>::interaction(size_t index_i, Real dt)
@@ -50,7 +50,7 @@ class RelaxationResidue<Base, DataDelegationType>
   public:
     template <class BaseRelationType>
     explicit RelaxationResidue(BaseRelationType &base_relation);
-    virtual ~RelaxationResidue(){};
+    virtual ~RelaxationResidue();
 
   protected:
     SPHAdaptation *sph_adaptation_;
@@ -82,12 +82,17 @@ class RelaxationResidue<Inner<LevelSetCorrection>> : public RelaxationResidue<In
     template <typename BodyRelationType, typename FirstArg>
     explicit RelaxationResidue(ConstructorArgs<BodyRelationType, FirstArg> parameters)
         : RelaxationResidue(parameters.body_relation_, std::get<0>(parameters.others_)){};
-    virtual ~RelaxationResidue(){};
+    virtual ~RelaxationResidue();
+    /** the kernel gradient integrals are probed in batch for all particles
+     *  if the particles share the same smoothing length */
+    virtual void setupDynamics(Real dt = 0.0) override;
     void interaction(size_t index_i, Real dt = 0.0);
 
   protected:
     StdLargeVec<Vecd> &pos_;
     LevelSetShape &level_set_shape_;
+    bool is_smoothing_length_uniform_;
+    StdLargeVec<Vecd> &kernel_gradient_integral_;
 };
 
 template <>
@@ -14,13 +14,21 @@ RelaxationResidue<Base, DataDelegationType>::RelaxationResidue(BaseRelationType
     : LocalDynamics(base_relation.getSPHBody()), DataDelegationType(base_relation),
       sph_adaptation_(this->sph_body_.sph_adaptation_),
       Vol_(*this->particles_->template getVariableDataByName<Real>("VolumetricMeasure")),
-      residue_(*this->particles_->template registerSharedVariable<Vecd>("ZeroOrderResidue")) {}
+      residue_(*this->particles_->template registerTransientVariable<Vecd>("ZeroOrderResidue")) {}
+//=================================================================================================//
+template <class DataDelegationType>
+RelaxationResidue<Base, DataDelegationType>::~RelaxationResidue()
+{
+    this->particles_->template releaseTransientVariable<Vecd>("ZeroOrderResidue");
+}
 //=================================================================================================//
 template <typename... Args>
 RelaxationResidue<Inner<LevelSetCorrection>>::RelaxationResidue(Args &&...args)
     : RelaxationResidue<Inner<>>(std::forward<Args>(args)...),
       pos_(*particles_->getVariableDataByName<Vecd>("Position")),
-      level_set_shape_(DynamicCast<LevelSetShape>(this, this->getRelaxShape())){};
+      level_set_shape_(DynamicCast<LevelSetShape>(this, this->getRelaxShape())),
+      is_smoothing_length_uniform_(dynamic_cast<ParticleWithLocalRefinement *>(sph_adaptation_) == nullptr),
+      kernel_gradient_integral_(*particles_->registerTransientVariable<Vecd>("KernelGradientIntegral")){};
 //=================================================================================================//
 template <class RelaxationResidueType>
 template <typename FirstArg, typename... OtherArgs>
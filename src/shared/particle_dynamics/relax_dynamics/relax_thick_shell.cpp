@@ -84,10 +84,15 @@ ShellNormalDirectionPrediction::NormalPrediction::NormalPrediction(SPHBody &sph_
       level_set_shape_(DynamicCast<LevelSetShape>(this, &sph_body.getInitialShape())),
       pos_(*particles_->getVariableDataByName<Vecd>("Position")),
       n_(*particles_->getVariableDataByName<Vecd>("NormalDirection")),
-      n_temp_(*particles_->registerSharedVariable<Vecd>(
+      n_temp_(*particles_->registerTransientVariable<Vecd>(
           "PreviousNormalDirection", [&](size_t i) -> Vecd
           { return n_[i]; })) {}
 //=================================================================================================//
+ShellNormalDirectionPrediction::NormalPrediction::~NormalPrediction()
+{
+    particles_->releaseTransientVariable<Vecd>("PreviousNormalDirection");
+}
+//=================================================================================================//
 void ShellNormalDirectionPrediction::NormalPrediction::update(size_t index_i, Real dt)
 {
     n_temp_[index_i] = n_[index_i];
@@ -99,7 +104,12 @@ ShellNormalDirectionPrediction::PredictionConvergenceCheck::
     : LocalDynamicsReduce<ReduceAND>(sph_body), DataDelegateSimple(sph_body),
       convergence_criterion_(convergence_criterion),
       n_(*particles_->getVariableDataByName<Vecd>("NormalDirection")),
-      n_temp_(*particles_->getVariableDataByName<Vecd>("PreviousNormalDirection")) {}
+      n_temp_(*particles_->registerTransientVariable<Vecd>("PreviousNormalDirection")) {}
+//=================================================================================================//
+ShellNormalDirectionPrediction::PredictionConvergenceCheck::~PredictionConvergenceCheck()
+{
+    particles_->releaseTransientVariable<Vecd>("PreviousNormalDirection");
+}
 //=================================================================================================//
 bool ShellNormalDirectionPrediction::PredictionConvergenceCheck::reduce(size_t index_i, Real dt)
 {
@@ -111,13 +121,18 @@ ShellNormalDirectionPrediction::ConsistencyCorrection::
     : LocalDynamics(inner_relation.getSPHBody()), DataDelegateInner(inner_relation),
       consistency_criterion_(consistency_criterion),
       n_(*particles_->getVariableDataByName<Vecd>("NormalDirection")),
-      updated_indicator_(*particles_->registerSharedVariable<int>(
+      updated_indicator_(*particles_->registerTransientVariable<int>(
           "UpdatedIndicator", [&](size_t i) -> int
           { return 0; }))
 {
     updated_indicator_[particles_->TotalRealParticles() / 3] = 1;
 }
 //=================================================================================================//
+ShellNormalDirectionPrediction::ConsistencyCorrection::~ConsistencyCorrection()
+{
+    particles_->releaseTransientVariable<int>("UpdatedIndicator");
+}
+//=================================================================================================//
 void ShellNormalDirectionPrediction::ConsistencyCorrection::interaction(size_t index_i, Real dt)
 {
     mutex_modify_neighbor_.lock();
@@ -152,7 +167,12 @@ void ShellNormalDirectionPrediction::ConsistencyCorrection::interaction(size_t i
 ShellNormalDirectionPrediction::ConsistencyUpdatedCheck::ConsistencyUpdatedCheck(SPHBody &sph_body)
     : LocalDynamicsReduce<ReduceAND>(sph_body),
       DataDelegateSimple(sph_body),
-      updated_indicator_(*particles_->getVariableDataByName<int>("UpdatedIndicator")) {}
+      updated_indicator_(*particles_->registerTransientVariable<int>("UpdatedIndicator")) {}
+//=================================================================================================//
+ShellNormalDirectionPrediction::ConsistencyUpdatedCheck::~ConsistencyUpdatedCheck()
+{
+    particles_->releaseTransientVariable<int>("UpdatedIndicator");
+}
 //=================================================================================================//
 bool ShellNormalDirectionPrediction::ConsistencyUpdatedCheck::reduce(size_t index_i, Real dt)
 {
@@ -90,7 +90,7 @@ class ShellNormalDirectionPrediction : public BaseDynamics<void>
 
       public:
         NormalPrediction(SPHBody &sph_body, Real thickness);
-        virtual ~NormalPrediction(){};
+        virtual ~NormalPrediction();
         void update(size_t index_i, Real dt = 0.0);
     };
 
@@ -103,7 +103,7 @@ class ShellNormalDirectionPrediction : public BaseDynamics<void>
 
       public:
         PredictionConvergenceCheck(SPHBody &sph_body, Real convergence_criterion);
-        virtual ~PredictionConvergenceCheck(){};
+        virtual ~PredictionConvergenceCheck();
 
         bool reduce(size_t index_i, Real dt = 0.0);
     };
@@ -112,7 +112,7 @@ class ShellNormalDirectionPrediction : public BaseDynamics<void>
     {
       public:
         explicit ConsistencyCorrection(BaseInnerRelation &inner_relation, Real consistency_criterion);
-        virtual ~ConsistencyCorrection(){};
+        virtual ~ConsistencyCorrection();
 
         void interaction(size_t index_i, Real dt = 0.0);
 
@@ -131,7 +131,7 @@ class ShellNormalDirectionPrediction : public BaseDynamics<void>
 
       public:
         explicit ConsistencyUpdatedCheck(SPHBody &sph_body);
-        virtual ~ConsistencyUpdatedCheck(){};
+        virtual ~ConsistencyUpdatedCheck();
 
         bool reduce(size_t index_i, Real dt = 0.0);
     };
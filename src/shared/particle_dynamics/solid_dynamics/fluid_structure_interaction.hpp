@@ -23,7 +23,7 @@ PressureForceFromFluid<FluidIntegration2ndHalfType>::
         contact_vel_.push_back(contact_particles_[k]->template getVariableDataByName<Vecd>("Velocity"));
         contact_Vol_.push_back(contact_particles_[k]->template getVariableDataByName<Real>("VolumetricMeasure"));
         contact_p_.push_back(contact_particles_[k]->template getVariableDataByName<Real>("Pressure"));
-        contact_force_prior_.push_back(contact_particles_[k]->template getVariableDataByName<Vecd>("ForcePrior"));
+        contact_force_prior_.push_back(contact_particles_[k]->template getStoredVariableByName<Vecd>("ForcePrior"));
         riemann_solvers_.push_back(RiemannSolverType(*contact_fluids_[k], *contact_fluids_[k]));
     }
 }
@@ -39,7 +39,7 @@ void PressureForceFromFluid<FluidIntegration2ndHalfType>::interaction(size_t ind
         StdLargeVec<Real> &mass_k = *(contact_mass_[k]);
         StdLargeVec<Real> &p_k = *(contact_p_[k]);
         StdLargeVec<Vecd> &vel_k = *(contact_vel_[k]);
-        StdLargeVec<Vecd> &force_prior_k = *(contact_force_prior_[k]);
+        StoredVariable<Vecd> &force_prior_k = contact_force_prior_[k];
         RiemannSolverType &riemann_solvers_k = riemann_solvers_[k];
         Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
         for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
@@ -48,7 +48,7 @@ void PressureForceFromFluid<FluidIntegration2ndHalfType>::interaction(size_t ind
             Vecd e_ij = contact_neighborhood.e_ij_[n];
             Real r_ij = contact_neighborhood.r_ij_[n];
             Real face_wall_external_acceleration =
-                (force_prior_k[index_j] / mass_k[index_j] - acc_ave_[index_i]).dot(e_ij);
+                (force_prior_k.value(index_j) / mass_k[index_j] - acc_ave_[index_i]).dot(e_ij);
             Real p_in_wall = p_k[index_j] + rho_n_k[index_j] * r_ij * SMAX(Real(0), face_wall_external_acceleration);
             Real u_jump = 2.0 * (vel_k[index_j] - vel_ave_[index_i]).dot(n_[index_i]);
             force -= (riemann_solvers_k.DissipativePJump(u_jump) * n_[index_i] + (p_in_wall + p_k[index_j]) * e_ij) *
@@ -46,6 +46,28 @@ void ParticleGenerator<BaseParticles>::initializeParticleVariablesFromReload()
     base_particles_.registerPositionAndVolumetricMeasureFromReload();
 }
 //=================================================================================================//
+ParticleGenerator<BaseParticles, Cache>::
+    ParticleGenerator(SPHBody &sph_body, BaseParticles &base_particles, ParticleCacheIO &particle_cache)
+    : ParticleGenerator<BaseParticles>(sph_body, base_particles),
+      file_path_(particle_cache.FilePath()), cache_key_(particle_cache.CacheKey()) {}
+//=================================================================================================//
+void ParticleGenerator<BaseParticles, Cache>::prepareGeometricData()
+{
+    CacheFileReader cache_file_reader(file_path_, cache_key_);
+    if (!cache_file_reader.isValid())
+    {
+        std::cout << "\n Error: the particle cache file:" << file_path_ << " is not valid" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    size_t total_real_particles = cache_file_reader.read<size_t>();
+    position_.resize(total_real_particles);
+    volumetric_measure_.resize(total_real_particles);
+    cache_file_reader.readBytes(position_.data(), total_real_particles * sizeof(Vecd));
+    cache_file_reader.readBytes(volumetric_measure_.data(), total_real_particles * sizeof(Real));
+}
+//=================================================================================================//
 ParticleGenerator<SurfaceParticles>::
     ParticleGenerator(SPHBody &sph_body, SurfaceParticles &surface_particles)
     : ParticleGenerator<BaseParticles>(sph_body, surface_particles),
@@ -102,6 +102,20 @@ class ParticleGenerator<ObserverParticles> : public ParticleGenerator<BasePartic
     StdVec<Vecd> positions_;
 };
 
+class ParticleCacheIO;
+class Cache;
+template <> // generate particles by reading the particles, e.g. relaxed ones, from the geometry cache
+class ParticleGenerator<BaseParticles, Cache> : public ParticleGenerator<BaseParticles>
+{
+    std::string file_path_;
+    uint64_t cache_key_;
+
+  public:
+    ParticleGenerator(SPHBody &sph_body, BaseParticles &base_particles, ParticleCacheIO &particle_cache);
+    virtual ~ParticleGenerator(){};
+    virtual void prepareGeometricData() override;
+};
+
 class Reload;
 template <typename ParticlesType> // generate particles by reloading dynamically relaxed particles
 class ParticleGenerator<ParticlesType, Reload> : public ParticleGenerator<ParticlesType>
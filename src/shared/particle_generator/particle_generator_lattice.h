@@ -50,6 +50,12 @@ class GeneratingMethod<Lattice>
     Real lattice_spacing_;      /**< Initial particle spacing. */
     BoundingBox domain_bounds_; /**< Domain bounds. */
     Shape &initial_shape_;      /**< Geometry shape for body. */
+    const int tile_size_ = 8;   /**< Number of lattice cells along each direction of a tile. */
+
+    /** Lattice positions contained by the initial shape in the order of the nested lattice loops.
+     *  Tiles far outside or deep inside the shape are decided by the signed distance at their centers,
+     *  the cells of the other tiles are checked row by row concurrently and merged in lattice order. */
+    StdLargeVec<Vecd> findLatticePositionsInShape();
 };
 
 template <>
@@ -22,26 +22,84 @@ void Neighborhood::removeANeighbor(size_t neighbor_n)
     e_ij_[neighbor_n] = e_ij_[current_size_];
 }
 //=================================================================================================//
-void NeighborBuilder::createNeighbor(Neighborhood &neighborhood, const Real &distance,
+MemoryUsage configurationMemoryUsage(const ParticleConfiguration &configuration, size_t total_real_particles)
+{
+    MemoryUsage usage = vectorMemoryUsage(configuration, SMIN(total_real_particles, configuration.size()));
+    for (size_t i = 0; i != configuration.size(); ++i)
+    {
+        const Neighborhood &neighborhood = configuration[i];
+        size_t used_size = i < total_real_particles ? neighborhood.current_size_ : 0;
+        usage += vectorMemoryUsage(neighborhood.j_, used_size);
+        usage += vectorMemoryUsage(neighborhood.W_ij_, used_size);
+        usage += vectorMemoryUsage(neighborhood.dW_ij_, used_size);
+        usage += vectorMemoryUsage(neighborhood.r_ij_, used_size);
+        usage += vectorMemoryUsage(neighborhood.e_ij_, used_size);
+    }
+    return usage;
+}
+//=================================================================================================//
+template <class KernelEvaluation>
+void NeighborBuilder::createNeighbor(const KernelEvaluation &kernel, Neighborhood &neighborhood,
+                                     const Real &distance, const Vecd &displacement, size_t index_j)
+{
+    neighborhood.j_.push_back(index_j);
+    neighborhood.W_ij_.push_back(kernel.W(distance, displacement));
+    neighborhood.dW_ij_.push_back(kernel.dW(distance, displacement));
+    neighborhood.r_ij_.push_back(distance);
+    neighborhood.e_ij_.push_back(kernel.e(distance, displacement));
+    neighborhood.allocated_size_++;
+}
+//=================================================================================================//
+template <class KernelEvaluation>
+void NeighborBuilder::initializeNeighbor(const KernelEvaluation &kernel, Neighborhood &neighborhood,
+                                         const Real &distance, const Vecd &displacement, size_t index_j)
+{
+    size_t current_size = neighborhood.current_size_;
+    neighborhood.j_[current_size] = index_j;
+    neighborhood.W_ij_[current_size] = kernel.W(distance, displacement);
+    neighborhood.dW_ij_[current_size] = kernel.dW(distance, displacement);
+    neighborhood.r_ij_[current_size] = distance;
+    neighborhood.e_ij_[current_size] = kernel.e(distance, displacement);
+}
+//=================================================================================================//
+template <class KernelType>
+void NeighborBuilder::createNeighbor(const InlinedKernel<AnisotropicKernel<KernelType>> &kernel,
+                                     Neighborhood &neighborhood, const Real &distance,
                                      const Vecd &displacement, size_t index_j)
 {
+    Real W_ij, dW_ij;
+    Vecd e_ij;
+    kernel.evaluatePair(displacement, W_ij, dW_ij, e_ij);
     neighborhood.j_.push_back(index_j);
-    neighborhood.W_ij_.push_back(kernel_->W(distance, displacement));
-    neighborhood.dW_ij_.push_back(kernel_->dW(distance, displacement));
+    neighborhood.W_ij_.push_back(W_ij);
+    neighborhood.dW_ij_.push_back(dW_ij);
     neighborhood.r_ij_.push_back(distance);
-    neighborhood.e_ij_.push_back(kernel_->e(distance, displacement));
+    neighborhood.e_ij_.push_back(e_ij);
     neighborhood.allocated_size_++;
 }
 //=================================================================================================//
-void NeighborBuilder::initializeNeighbor(Neighborhood &neighborhood, const Real &distance,
+template <class KernelType>
+void NeighborBuilder::initializeNeighbor(const InlinedKernel<AnisotropicKernel<KernelType>> &kernel,
+                                         Neighborhood &neighborhood, const Real &distance,
                                          const Vecd &displacement, size_t index_j)
 {
     size_t current_size = neighborhood.current_size_;
     neighborhood.j_[current_size] = index_j;
-    neighborhood.W_ij_[current_size] = kernel_->W(distance, displacement);
-    neighborhood.dW_ij_[current_size] = kernel_->dW(distance, displacement);
+    kernel.evaluatePair(displacement, neighborhood.W_ij_[current_size],
+                        neighborhood.dW_ij_[current_size], neighborhood.e_ij_[current_size]);
     neighborhood.r_ij_[current_size] = distance;
-    neighborhood.e_ij_[current_size] = kernel_->e(distance, displacement);
+}
+//=================================================================================================//
+void NeighborBuilder::createNeighbor(Neighborhood &neighborhood, const Real &distance,
+                                     const Vecd &displacement, size_t index_j)
+{
+    createNeighbor(InlinedKernel<Kernel>(*kernel_), neighborhood, distance, displacement, index_j);
+}
+//=================================================================================================//
+void NeighborBuilder::initializeNeighbor(Neighborhood &neighborhood, const Real &distance,
+                                         const Vecd &displacement, size_t index_j)
+{
+    initializeNeighbor(InlinedKernel<Kernel>(*kernel_), neighborhood, distance, displacement, index_j);
 }
 //=================================================================================================//
 void NeighborBuilder::createNeighbor(Neighborhood &neighborhood, const Real &distance,
@@ -79,21 +137,31 @@ Kernel *NeighborBuilder::chooseKernel(SPHBody &body, SPHBody &target_body)
 }
 //=================================================================================================//
 NeighborBuilderInner::NeighborBuilderInner(SPHBody &body)
-    : NeighborBuilder(body.sph_adaptation_->getKernel()) {}
+    : NeighborBuilder(body.sph_adaptation_->getKernel()),
+      dispatched_kernel_(dispatchKernel(*kernel_)) {}
 //=================================================================================================//
-void NeighborBuilderInner::operator()(Neighborhood &neighborhood,
-                                      const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+template <class KernelEvaluation>
+void NeighborBuilderInner::buildNeighbor(const KernelEvaluation &kernel, Neighborhood &neighborhood,
+                                         const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
 {
     size_t index_j = list_data_j.first;
     Vecd displacement = pos_i - list_data_j.second;
     Real distance_metric = displacement.squaredNorm();
-    if (kernel_->checkIfWithinCutOffRadius(displacement) && index_i != index_j)
+    if (kernel.checkIfWithinCutOffRadius(displacement) && index_i != index_j)
     {
         neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, std::sqrt(distance_metric), displacement, index_j)
-            : initializeNeighbor(neighborhood, std::sqrt(distance_metric), displacement, index_j);
+            ? createNeighbor(kernel, neighborhood, std::sqrt(distance_metric), displacement, index_j)
+            : initializeNeighbor(kernel, neighborhood, std::sqrt(distance_metric), displacement, index_j);
         neighborhood.current_size_++;
     }
+}
+//=================================================================================================//
+void NeighborBuilderInner::operator()(Neighborhood &neighborhood,
+                                      const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+{
+    std::visit([&](const auto &kernel)
+               { buildNeighbor(kernel, neighborhood, pos_i, index_i, list_data_j); },
+               dispatched_kernel_);
 };
 //=================================================================================================//
 NeighborBuilderInnerAdaptive::
@@ -141,10 +209,12 @@ void NeighborBuilderSelfContact::operator()(Neighborhood &neighborhood,
 };
 //=================================================================================================//
 NeighborBuilderContact::NeighborBuilderContact(SPHBody &body, SPHBody &contact_body)
-    : NeighborBuilder(NeighborBuilder::chooseKernel(body, contact_body)) {}
+    : NeighborBuilder(NeighborBuilder::chooseKernel(body, contact_body)),
+      dispatched_kernel_(dispatchKernel(*kernel_)) {}
 //=================================================================================================//
-void NeighborBuilderContact::operator()(Neighborhood &neighborhood,
-                                        const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+template <class KernelEvaluation>
+void NeighborBuilderContact::buildNeighbor(const KernelEvaluation &kernel, Neighborhood &neighborhood,
+                                           const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
 {
     size_t index_j = list_data_j.first;
     Vecd displacement = pos_i - list_data_j.second;
@@ -152,10 +222,18 @@ void NeighborBuilderContact::operator()(Neighborhood &neighborhood,
     if (distance < kernel_->CutOffRadius())
     {
         neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, distance, displacement, index_j)
-            : initializeNeighbor(neighborhood, distance, displacement, index_j);
+            ? createNeighbor(kernel, neighborhood, distance, displacement, index_j)
+            : initializeNeighbor(kernel, neighborhood, distance, displacement, index_j);
         neighborhood.current_size_++;
     }
+}
+//=================================================================================================//
+void NeighborBuilderContact::operator()(Neighborhood &neighborhood,
+                                        const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+{
+    std::visit([&](const auto &kernel)
+               { buildNeighbor(kernel, neighborhood, pos_i, index_i, list_data_j); },
+               dispatched_kernel_);
 };
 //=================================================================================================//
 NeighborBuilderSurfaceContact::NeighborBuilderSurfaceContact(SPHBody &body, SPHBody &contact_body)
@@ -164,6 +242,7 @@ NeighborBuilderSurfaceContact::NeighborBuilderSurfaceContact(SPHBody &body, SPHB
     Real source_smoothing_length = body.sph_adaptation_->ReferenceSmoothingLength();
     Real target_smoothing_length = contact_body.sph_adaptation_->ReferenceSmoothingLength();
     kernel_ = kernel_keeper_.createPtr<KernelWendlandC2>(0.5 * (source_smoothing_length + target_smoothing_length));
+    dispatched_kernel_ = dispatchKernel(*kernel_);
 }
 //=================================================================================================//
 NeighborBuilderContactBodyPart::NeighborBuilderContactBodyPart(SPHBody &body, BodyPart &contact_body_part)
@@ -397,6 +476,7 @@ ShellNeighborBuilderInnerWithContactKernel::ShellNeighborBuilderInnerWithContact
     Real smoothing_length = contact_body.sph_adaptation_->ReferenceSmoothingLength();
     kernel_ = kernel_keeper_.createPtr<KernelWendlandC2>(smoothing_length);
     kernel_->reduceOnce();
+    dispatched_kernel_ = dispatchKernel(*kernel_);
 }
 //=================================================================================================//
 NeighborBuilderShellSelfContact::
@@ -33,6 +33,7 @@
 
 #include "all_kernels.h"
 #include "base_data_package.h"
+#include "memory_report.h"
 #include "sph_data_containers.h"
 
 namespace SPH
@@ -64,6 +65,8 @@ class Neighborhood
     void removeANeighbor(size_t neighbor_n);
 };
 using ParticleConfiguration = StdLargeVec<Neighborhood>;
+/** memory allocated and used by the neighborhoods of the first given number of particles */
+MemoryUsage configurationMemoryUsage(const ParticleConfiguration &configuration, size_t total_real_particles);
 
 /**
  * @class NeighborBuilder
@@ -78,6 +81,20 @@ class NeighborBuilder
     //----------------------------------------------------------------------
     void createNeighbor(Neighborhood &neighborhood, const Real &distance, const Vecd &displacement, size_t j_index);
     void initializeNeighbor(Neighborhood &neighborhood, const Real &distance, const Vecd &displacement, size_t j_index);
+    /** the same as above but with a statically dispatched kernel, see InlinedKernel */
+    template <class KernelEvaluation>
+    void createNeighbor(const KernelEvaluation &kernel, Neighborhood &neighborhood,
+                        const Real &distance, const Vecd &displacement, size_t j_index);
+    template <class KernelEvaluation>
+    void initializeNeighbor(const KernelEvaluation &kernel, Neighborhood &neighborhood,
+                            const Real &distance, const Vecd &displacement, size_t j_index);
+    /** the same as above but for anisotropic kernels with the displacement transformed once */
+    template <class KernelType>
+    void createNeighbor(const InlinedKernel<AnisotropicKernel<KernelType>> &kernel, Neighborhood &neighborhood,
+                        const Real &distance, const Vecd &displacement, size_t j_index);
+    template <class KernelType>
+    void initializeNeighbor(const InlinedKernel<AnisotropicKernel<KernelType>> &kernel, Neighborhood &neighborhood,
+                            const Real &distance, const Vecd &displacement, size_t j_index);
     //----------------------------------------------------------------------
     //	Below are for variable smoothing length.
     //----------------------------------------------------------------------
@@ -104,6 +121,13 @@ class NeighborBuilderInner : public NeighborBuilder
     explicit NeighborBuilderInner(SPHBody &body);
     void operator()(Neighborhood &neighborhood,
                     const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+
+  protected:
+    DispatchedKernel dispatched_kernel_; /**< to be reset when the kernel is replaced */
+
+    template <class KernelEvaluation>
+    void buildNeighbor(const KernelEvaluation &kernel, Neighborhood &neighborhood,
+                       const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
 };
 
 /**
@@ -148,6 +172,13 @@ class NeighborBuilderContact : public NeighborBuilder
     virtual ~NeighborBuilderContact(){};
     virtual void operator()(Neighborhood &neighborhood,
                             const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+
+  protected:
+    DispatchedKernel dispatched_kernel_; /**< to be reset when the kernel is replaced */
+
+    template <class KernelEvaluation>
+    void buildNeighbor(const KernelEvaluation &kernel, Neighborhood &neighborhood,
+                       const Vecd &pos_i, size_t index_i, const ListData &list_data_j);
 };
 
 /**
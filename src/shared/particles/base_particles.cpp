@@ -6,6 +6,8 @@
 #include "base_particle_generator.h"
 #include "xml_parser.h"
 
+#include "tbb/parallel_scan.h"
+
 namespace SPH
 {
 //=================================================================================================//
@@ -21,7 +23,12 @@ BaseParticles::BaseParticles(SPHBody &sph_body, BaseMaterial *base_material)
       copy_particle_state_(all_state_data_),
       write_restart_variable_to_xml_(variables_to_restart_, restart_xml_parser_),
       write_reload_variable_to_xml_(variables_to_reload_, reload_xml_parser_),
-      read_restart_variable_from_xml_(variables_to_restart_, restart_xml_parser_)
+      read_restart_variable_from_xml_(variables_to_restart_, restart_xml_parser_),
+      add_restart_variable_to_manifest_(variables_to_restart_),
+      write_restart_variable_to_binary_(variables_to_restart_),
+      read_restart_variable_from_binary_(variables_to_restart_),
+      report_variable_memory_(all_discrete_variables_),
+      resize_particle_variables_(all_discrete_variables_)
 {
     sph_body.assignBaseParticles(this);
 }
@@ -76,6 +83,7 @@ void BaseParticles::increaseAllParticlesBounds(size_t buffer_size)
 {
     real_particles_bound_ += buffer_size;
     particles_bound_ += buffer_size;
+    resize_particle_variables_(particles_bound_);
 }
 //=================================================================================================//
 void BaseParticles::copyFromAnotherParticle(size_t index, size_t another_index)
@@ -87,6 +95,7 @@ size_t BaseParticles::allocateGhostParticles(size_t ghost_size)
 {
     size_t ghost_lower_bound = particles_bound_;
     particles_bound_ += ghost_size;
+    resize_particle_variables_(particles_bound_);
     return ghost_lower_bound;
 }
 //=================================================================================================//
@@ -120,6 +129,99 @@ void BaseParticles::createRealParticleFrom(size_t index)
     total_real_particles_ += 1;
 }
 //=================================================================================================//
+void BaseParticles::switchToBufferParticles(const ConcurrentIndexVector &indices)
+{
+    StdLargeVec<size_t> sorted_indices(indices.begin(), indices.end());
+    std::sort(sorted_indices.begin(), sorted_indices.end());
+    sorted_indices.erase(std::unique(sorted_indices.begin(), sorted_indices.end()), sorted_indices.end());
+    size_t number_of_deleted = sorted_indices.size();
+    if (number_of_deleted == 0)
+        return;
+
+    size_t new_total_real_particles = total_real_particles_ - number_of_deleted;
+    /** The deleted particles within the new real particle range leave holes,
+     *  which are filled by the remaining particles beyond this range.
+     *  The two sets have the same size, and the latter is obtained by a prefix sum. */
+    size_t number_of_holes = std::lower_bound(sorted_indices.begin(), sorted_indices.end(),
+                                              new_total_real_particles) -
+                             sorted_indices.begin();
+    StdLargeVec<size_t> is_remaining(number_of_deleted, 1);
+    parallel_for(
+        IndexRange(number_of_holes, number_of_deleted),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+            {
+                is_remaining[sorted_indices[k] - new_total_real_particles] = 0;
+            }
+        },
+        ap);
+
+    StdLargeVec<size_t> remaining_indices(number_of_holes);
+    tbb::parallel_scan(
+        IndexRange(0, number_of_deleted), size_t(0),
+        [&](const IndexRange &r, size_t sum, bool is_final_scan) -> size_t
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                if (is_final_scan && is_remaining[i] == 1)
+                {
+                    remaining_indices[sum] = new_total_real_particles + i;
+                }
+                sum += is_remaining[i];
+            }
+            return sum;
+        },
+        [](size_t left, size_t right) -> size_t
+        { return left + right; });
+
+    parallel_for(
+        IndexRange(0, number_of_holes),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+            {
+                size_t index = sorted_indices[k];
+                size_t remaining_index = remaining_indices[k];
+                copyFromAnotherParticle(index, remaining_index);
+                // update original and sorted_id as well
+                std::swap((*original_id_)[index], (*original_id_)[remaining_index]);
+                (*sorted_id_)[(*original_id_)[index]] = index;
+            }
+        },
+        ap);
+    total_real_particles_ = new_total_real_particles;
+}
+//=================================================================================================//
+void BaseParticles::createRealParticlesFrom(const ConcurrentIndexVector &indices)
+{
+    StdLargeVec<size_t> sorted_indices(indices.begin(), indices.end());
+    std::sort(sorted_indices.begin(), sorted_indices.end());
+    size_t number_of_new_particles = sorted_indices.size();
+    if (total_real_particles_ + number_of_new_particles > real_particles_bound_)
+    {
+        std::cout << "\n ERROR: Not enough buffer particles have been reserved!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    size_t first_new_index = total_real_particles_;
+    parallel_for(
+        IndexRange(0, number_of_new_particles),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+            {
+                size_t new_original_id = first_new_index + k;
+                (*original_id_)[new_original_id] = new_original_id;
+                /** Buffer Particle state copied from real particle. */
+                copyFromAnotherParticle(new_original_id, sorted_indices[k]);
+            }
+        },
+        ap);
+    total_real_particles_ += number_of_new_particles;
+}
+//=================================================================================================//
 void BaseParticles::writePltFileHeader(std::ofstream &output_file)
 {
     output_file << " VARIABLES = \"x\",\"y\",\"z\",\"ID\"";
@@ -212,6 +314,142 @@ void BaseParticles::readParticleFromXmlForRestart(std::string &filefullpath)
     read_restart_variable_from_xml_(this);
 }
 //=================================================================================================//
+void BaseParticles::writeParticlesToBinaryForRestart(const std::string &filefullpath, Real physical_time,
+                                                     bool is_incremental, bool is_change_tracked)
+{
+    StdVec<BinaryRestartEntry> manifest;
+    add_restart_variable_to_manifest_(manifest, total_real_particles_, is_incremental || is_change_tracked);
+
+    // the arrays unchanged since the last full restart file are referred to it,
+    // only if they also have the same type and size in bytes
+    bool is_full = true;
+    if (is_incremental)
+    {
+        for (BinaryRestartEntry &entry : manifest)
+        {
+            for (BinaryRestartEntry &full_entry : last_full_binary_restart_manifest_)
+            {
+                if (full_entry.name_ == entry.name_ && full_entry.type_index_ == entry.type_index_ &&
+                    full_entry.data_size_ == entry.data_size_ &&
+                    full_entry.number_of_entries_ == entry.number_of_entries_ && full_entry.hash_ == entry.hash_)
+                {
+                    entry.source_file_ = full_entry.source_file_;
+                    entry.offset_ = full_entry.offset_;
+                    is_full = false;
+                }
+            }
+        }
+    }
+
+    // the arrays follow the manifest and start at cache-line aligned positions in the file
+    size_t offset = sizeof(Real) + 2 * sizeof(size_t);
+    for (BinaryRestartEntry &entry : manifest)
+    {
+        offset += 2 * sizeof(size_t) + entry.name_.size() + entry.source_file_.size() +
+                  2 * sizeof(uint32_t) + 2 * sizeof(size_t) + sizeof(uint64_t);
+    }
+    const size_t alignment = 64;
+    for (BinaryRestartEntry &entry : manifest)
+    {
+        if (entry.source_file_.empty())
+        {
+            size_t file_position = sizeof(CacheFileHeader) + offset;
+            offset += (alignment - file_position % alignment) % alignment;
+            entry.offset_ = offset;
+            offset += entry.data_size_ * entry.number_of_entries_;
+        }
+    }
+
+    CacheFileWriter cache_file_writer(filefullpath, binary_restart_file_key_);
+    cache_file_writer.write(physical_time);
+    cache_file_writer.write(total_real_particles_);
+    cache_file_writer.write(manifest.size());
+    for (BinaryRestartEntry &entry : manifest)
+    {
+        cache_file_writer.write(entry.name_);
+        cache_file_writer.write(entry.type_index_);
+        cache_file_writer.write(entry.data_size_);
+        cache_file_writer.write(entry.number_of_entries_);
+        cache_file_writer.write(entry.hash_);
+        cache_file_writer.write(entry.source_file_);
+        cache_file_writer.write(entry.offset_);
+    }
+    write_restart_variable_to_binary_(cache_file_writer, manifest);
+
+    if (!cache_file_writer.commit())
+    {
+        std::cout << "\n Error: the restart file " << filefullpath << " can not be written!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    // a restart file holding all its arrays, incremental or not, is the reference of the following ones
+    if (is_full)
+    {
+        std::string file_name = fs::path(filefullpath).filename().string();
+        for (BinaryRestartEntry &entry : manifest)
+        {
+            entry.source_file_ = file_name;
+        }
+        last_full_binary_restart_manifest_ = manifest;
+    }
+}
+//=================================================================================================//
+Real BaseParticles::readParticlesFromBinaryForRestart(const std::string &filefullpath)
+{
+    CacheFileReader cache_file_reader(filefullpath, binary_restart_file_key_);
+    if (!cache_file_reader.isValid())
+    {
+        std::cout << "\n Error: the restart file " << filefullpath
+                  << " is missing, corrupted or written by an incompatible build!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    Real physical_time = cache_file_reader.read<Real>();
+    size_t total_real_particles = cache_file_reader.read<size_t>();
+    if (total_real_particles > real_particles_bound_)
+    {
+        std::cout << "\n Error: the restart file " << filefullpath << " has more particles than allowed!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    total_real_particles_ = total_real_particles;
+
+    StdVec<BinaryRestartEntry> manifest(cache_file_reader.read<size_t>());
+    for (BinaryRestartEntry &entry : manifest)
+    {
+        cache_file_reader.read(entry.name_);
+        cache_file_reader.read(entry.type_index_);
+        cache_file_reader.read(entry.data_size_);
+        cache_file_reader.read(entry.number_of_entries_);
+        cache_file_reader.read(entry.hash_);
+        cache_file_reader.read(entry.source_file_);
+        cache_file_reader.read(entry.offset_);
+    }
+    // the source files of the unchanged arrays are in the same folder
+    std::string folder = fs::path(filefullpath).parent_path().string();
+    std::map<std::string, CacheFileReader> source_file_readers;
+    for (BinaryRestartEntry &entry : manifest)
+    {
+        if (entry.source_file_.empty() || source_file_readers.count(entry.source_file_) != 0)
+            continue;
+
+        std::string source_filefullpath = (folder.empty() ? "." : folder) + "/" + entry.source_file_;
+        auto source_file_reader = source_file_readers.try_emplace(entry.source_file_, source_filefullpath,
+                                                                  binary_restart_file_key_);
+        if (!source_file_reader.first->second.isValid())
+        {
+            std::cout << "\n Error: the restart file " << entry.source_file_ << " holding the variable '"
+                      << entry.name_ << "' is missing or corrupted!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+    read_restart_variable_from_binary_(cache_file_reader, manifest, source_file_readers, this);
+    return physical_time;
+}
+//=================================================================================================//
 void BaseParticles::writeToXmlForReloadParticle(std::string &filefullpath)
 {
     resizeXmlDocForParticles(reload_xml_parser_);
@@ -226,4 +464,24 @@ XmlParser &BaseParticles::readReloadXmlFile(const std::string &filefullpath)
     return reload_xml_parser_;
 }
 //=================================================================================================//
+void BaseParticles::reportMemoryUsage(MemoryReport &memory_report)
+{
+    report_variable_memory_(memory_report, body_name_, total_real_particles_);
+
+    // tinyxml2 allocates from memory pools of its own, so only the elements and attributes are counted
+    auto xml_document_usage = [](XmlParser &xml_parser) -> MemoryUsage
+    {
+        size_t bytes = 0;
+        for (auto child = xml_parser.first_element_->FirstChildElement(); child; child = child->NextSiblingElement())
+        {
+            bytes += sizeof(tinyxml2::XMLElement);
+            for (auto attribute = child->FirstAttribute(); attribute; attribute = attribute->Next())
+                bytes += sizeof(tinyxml2::XMLAttribute);
+        }
+        return MemoryUsage(bytes, bytes, true);
+    };
+    memory_report.addEntry(body_name_, "io", "restart_xml", xml_document_usage(restart_xml_parser_));
+    memory_report.addEntry(body_name_, "io", "reload_xml", xml_document_usage(reload_xml_parser_));
+}
+//=================================================================================================//
 } // namespace SPH
@@ -35,11 +35,14 @@
 
 #include "base_data_package.h"
 #include "base_variable.h"
+#include "cache_file.h"
+#include "memory_report.h"
 #include "particle_sorting.h"
 #include "sph_data_containers.h"
 #include "xml_parser.h"
 
 #include <fstream>
+#include <map>
 
 namespace SPH
 {
@@ -120,18 +123,34 @@ class BaseParticles
     void updateGhostParticle(size_t ghost_index, size_t index);
     void switchToBufferParticle(size_t index);
     void createRealParticleFrom(size_t index);
+    /** batched version of switchToBufferParticle,
+     *  the real particles marked for deletion are replaced by a parallel compaction of the remaining ones. */
+    void switchToBufferParticles(const ConcurrentIndexVector &indices);
+    /** batched version of createRealParticleFrom, new particles are appended in the ascending order of their sources. */
+    void createRealParticlesFrom(const ConcurrentIndexVector &indices);
     //----------------------------------------------------------------------
     // Parameterized management on particle variables and data
     //----------------------------------------------------------------------
   private:
     template <typename DataType>
     DiscreteVariable<DataType> *addSharedVariable(const std::string &name);
+    /** a variable can not be registered with both full and reduced storage precision */
+    template <typename DataType>
+    void checkStoragePrecision(const std::string &name);
+    /** whether the variable has been registered with ReducedData<DataType> instead of DataType */
+    template <typename DataType>
+    bool isStoredInReducedPrecision(const std::string &name);
     template <typename DataType>
     StdLargeVec<DataType> *initializeVariable(DiscreteVariable<DataType> *variable, DataType initial_value = ZeroData<DataType>::value);
     template <typename DataType, class InitializationFunction>
     StdLargeVec<DataType> *initializeVariable(DiscreteVariable<DataType> *variable, const InitializationFunction &initialization);
+    template <typename DataType, typename... Args>
+    void allocateSharedVariable(DiscreteVariable<DataType> *variable, Args &&...args);
 
   public:
+    /** The storage precision is chosen here, e.g. registerSharedVariable<ReducedData<Vecd>>("ForcePrior")
+     *  stores the variable in single precision, see ReducedPrecision in base_data_type.h.
+     *  The variable lists for sorting and output follow the precision of a variable registered in this way. */
     template <typename DataType, typename... Args>
     StdLargeVec<DataType> *registerSharedVariable(const std::string &name, Args &&...args);
     template <typename DataType>
@@ -140,10 +159,25 @@ class BaseParticles
     StdLargeVec<DataType> *registerSharedVariableFrom(const std::string &name, const StdLargeVec<DataType> &geometric_data);
     template <typename DataType>
     StdLargeVec<DataType> *registerSharedVariableFromReload(const std::string &name);
+    /** register a variable only used by some dynamics, such as those for particle relaxation,
+     *  the data is allocated when the first user registers and released after the last user releases it.
+     *  Note that the data of a transient variable is kept if it is registered as a shared one,
+     *  or required for output, restart, reload or sorting. */
+    template <typename DataType, typename... Args>
+    StdLargeVec<DataType> *registerTransientVariable(const std::string &name, Args &&...args);
+    template <typename DataType>
+    void releaseTransientVariable(const std::string &name);
     template <typename DataType>
     DiscreteVariable<DataType> *getVariableByName(const std::string &name);
     template <typename DataType>
     StdLargeVec<DataType> *getVariableDataByName(const std::string &name);
+    /** As registerSharedVariable and getVariableDataByName, but the data are accessed as DataType
+     *  even if the variable has been registered before with ReducedData<DataType>, see StoredVariable.
+     *  Such dynamics, e.g. the fluid integration, thereby work with both storage precisions. */
+    template <typename DataType>
+    StoredVariable<DataType> registerStoredVariable(const std::string &name);
+    template <typename DataType>
+    StoredVariable<DataType> getStoredVariableByName(const std::string &name);
 
     template <typename DataType>
     DataType *registerSingleVariable(const std::string &name,
@@ -157,6 +191,7 @@ class BaseParticles
     DiscreteVariable<DataType> *addVariableToList(ParticleVariables &variable_set, const std::string &name);
     template <typename DataType>
     void addVariableToWrite(const std::string &name);
+    inline const ParticleVariables &getVariablesToWrite() const { return variables_to_write_; }
     template <typename DataType>
     void addVariableToRestart(const std::string &name);
     inline const ParticleVariables &getVariablesToRestart() const { return variables_to_restart_; }
@@ -193,10 +228,23 @@ class BaseParticles
     void resizeXmlDocForParticles(XmlParser &xml_parser);
     void writeParticlesToXmlForRestart(std::string &filefullpath);
     void readParticleFromXmlForRestart(std::string &filefullpath);
+    /** Binary restart file with a manifest of the restart variables (name, type, count and offset)
+     *  followed by their raw arrays aligned in the file. It is read through a memory map
+     *  and accepted only if its checksum matches. An incremental restart file only holds
+     *  the variables changed since the last full restart file, i.e. the last one holding all its arrays,
+     *  and the manifest refers to that file for the unchanged ones, so that an incremental file
+     *  never depends on another incremental one. The arrays are only hashed for detecting the changes
+     *  if is_change_tracked, which is implied by is_incremental. */
+    void writeParticlesToBinaryForRestart(const std::string &filefullpath, Real physical_time,
+                                          bool is_incremental = false, bool is_change_tracked = false);
+    /** read the restart variables and the number of real particles, return the physical time */
+    Real readParticlesFromBinaryForRestart(const std::string &filefullpath);
     void writeToXmlForReloadParticle(std::string &filefullpath);
     XmlParser &readReloadXmlFile(const std::string &filefullpath);
     template <typename OwnerType>
     void checkReloadFileRead(OwnerType *owner);
+    /** add the memory allocated and used by the particle variables and xml documents to the report */
+    void reportMemoryUsage(MemoryReport &memory_report);
     //----------------------------------------------------------------------
     // Function related to geometric variables and their relations
     //----------------------------------------------------------------------
@@ -257,9 +305,63 @@ class BaseParticles
         void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables, BaseParticles *base_particles);
     };
 
+    struct BinaryRestartEntry
+    {
+        std::string name_;
+        uint32_t type_index_;
+        uint32_t data_size_;
+        size_t number_of_entries_;
+        uint64_t hash_;           /**< of the array, zero if the changes are not tracked */
+        std::string source_file_; /**< holding the array, empty for the restart file itself */
+        size_t offset_;           /**< of the array in the payload of the source file */
+    };
+    StdVec<BinaryRestartEntry> last_full_binary_restart_manifest_; /**< with the source file of the arrays */
+    /** distinguishes binary restart files from the other files with the cache file layout */
+    static constexpr uint64_t binary_restart_file_key_ = 0x5350485253544152ULL;
+
+    struct AddAParticleVariableToManifest
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        StdVec<BinaryRestartEntry> &manifest, size_t number_of_entries, bool is_hashed);
+    };
+
+    struct WriteAParticleVariableToBinary
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        CacheFileWriter &cache_file_writer, StdVec<BinaryRestartEntry> &manifest);
+    };
+
+    struct ReadAParticleVariableFromBinary
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        CacheFileReader &cache_file_reader, StdVec<BinaryRestartEntry> &manifest,
+                        std::map<std::string, CacheFileReader> &source_file_readers, BaseParticles *base_particles);
+    };
+
+    struct ResizeAParticleVariable
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables, size_t new_size);
+    };
+
+    struct ReportAParticleVariableMemory
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        MemoryReport &memory_report, const std::string &body_name, size_t used_size);
+    };
+
     OperationOnDataAssemble<ParticleData, CopyParticleState> copy_particle_state_;
     OperationOnDataAssemble<ParticleVariables, WriteAParticleVariableToXml> write_restart_variable_to_xml_, write_reload_variable_to_xml_;
     OperationOnDataAssemble<ParticleVariables, ReadAParticleVariableFromXml> read_restart_variable_from_xml_;
+    OperationOnDataAssemble<ParticleVariables, AddAParticleVariableToManifest> add_restart_variable_to_manifest_;
+    OperationOnDataAssemble<ParticleVariables, WriteAParticleVariableToBinary> write_restart_variable_to_binary_;
+    OperationOnDataAssemble<ParticleVariables, ReadAParticleVariableFromBinary> read_restart_variable_from_binary_;
+    OperationOnDataAssemble<ParticleVariables, ReportAParticleVariableMemory> report_variable_memory_;
+    OperationOnDataAssemble<ParticleVariables, ResizeAParticleVariable> resize_particle_variables_;
 };
 } // namespace SPH
 #endif // BASE_PARTICLES_H
@@ -21,7 +21,7 @@ template <typename DataType>
 StdLargeVec<DataType> *BaseParticles::
     initializeVariable(DiscreteVariable<DataType> *variable, DataType initial_value)
 {
-    if (variable->DataField() == nullptr)
+    if (variable->DataField() == nullptr || variable->isDataReleased())
     {
         variable->allocateDataField(particles_bound_, initial_value);
     }
@@ -82,18 +82,44 @@ DiscreteVariable<DataType> *BaseParticles::addSharedVariable(const std::string &
     DiscreteVariable<DataType> *variable = findVariableByName<DataType>(all_discrete_variables_, name);
     if (variable == nullptr)
     {
+        checkStoragePrecision<DataType>(name);
         variable = addVariableToAssemble<DataType>(all_discrete_variables_, all_discrete_variable_ptrs_, name);
     }
     return variable;
 }
 //=================================================================================================//
+template <typename DataType>
+void BaseParticles::checkStoragePrecision(const std::string &name)
+{
+    using ComputingType = ComputingData<DataType>;
+    using OtherPrecisionType = std::conditional_t<std::is_same_v<DataType, ComputingType>,
+                                                  ReducedData<ComputingType>, ComputingType>;
+    if constexpr (!std::is_same_v<OtherPrecisionType, DataType>)
+    {
+        if (findVariableByName<OtherPrecisionType>(all_discrete_variables_, name) != nullptr)
+        {
+            std::cout << "\n Error: the variable '" << name
+                      << "' has already been registered with another storage precision!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+bool BaseParticles::isStoredInReducedPrecision(const std::string &name)
+{
+    if constexpr (std::is_same_v<ReducedData<DataType>, DataType>)
+        return false;
+    else
+        return findVariableByName<DataType>(all_discrete_variables_, name) == nullptr &&
+               findVariableByName<ReducedData<DataType>>(all_discrete_variables_, name) != nullptr;
+}
+//=================================================================================================//
 template <typename DataType, typename... Args>
-StdLargeVec<DataType> *BaseParticles::registerSharedVariable(const std::string &name, Args &&...args)
+void BaseParticles::allocateSharedVariable(DiscreteVariable<DataType> *variable, Args &&...args)
 {
-
-    DiscreteVariable<DataType> *variable = addSharedVariable<DataType>(name);
-
-    if (variable->DataField() == nullptr)
+    if (variable->DataField() == nullptr || variable->isDataReleased())
     {
         initializeVariable(variable, std::forward<Args>(args)...);
         constexpr int type_index = DataTypeIndex<DataType>::value;
@@ -102,11 +128,56 @@ StdLargeVec<DataType> *BaseParticles::registerSharedVariable(const std::string &
             std::get<type_index>(all_state_data_).push_back(variable->DataField());
         }
     }
+}
+//=================================================================================================//
+template <typename DataType, typename... Args>
+StdLargeVec<DataType> *BaseParticles::registerSharedVariable(const std::string &name, Args &&...args)
+{
+
+    DiscreteVariable<DataType> *variable = addSharedVariable<DataType>(name);
+    allocateSharedVariable(variable, std::forward<Args>(args)...);
+    variable->setLifetime(VariableLifetime::Persistent);
+
+    return variable->DataField();
+}
+//=================================================================================================//
+template <typename DataType, typename... Args>
+StdLargeVec<DataType> *BaseParticles::registerTransientVariable(const std::string &name, Args &&...args)
+{
+    DiscreteVariable<DataType> *variable = findVariableByName<DataType>(all_discrete_variables_, name);
+    if (variable == nullptr)
+    {
+        variable = addSharedVariable<DataType>(name);
+        variable->setLifetime(VariableLifetime::Transient);
+    }
+    allocateSharedVariable(variable, std::forward<Args>(args)...);
+    variable->addUser();
 
     return variable->DataField();
 }
 //=================================================================================================//
 template <typename DataType>
+void BaseParticles::releaseTransientVariable(const std::string &name)
+{
+    DiscreteVariable<DataType> *variable = getVariableByName<DataType>(name);
+    if (variable->Lifetime() != VariableLifetime::Transient || variable->removeUser() != 0 ||
+        variable->isDataReleased())
+        return;
+
+    bool is_data_required = findVariableByName<DataType>(variables_to_write_, name) != nullptr ||
+                            findVariableByName<DataType>(variables_to_restart_, name) != nullptr ||
+                            findVariableByName<DataType>(variables_to_reload_, name) != nullptr ||
+                            findVariableByName<DataType>(sortable_variables_, name) != nullptr;
+    if (!is_data_required)
+    {
+        constexpr int type_index = DataTypeIndex<DataType>::value;
+        auto &state_data = std::get<type_index>(all_state_data_);
+        state_data.erase(std::remove(state_data.begin(), state_data.end(), variable->DataField()), state_data.end());
+        variable->releaseDataField();
+    }
+}
+//=================================================================================================//
+template <typename DataType>
 StdLargeVec<DataType> *BaseParticles::registerSharedVariableFrom(
     const std::string &new_name, const std::string &old_name)
 {
@@ -172,10 +243,33 @@ StdLargeVec<DataType> *BaseParticles::getVariableDataByName(const std::string &n
         exit(1);
     }
 
+    if (variable->isDataReleased())
+    {
+        std::cout << "\nError: the transient variable '" << name << "' has been released!\n";
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
     return variable->DataField();
 }
 //=================================================================================================//
 template <typename DataType>
+StoredVariable<DataType> BaseParticles::registerStoredVariable(const std::string &name)
+{
+    if (isStoredInReducedPrecision<DataType>(name))
+        return StoredVariable<DataType>(nullptr, registerSharedVariable<ReducedData<DataType>>(name));
+    return StoredVariable<DataType>(registerSharedVariable<DataType>(name), nullptr);
+}
+//=================================================================================================//
+template <typename DataType>
+StoredVariable<DataType> BaseParticles::getStoredVariableByName(const std::string &name)
+{
+    if (isStoredInReducedPrecision<DataType>(name))
+        return StoredVariable<DataType>(nullptr, getVariableDataByName<ReducedData<DataType>>(name));
+    return StoredVariable<DataType>(getVariableDataByName<DataType>(name), nullptr);
+}
+//=================================================================================================//
+template <typename DataType>
 DiscreteVariable<DataType> *BaseParticles::
     addVariableToList(ParticleVariables &variable_set, const std::string &name)
 {
@@ -187,6 +281,7 @@ DiscreteVariable<DataType> *BaseParticles::
 
         if (listed_variable == nullptr)
         {
+            allocateSharedVariable(variable); // listed data of a released transient variable is required again
             constexpr int type_index = DataTypeIndex<DataType>::value;
             std::get<type_index>(variable_set).push_back(variable);
             return variable;
@@ -204,6 +299,8 @@ DiscreteVariable<DataType> *BaseParticles::
 template <typename DataType>
 void BaseParticles::addVariableToSort(const std::string &name)
 {
+    if (isStoredInReducedPrecision<DataType>(name))
+        return addVariableToSort<ReducedData<DataType>>(name);
     DiscreteVariable<DataType> *new_sortable =
         addVariableToList<DataType>(sortable_variables_, name);
     if (new_sortable != nullptr)
@@ -217,18 +314,24 @@ void BaseParticles::addVariableToSort(const std::string &name)
 template <typename DataType>
 void BaseParticles::addVariableToWrite(const std::string &name)
 {
+    if (isStoredInReducedPrecision<DataType>(name))
+        return addVariableToWrite<ReducedData<DataType>>(name);
     addVariableToList<DataType>(variables_to_write_, name);
 }
 //=================================================================================================//
 template <typename DataType>
 void BaseParticles::addVariableToRestart(const std::string &name)
 {
+    if (isStoredInReducedPrecision<DataType>(name))
+        return addVariableToRestart<ReducedData<DataType>>(name);
     addVariableToList<DataType>(variables_to_restart_, name);
 }
 //=================================================================================================//
 template <typename DataType>
 void BaseParticles::addVariableToReload(const std::string &name)
 {
+    if (isStoredInReducedPrecision<DataType>(name))
+        return addVariableToReload<ReducedData<DataType>>(name);
     addVariableToList<DataType>(variables_to_reload_, name);
 }
 //=================================================================================================//
@@ -283,6 +386,118 @@ operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables, Ba
     }
 }
 //=================================================================================================//
+template <typename DataType>
+void BaseParticles::AddAParticleVariableToManifest::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           StdVec<BinaryRestartEntry> &manifest, size_t number_of_entries, bool is_hashed)
+{
+    for (size_t i = 0; i != variables.size(); ++i)
+    {
+        uint64_t hash = is_hashed ? hashLargeData(variables[i]->DataField()->data(), sizeof(DataType) * number_of_entries)
+                                  : 0;
+        manifest.push_back({variables[i]->Name(), uint32_t(DataTypeIndex<DataType>::value),
+                            uint32_t(sizeof(DataType)), number_of_entries, hash, "", 0});
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+void BaseParticles::WriteAParticleVariableToBinary::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           CacheFileWriter &cache_file_writer, StdVec<BinaryRestartEntry> &manifest)
+{
+    for (size_t i = 0; i != variables.size(); ++i)
+    {
+        auto entry = std::find_if(manifest.begin(), manifest.end(),
+                                  [&](const BinaryRestartEntry &entry) -> bool
+                                  { return entry.name_ == variables[i]->Name() &&
+                                           entry.type_index_ == uint32_t(DataTypeIndex<DataType>::value); });
+        if (!entry->source_file_.empty())
+        {
+            continue; // unchanged since an earlier restart file
+        }
+        StdVec<char> padding(entry->offset_ - cache_file_writer.PayloadSize(), 0);
+        cache_file_writer.writeBytes(padding.data(), padding.size());
+        cache_file_writer.writeBytes(variables[i]->DataField()->data(), sizeof(DataType) * entry->number_of_entries_);
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+void BaseParticles::ReadAParticleVariableFromBinary::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           CacheFileReader &cache_file_reader, StdVec<BinaryRestartEntry> &manifest,
+           std::map<std::string, CacheFileReader> &source_file_readers, BaseParticles *base_particles)
+{
+    for (size_t i = 0; i != variables.size(); ++i)
+    {
+        auto entry = std::find_if(manifest.begin(), manifest.end(),
+                                  [&](const BinaryRestartEntry &entry) -> bool
+                                  { return entry.name_ == variables[i]->Name(); });
+        if (entry == manifest.end() || entry->type_index_ != uint32_t(DataTypeIndex<DataType>::value) ||
+            entry->data_size_ != sizeof(DataType))
+        {
+            std::cout << "\n Error: the restart variable '" << variables[i]->Name()
+                      << "' is not found with the same type in the restart file!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+
+        StdLargeVec<DataType> &variable_data = variables[i]->DataField() != nullptr
+                                                   ? *variables[i]->DataField()
+                                                   : *base_particles->initializeVariable<DataType>(variables[i]);
+        size_t number_of_bytes = sizeof(DataType) * SMIN(entry->number_of_entries_, variable_data.size());
+        if (entry->source_file_.empty())
+        {
+            cache_file_reader.seek(entry->offset_);
+            cache_file_reader.readBytes(variable_data.data(), number_of_bytes);
+            continue; // covered by the checksum of the restart file
+        }
+
+        // the source files are opened and validated once for all variables
+        CacheFileReader &source_file_reader = source_file_readers.at(entry->source_file_);
+        source_file_reader.seek(entry->offset_);
+        source_file_reader.readBytes(variable_data.data(), number_of_bytes);
+        // the source file may have been overwritten since it was referred to
+        if (number_of_bytes == sizeof(DataType) * entry->number_of_entries_ &&
+            hashLargeData(variable_data.data(), number_of_bytes) != entry->hash_)
+        {
+            std::cout << "\n Error: the restart variable '" << entry->name_
+                      << "' does not match the hash in the manifest!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+void BaseParticles::ResizeAParticleVariable::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables, size_t new_size)
+{
+    for (size_t i = 0; i != variables.size(); ++i)
+    {
+        StdLargeVec<DataType> *variable_data = variables[i]->DataField();
+        if (variable_data != nullptr && !variables[i]->isDataReleased() && variable_data->size() < new_size)
+        {
+            variable_data->resize(new_size, ZeroData<DataType>::value);
+        }
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+void BaseParticles::ReportAParticleVariableMemory::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           MemoryReport &memory_report, const std::string &body_name, size_t used_size)
+{
+    for (size_t i = 0; i != variables.size(); ++i)
+    {
+        StdLargeVec<DataType> *variable_data = variables[i]->DataField();
+        if (variable_data != nullptr)
+        {
+            memory_report.addEntry(body_name, "particles", variables[i]->Name(),
+                                   vectorMemoryUsage(*variable_data, SMIN(used_size, variable_data->size())));
+        }
+    }
+}
+//=================================================================================================//
 template <typename OutStreamType>
 void BaseParticles::writeParticlesToVtk(OutStreamType &output_stream)
 {
@@ -354,6 +569,39 @@ void BaseParticles::writeParticlesToVtk(OutStreamType &output_stream)
         output_stream << "    </DataArray>\n";
     }
 
+#if !SPHINXSYS_USE_FLOAT
+    // write scalars stored in reduced precision
+    constexpr int type_index_reduced_Real = DataTypeIndex<ReducedData<Real>>::value;
+    for (DiscreteVariable<ReducedData<Real>> *variable : std::get<type_index_reduced_Real>(variables_to_write_))
+    {
+        StdLargeVec<ReducedData<Real>> &variable_data = *variable->DataField();
+        output_stream << "    <DataArray Name=\"" << variable->Name() << "\" type=\"Float32\" Format=\"ascii\">\n";
+        output_stream << "    ";
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            output_stream << std::fixed << std::setprecision(9) << variable_data[i] << " ";
+        }
+        output_stream << std::endl;
+        output_stream << "    </DataArray>\n";
+    }
+
+    // write vectors stored in reduced precision
+    constexpr int type_index_reduced_Vecd = DataTypeIndex<ReducedData<Vecd>>::value;
+    for (DiscreteVariable<ReducedData<Vecd>> *variable : std::get<type_index_reduced_Vecd>(variables_to_write_))
+    {
+        StdLargeVec<ReducedData<Vecd>> &variable_data = *variable->DataField();
+        output_stream << "    <DataArray Name=\"" << variable->Name() << "\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
+        output_stream << "    ";
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            Vec3d vector_value = upgradeToVec3d(precisionCast<Vecd>(variable_data[i]));
+            output_stream << std::fixed << std::setprecision(9) << vector_value[0] << " " << vector_value[1] << " " << vector_value[2] << " ";
+        }
+        output_stream << std::endl;
+        output_stream << "    </DataArray>\n";
+    }
+#endif
+
     // write matrices
     constexpr int type_index_Matd = DataTypeIndex<Matd>::value;
     for (DiscreteVariable<Matd> *variable : std::get<type_index_Matd>(variables_to_write_))
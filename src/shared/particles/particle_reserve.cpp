@@ -19,9 +19,9 @@ void ParticleReserve::checkParticlesReserved()
     };
 }
 //=================================================================================================//
-void ParticleBuffer<Base>::checkEnoughBuffer(BaseParticles &base_particles)
+void ParticleBuffer<Base>::checkEnoughBuffer(BaseParticles &base_particles, size_t number_of_new_particles)
 {
-    if (base_particles.TotalRealParticles() >= base_particles.RealParticlesBound())
+    if (base_particles.TotalRealParticles() + number_of_new_particles > base_particles.RealParticlesBound())
     {
         std::cout << "\n ERROR: Not enough buffer particles have been reserved!" << std::endl;
         std::cout << __FILE__ << ':' << __LINE__ << std::endl;
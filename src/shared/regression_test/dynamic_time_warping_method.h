@@ -86,8 +86,7 @@ class RegressionTestDynamicTimeWarping : public RegressionTestTimeAverage<Observ
     /** the interface for generating the priori converged result with DTW */
     void generateDataBase(Real threshold_value, const std::string &filter = "false")
     {
-        this->writeXmlToXmlFile();
-        this->readXmlFromXmlFile();
+        this->readCurrentResult();
         this->transposeTheIndex();
         if (this->converged == "false")
         {
@@ -112,8 +111,7 @@ class RegressionTestDynamicTimeWarping : public RegressionTestTimeAverage<Observ
     /** the interface for generating the priori converged result with DTW. */
     void testResult(const std::string &filter = "false")
     {
-        this->writeXmlToXmlFile();
-        this->readXmlFromXmlFile();
+        this->readCurrentResult();
         this->transposeTheIndex();
         setupTheTest();
         if (filter == "true")
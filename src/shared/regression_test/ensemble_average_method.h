@@ -82,8 +82,7 @@ class RegressionTestEnsembleAverage : public RegressionTestTimeAverage<ObserveMe
     /* the interface for generating the priori converged result with M&V. */
     void generateDataBase(VariableType threshold_mean, VariableType threshold_variance, const std::string &filter = "false")
     {
-        this->writeXmlToXmlFile();
-        this->readXmlFromXmlFile();
+        this->readCurrentResult();
         this->initializeThreshold(threshold_mean, threshold_variance);
         if (this->converged == "false")
         {
@@ -104,8 +103,7 @@ class RegressionTestEnsembleAverage : public RegressionTestTimeAverage<ObserveMe
     /** the interface for testing new result. */
     void testResult(const std::string &filter = "false")
     {
-        this->writeXmlToXmlFile();
-        this->readXmlFromXmlFile();
+        this->readCurrentResult();
         setupAndCorrection();
         if (filter == "true")
             this->filterExtremeValues();
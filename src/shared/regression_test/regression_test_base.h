@@ -117,6 +117,8 @@ class RegressionTestBase : public ObserveMethodType
     void readFromXml(ObservedQuantityRecording<VariableType> *observe_method);
     template <typename ReduceType>
     void readFromXml(ReducedQuantityRecording<ReduceType> *reduce_method);
+    /* read current result directly from the time series store, without the xml memory. */
+    void readFromTimeSeries();
 
     void transposeTheIndex();                  /** transpose the current result (from snapshot*observation to observation*snapshot). */
     void readResultFromXml();                  /** read the result from the .xml file. (all result) */
@@ -134,7 +136,8 @@ class RegressionTestBase : public ObserveMethodType
             exit(1);
         }
         ObserveMethodType::writeToFile(iteration); /* used for visualization (.dat)*/
-        writeToXml(this, iteration);               /* used for regression test. (.xml) */
+        if (!isRecordedInTimeSeries())
+            writeToXml(this, iteration); /* used for regression test. (.xml) */
     };
 
     /*The new run result is stored in the xml memory, and can't be copied and used directly
@@ -151,9 +154,28 @@ class RegressionTestBase : public ObserveMethodType
         readFromXml(this);
     };
 
+    /** read current result from the time series store or, otherwise, via the Xml file. */
+    void readCurrentResult()
+    {
+        if (isRecordedInTimeSeries())
+        {
+            readFromTimeSeries();
+        }
+        else
+        {
+            writeXmlToXmlFile();
+            readXmlFromXmlFile();
+        }
+    };
+
   private:
     size_t last_iteration_step_ = MaxSize_t;
 
+    bool isRecordedInTimeSeries()
+    {
+        return this->recording_file_.Format() == RecordingFormat::time_series;
+    };
+
     bool isIterationStepChanged(size_t iteration_step)
     {
         if (iteration_step != last_iteration_step_)
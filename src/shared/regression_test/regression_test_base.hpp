@@ -77,6 +77,31 @@ void RegressionTestBase<ObserveMethodType>::readFromXml(ReducedQuantityRecording
 };
 //=================================================================================================//
 template <class ObserveMethodType>
+void RegressionTestBase<ObserveMethodType>::readFromTimeSeries()
+{
+    this->recording_file_.flush();
+    TimeSeriesReader time_series_reader(this->recording_file_.FilePath());
+    /* only the records of the latest run are read if the run has been restarted. */
+    StdVec<StdVec<double>> columns = time_series_reader.readColumns(this->recording_file_.SeriesName());
+    size_t number_of_snapshot = columns[0].size();
+    current_result_.clear();
+    element_tag_.clear();
+    for (size_t i = 0; i != number_of_snapshot; ++i)
+    {
+        /* the snapshots are tagged by their order, as the iteration steps are not recorded. */
+        element_tag_.push_back("Snapshot_" + std::to_string(i));
+        current_result_.push_back(StdVec<VariableType>());
+        size_t column = 1; /* the first column is the time. */
+        while (column != columns.size())
+        {
+            VariableType value;
+            TimeSeriesReader::getQuantity(columns, i, column, value);
+            current_result_.back().push_back(value);
+        }
+    }
+};
+//=================================================================================================//
+template <class ObserveMethodType>
 void RegressionTestBase<ObserveMethodType>::transposeTheIndex()
 {
     int number_of_snapshot = this->current_result_.size();
@@ -103,8 +103,7 @@ class RegressionTestTimeAverage : public RegressionTestBase<ObserveMethodType>
     /* the interface for generating the priori converged result with time-averaged meanvalue and variance. */
     void generateDataBase(VariableType threshold_mean, VariableType threshold_variance, const std::string &filter = "false")
     {
-        this->writeXmlToXmlFile();  /* currently defined in in_output. */
-        this->readXmlFromXmlFile(); /* currently defined in in_output. */
+        this->readCurrentResult();
         initializeThreshold(threshold_mean, threshold_variance);
         if (this->converged == "false")
         {
@@ -126,8 +125,7 @@ class RegressionTestTimeAverage : public RegressionTestBase<ObserveMethodType>
     /** the interface for testing new result. */
     void testResult(const std::string &filter = "false")
     {
-        this->writeXmlToXmlFile();  /* currently defined in in_output. */
-        this->readXmlFromXmlFile(); /* currently defined in in_output. */
+        this->readCurrentResult();
         setupTheTest();
         if (filter == "true")
             filterExtremeValues();
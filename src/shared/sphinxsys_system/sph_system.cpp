@@ -12,7 +12,8 @@ SPHSystem::SPHSystem(BoundingBox system_domain_bounds, Real resolution_ref, size
       resolution_ref_(resolution_ref),
       tbb_global_control_(tbb::global_control::max_allowed_parallelism, number_of_threads),
       io_environment_(nullptr), run_particle_relaxation_(false), reload_particles_(false),
-      restart_step_(0), generate_regression_data_(false), state_recording_(true) {}
+      restart_step_(0), generate_regression_data_(false), state_recording_(true),
+      memory_reporting_(false), geometry_cache_folder_("") {}
 //=================================================================================================//
 IOEnvironment &SPHSystem::getIOEnvironment()
 {
@@ -43,6 +44,21 @@ void SPHSystem::initializeSystemConfigurations()
             body->body_relations_[i]->updateConfiguration();
         }
     }
+
+    if (memory_reporting_)
+    {
+        MemoryReport memory_report;
+        reportMemoryUsage(memory_report);
+        memory_report.writeToStream(std::cout);
+    }
+}
+//=================================================================================================//
+void SPHSystem::reportMemoryUsage(MemoryReport &memory_report)
+{
+    for (auto &body : sph_bodies_)
+    {
+        body->reportMemoryUsage(memory_report);
+    }
 }
 //=================================================================================================//
 Real SPHSystem::getSmallestTimeStepAmongSolidBodies(Real CFL)
@@ -71,6 +87,8 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
         desc.add_options()("regression", po::value<bool>(), "Regression test.");
         desc.add_options()("state_recording", po::value<bool>(), "State recording in output folder.");
         desc.add_options()("restart_step", po::value<int>(), "Run form a restart file.");
+        desc.add_options()("memory_report", po::value<bool>(), "Report memory usage of the bodies.");
+        desc.add_options()("geometry_cache", po::value<std::string>(), "Cache level sets and relaxed particles in the folder.");
 
         po::variables_map vm;
         po::store(po::parse_command_line(ac, av, desc), vm);
@@ -141,6 +159,25 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
             std::cout << "Restart inactivated, i.e. restart_step ("
                       << restart_step_ << ").\n";
         }
+
+        if (vm.count("memory_report"))
+        {
+            memory_reporting_ = vm["memory_report"].as<bool>();
+            std::cout << "Memory report was set to "
+                      << vm["memory_report"].as<bool>() << ".\n";
+        }
+        else
+        {
+            std::cout << "Memory report was set to default ("
+                      << memory_reporting_ << ").\n";
+        }
+
+        if (vm.count("geometry_cache"))
+        {
+            geometry_cache_folder_ = vm["geometry_cache"].as<std::string>();
+            std::cout << "Geometry cache folder was set to "
+                      << geometry_cache_folder_ << ".\n";
+        }
     }
     catch (std::exception &e)
     {
@@ -162,4 +199,10 @@ SPHSystem *SPHSystem::setIOEnvironment(bool delete_output)
     return this;
 }
 //=================================================================================================//
+SPHSystem *SPHSystem::setGeometryCache(const std::string &cache_folder)
+{
+    geometry_cache_folder_ = cache_folder;
+    return this;
+}
+//=================================================================================================//
 } // namespace SPH
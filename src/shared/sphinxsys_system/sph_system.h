@@ -39,6 +39,7 @@ namespace po = boost::program_options;
 
 #include "base_data_package.h"
 #include "io_environment.h"
+#include "memory_report.h"
 #include "sph_data_containers.h"
 
 #include <filesystem>
@@ -89,6 +90,13 @@ class SPHSystem
     void setStateRecording(bool state_recording) { state_recording_ = state_recording; };
     void setRestartStep(size_t restart_step) { restart_step_ = restart_step; };
     size_t RestartStep() { return restart_step_; };
+    bool MemoryReporting() { return memory_reporting_; };
+    void setMemoryReporting(bool memory_reporting) { memory_reporting_ = memory_reporting; };
+    /** level sets and relaxed particles are cached in the folder, an empty folder disables the cache */
+    SPHSystem *setGeometryCache(const std::string &cache_folder = "./cache");
+    const std::string &GeometryCacheFolder() { return geometry_cache_folder_; };
+    /** add the memory allocated and used by all bodies to the report */
+    void reportMemoryUsage(MemoryReport &memory_report);
     /** Initialize cell linked list for the SPH system. */
     void initializeSystemCellLinkedLists();
     /** Initialize particle configuration for the SPH system. */
@@ -101,13 +109,15 @@ class SPHSystem
 
   protected:
     friend class IOEnvironment;
-    IOEnvironment *io_environment_; /**< io environment */
-    SPHBodyVector real_bodies_;     /**< The bodies with inner particle configuration. */
-    bool run_particle_relaxation_;  /**< run particle relaxation for body fitted particle distribution */
-    bool reload_particles_;         /**< start the simulation with relaxed particles. */
-    size_t restart_step_;           /**< restart step */
-    bool generate_regression_data_; /**< run and generate or enhance the regression test data set. */
-    bool state_recording_;          /**< Record state in output folder. */
+    IOEnvironment *io_environment_;     /**< io environment */
+    SPHBodyVector real_bodies_;         /**< The bodies with inner particle configuration. */
+    bool run_particle_relaxation_;      /**< run particle relaxation for body fitted particle distribution */
+    bool reload_particles_;             /**< start the simulation with relaxed particles. */
+    size_t restart_step_;               /**< restart step */
+    bool generate_regression_data_;     /**< run and generate or enhance the regression test data set. */
+    bool state_recording_;              /**< Record state in output folder. */
+    bool memory_reporting_;             /**< Report memory usage at start up and with restart files. */
+    std::string geometry_cache_folder_; /**< folder of the content-addressed geometry cache. */
 };
 } // namespace SPH
 #endif // SPH_SYSTEM_H
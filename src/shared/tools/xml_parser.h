@@ -62,16 +62,16 @@ inline std::string DataToString(const DataType &value)
     // return std::to_string(value);
 }
 
-template <int DIMENSION, auto... Rest>
-inline std::string DataToString(const Eigen::Matrix<Real, DIMENSION, Rest...> &value)
+template <typename ScalarType, int DIMENSION, auto... Rest>
+inline std::string DataToString(const Eigen::Matrix<ScalarType, DIMENSION, Rest...> &value)
 {
     std::stringstream ss;
     ss << value.format(Eigen::IOFormat(Eigen::StreamPrecision, Eigen::DontAlignCols, ", ", ", ", "", "", "", ""));
     return ss.str();
 }
 
-template <int DIMENSION, auto... Rest>
-inline std::string DataToString(const Eigen::Matrix<Real, DIMENSION, DIMENSION, Rest...> &value)
+template <typename ScalarType, int DIMENSION, auto... Rest>
+inline std::string DataToString(const Eigen::Matrix<ScalarType, DIMENSION, DIMENSION, Rest...> &value)
 {
     std::stringstream ss;
     ss << value.format(Eigen::IOFormat(Eigen::StreamPrecision, Eigen::DontAlignCols, ", ", ", ", "", "", "", ""));
@@ -84,10 +84,10 @@ inline void StringToData(std::string &value_str, DataType &value)
     std::istringstream(value_str) >> value;
 }
 
-template <int DIMENSION, auto... Rest>
-inline void StringToData(std::string &value_str, Eigen::Matrix<Real, DIMENSION, 1, Rest...> &value)
+template <typename ScalarType, int DIMENSION, auto... Rest>
+inline void StringToData(std::string &value_str, Eigen::Matrix<ScalarType, DIMENSION, 1, Rest...> &value)
 {
-    std::vector<Real> temp;
+    std::vector<ScalarType> temp;
     temp.resize(DIMENSION);
     std::istringstream value_stream(value_str);
 
@@ -103,10 +103,10 @@ inline void StringToData(std::string &value_str, Eigen::Matrix<Real, DIMENSION,
         value[j] = temp[j];
 }
 
-template <int DIMENSION, auto... Rest>
-inline void StringToData(std::string &value_str, Eigen::Matrix<Real, DIMENSION, DIMENSION, Rest...> &value)
+template <typename ScalarType, int DIMENSION, auto... Rest>
+inline void StringToData(std::string &value_str, Eigen::Matrix<ScalarType, DIMENSION, DIMENSION, Rest...> &value)
 {
-    std::vector<Real> temp;
+    std::vector<ScalarType> temp;
     temp.resize(DIMENSION * DIMENSION);
     std::istringstream value_stream(value_str);
 
@@ -245,16 +245,16 @@ class XmlParser
         base_ele->SetAttribute(attrib_name.c_str(), DataToString(value).c_str());
     };
 
-    template <int DIMENSION, auto... Rest>
+    template <typename ScalarType, int DIMENSION, auto... Rest>
     void setAttributeToElement(tinyxml2::XMLElement *base_ele, const std::string &attrib_name,
-                               const Eigen::Matrix<Real, DIMENSION, 1, Rest...> &value)
+                               const Eigen::Matrix<ScalarType, DIMENSION, 1, Rest...> &value)
     {
         base_ele->SetAttribute(attrib_name.c_str(), DataToString(value).c_str());
     };
 
-    template <int DIMENSION, auto... Rest>
+    template <typename ScalarType, int DIMENSION, auto... Rest>
     void setAttributeToElement(tinyxml2::XMLElement *base_ele, const std::string &attrib_name,
-                               const Eigen::Matrix<Real, DIMENSION, DIMENSION, Rest...> &value)
+                               const Eigen::Matrix<ScalarType, DIMENSION, DIMENSION, Rest...> &value)
     {
         base_ele->SetAttribute(attrib_name.c_str(), DataToString(value).c_str());
     };
@@ -272,9 +272,9 @@ class XmlParser
         StringToData(value_str, value);
     };
 
-    template <int DIMENSION, auto... Rest>
+    template <typename ScalarType, int DIMENSION, auto... Rest>
     void queryAttributeValue(tinyxml2::XMLElement *base_ele, const std::string &attrib_name,
-                             Eigen::Matrix<Real, DIMENSION, 1, Rest...> &value)
+                             Eigen::Matrix<ScalarType, DIMENSION, 1, Rest...> &value)
     {
         const char *value_char = 0;
         base_ele->QueryAttribute(attrib_name.c_str(), &value_char);
@@ -283,9 +283,9 @@ class XmlParser
         StringToData(value_str, value);
     };
 
-    template <int DIMENSION, auto... Rest>
+    template <typename ScalarType, int DIMENSION, auto... Rest>
     void queryAttributeValue(tinyxml2::XMLElement *base_ele, const std::string &attrib_name,
-                             Eigen::Matrix<Real, DIMENSION, DIMENSION, Rest...> &value)
+                             Eigen::Matrix<ScalarType, DIMENSION, DIMENSION, Rest...> &value)
     {
         const char *value_char = 0;
         base_ele->QueryAttribute(attrib_name.c_str(), &value_char);
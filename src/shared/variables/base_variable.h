@@ -61,6 +61,13 @@ class SingleVariable : public BaseVariable
     DataType value_;
 };
 
+/** Lifetime hint of a discrete variable. */
+enum class VariableLifetime
+{
+    Persistent, /**< kept allocated during the whole simulation */
+    Transient   /**< only used by some dynamics, e.g. during particle relaxation, and released afterwards */
+};
+
 template <typename DataType>
 class DiscreteVariable : public BaseVariable
 {
@@ -71,11 +78,94 @@ class DiscreteVariable : public BaseVariable
     StdLargeVec<DataType> *DataField() { return data_field_; };
     void allocateDataField(const size_t size, const DataType &initial_value)
     {
-        data_field_ = new StdLargeVec<DataType>(size, initial_value);
+        if (data_field_ == nullptr)
+        {
+            data_field_ = new StdLargeVec<DataType>(size, initial_value);
+        }
+        else // reuse the container so that the references to it are kept valid
+        {
+            data_field_->assign(size, initial_value);
+        }
+        is_data_released_ = false;
+    }
+    /** free the memory of the data but keep the container */
+    void releaseDataField()
+    {
+        StdLargeVec<DataType>().swap(*data_field_);
+        is_data_released_ = true;
     }
+    bool isDataReleased() { return is_data_released_; };
+    VariableLifetime Lifetime() { return lifetime_; };
+    void setLifetime(VariableLifetime lifetime) { lifetime_ = lifetime; };
+    size_t addUser() { return ++number_of_users_; };
+    size_t removeUser() { return number_of_users_ == 0 ? 0 : --number_of_users_; };
 
   private:
     StdLargeVec<DataType> *data_field_;
+    bool is_data_released_ = false;
+    VariableLifetime lifetime_ = VariableLifetime::Persistent;
+    size_t number_of_users_ = 0; /**< number of dynamics using a transient variable */
+};
+
+/**
+ * @class StoredVariable
+ * @brief Access to the data of a discrete variable which is stored either with DataType
+ * or with ReducedData<DataType>, as chosen when the variable is first registered.
+ * Values are read as DataType and an update, such as data[index_i] += increment,
+ * is accumulated in DataType and narrowed only once when stored.
+ */
+template <typename DataType>
+class StoredVariable
+{
+    using ReducedType = ReducedData<DataType>;
+
+  public:
+    class Reference
+    {
+      public:
+        Reference(StoredVariable &variable, size_t index) : variable_(variable), index_(index){};
+        operator DataType() const { return variable_.value(index_); };
+        Reference &operator=(const DataType &value)
+        {
+            variable_.store(index_, value);
+            return *this;
+        };
+        Reference &operator+=(const DataType &increment)
+        {
+            variable_.store(index_, variable_.value(index_) + increment);
+            return *this;
+        };
+        Reference &operator-=(const DataType &decrement)
+        {
+            variable_.store(index_, variable_.value(index_) - decrement);
+            return *this;
+        };
+
+      private:
+        StoredVariable &variable_;
+        size_t index_;
+    };
+
+    StoredVariable(StdLargeVec<DataType> *data, StdLargeVec<ReducedType> *reduced_data)
+        : data_(data), reduced_data_(reduced_data){};
+    bool isReduced() const { return data_ == nullptr; };
+    DataType value(size_t index) const
+    {
+        return data_ != nullptr ? (*data_)[index] : precisionCast<DataType>((*reduced_data_)[index]);
+    };
+    void store(size_t index, const DataType &value)
+    {
+        if (data_ != nullptr)
+            (*data_)[index] = value;
+        else
+            (*reduced_data_)[index] = precisionCast<ReducedType>(value);
+    };
+    DataType operator[](size_t index) const { return value(index); };
+    Reference operator[](size_t index) { return Reference(*this, index); };
+
+  private:
+    StdLargeVec<DataType> *data_;
+    StdLargeVec<ReducedType> *reduced_data_;
 };
 
 template <typename DataType>
@@ -92,10 +182,14 @@ class MeshVariable : public BaseVariable
     void allocateAllMeshVariableData(const size_t size)
     {
         data_field_ = new PackageData[size];
+        allocated_size_ = size;
     }
+    /** number of packages for which the data is allocated */
+    size_t AllocatedSize() { return allocated_size_; };
 
   private:
     PackageData *data_field_;
+    size_t allocated_size_ = 0;
 };
 
 template <typename DataType, template <typename VariableDataType> class VariableType>
@@ -105,22 +105,36 @@ class BidirectionalBuffer
         {
             if (aligned_box_.checkUpperBound(pos_n_[index_i]) && buffer_particle_indicator_[index_i] == 1)
             {
-                mutex_switch_to_real_.lock();
-                particle_buffer_.checkEnoughBuffer(*particles_);
-                particles_->createRealParticleFrom(index_i);
-                mutex_switch_to_real_.unlock();
-
-                /** Periodic bounding. */
-                pos_n_[index_i] = aligned_box_.getUpperPeriodic(pos_n_[index_i]);
-                Real sound_speed = fluid_.getSoundSpeed(rho_n_[index_i]);
-                p_[index_i] = target_pressure_(p_[index_i]);
-                rho_n_[index_i] = p_[index_i] / pow(sound_speed, 2.0) + fluid_.ReferenceDensity();
-                previous_surface_indicator_[index_i] = 1;
+                injected_particles_.push_back(index_i);
             }
         }
 
+        virtual void finishDynamics(Real dt = 0.0) override
+        {
+            particle_buffer_.checkEnoughBuffer(*particles_, injected_particles_.size());
+            particles_->createRealParticlesFrom(injected_particles_);
+
+            parallel_for(
+                IndexRange(0, injected_particles_.size()),
+                [&](const IndexRange &r)
+                {
+                    for (size_t k = r.begin(); k != r.end(); ++k)
+                    {
+                        size_t index_i = injected_particles_[k];
+                        /** Periodic bounding. */
+                        pos_n_[index_i] = aligned_box_.getUpperPeriodic(pos_n_[index_i]);
+                        Real sound_speed = fluid_.getSoundSpeed(rho_n_[index_i]);
+                        p_[index_i] = target_pressure_(p_[index_i]);
+                        rho_n_[index_i] = p_[index_i] / pow(sound_speed, 2.0) + fluid_.ReferenceDensity();
+                        previous_surface_indicator_[index_i] = 1;
+                    }
+                },
+                ap);
+            injected_particles_.clear();
+        }
+
       protected:
-        std::mutex mutex_switch_to_real_;
+        ConcurrentIndexVector injected_particles_;
         ParticleBuffer<Base> &particle_buffer_;
         AlignedBoxShape &aligned_box_;
         Fluid &fluid_;
@@ -0,0 +1,151 @@
+#include "triangle_mesh_bvh.h"
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+using namespace SPH;
+
+/** unit sphere by subdividing an octahedron, with outward oriented faces */
+void createSphereMesh(int subdivisions, StdVec<Vec3d> &vertices, StdVec<std::array<int, 3>> &faces)
+{
+    vertices = {Vec3d(1, 0, 0), Vec3d(-1, 0, 0), Vec3d(0, 1, 0), Vec3d(0, -1, 0), Vec3d(0, 0, 1), Vec3d(0, 0, -1)};
+    faces = {{0, 2, 4}, {2, 1, 4}, {1, 3, 4}, {3, 0, 4}, {2, 0, 5}, {1, 2, 5}, {3, 1, 5}, {0, 3, 5}};
+    for (int n = 0; n != subdivisions; ++n)
+    {
+        std::map<std::pair<int, int>, int> middle_points;
+        auto middle_point = [&](int a, int b)
+        {
+            std::pair<int, int> edge(SMIN(a, b), SMAX(a, b));
+            auto found = middle_points.find(edge);
+            if (found != middle_points.end())
+                return found->second;
+            vertices.push_back((vertices[a] + vertices[b]).normalized());
+            middle_points[edge] = int(vertices.size() - 1);
+            return int(vertices.size() - 1);
+        };
+        StdVec<std::array<int, 3>> refined_faces;
+        for (auto &face : faces)
+        {
+            int ab = middle_point(face[0], face[1]);
+            int bc = middle_point(face[1], face[2]);
+            int ca = middle_point(face[2], face[0]);
+            refined_faces.push_back({face[0], ab, ca});
+            refined_faces.push_back({face[1], bc, ab});
+            refined_faces.push_back({face[2], ca, bc});
+            refined_faces.push_back({ab, bc, ca});
+        }
+        faces = refined_faces;
+    }
+}
+
+/** single-face hierarchies provide the exact closest point on each face */
+Vec3d bruteForceClosestPoint(StdVec<TriangleMeshBVH> &single_faces, const Vec3d &probe_point)
+{
+    Vec3d closest_point = Vec3d::Zero();
+    Real closest_distance = MaxReal;
+    for (auto &single_face : single_faces)
+    {
+        Vec3d point = single_face.findClosestPoint(probe_point);
+        if ((point - probe_point).norm() < closest_distance)
+        {
+            closest_distance = (point - probe_point).norm();
+            closest_point = point;
+        }
+    }
+    return closest_point;
+}
+
+class TriangleMeshBVHTest : public testing::Test
+{
+  protected:
+    StdVec<Vec3d> vertices_;
+    StdVec<std::array<int, 3>> faces_;
+    StdLargeVec<Vec3d> positions_;
+    StdVec<TriangleMeshBVH> single_faces_;
+
+    void SetUp() override
+    {
+        createSphereMesh(5, vertices_, faces_);
+        for (auto &face : faces_)
+            single_faces_.push_back(TriangleMeshBVH(vertices_, {face}));
+        std::mt19937 random_engine(1);
+        std::uniform_real_distribution<Real> distribution(-1.5, 1.5);
+        positions_.resize(2000);
+        for (auto &position : positions_)
+            position = Vec3d(distribution(random_engine), distribution(random_engine), distribution(random_engine));
+    };
+    /** the closest distance to the faceted surface is at most the gap to the unit sphere */
+    bool isNearSurface(const Vec3d &position) { return ABS(position.norm() - 1.0) < 0.01; };
+};
+
+TEST_F(TriangleMeshBVHTest, ClosestPoint)
+{
+    TriangleMeshBVH bvh(vertices_, faces_);
+    for (size_t i = 0; i != 200; ++i)
+    {
+        Vec3d closest_point = bvh.findClosestPoint(positions_[i]);
+        Vec3d reference = bruteForceClosestPoint(single_faces_, positions_[i]);
+        EXPECT_NEAR((closest_point - positions_[i]).norm(), (reference - positions_[i]).norm(), 1.0e-12);
+    }
+}
+
+TEST_F(TriangleMeshBVHTest, WindingNumberContainment)
+{
+    TriangleMeshBVH bvh(vertices_, faces_);
+    StdLargeVec<Real> winding_numbers(positions_.size());
+    bvh.computeWindingNumbers(positions_, IndexRange(0, positions_.size()), winding_numbers);
+    for (size_t i = 0; i != positions_.size(); ++i)
+    {
+        if (isNearSurface(positions_[i]))
+            continue;
+        bool is_inside = positions_[i].norm() < 1.0;
+        EXPECT_EQ(bvh.checkContain(positions_[i]), is_inside);
+        EXPECT_NEAR(winding_numbers[i], is_inside ? 1.0 : 0.0, 0.01);
+    }
+}
+
+TEST_F(TriangleMeshBVHTest, WindingNumberWithHoles)
+{
+    // remove some faces so that the mesh is not watertight anymore
+    StdVec<std::array<int, 3>> faces_with_holes;
+    for (size_t i = 0; i != faces_.size(); ++i)
+        if (i % 97 != 0)
+            faces_with_holes.push_back(faces_[i]);
+
+    TriangleMeshBVH bvh(vertices_, faces_with_holes);
+    for (auto &position : positions_)
+    {
+        if (isNearSurface(position))
+            continue;
+        EXPECT_EQ(bvh.checkContain(position), position.norm() < 1.0);
+    }
+}
+
+TEST_F(TriangleMeshBVHTest, BenchmarkAgainstBruteForce)
+{
+    TriangleMeshBVH bvh(vertices_, faces_);
+    size_t number_of_probes = 100;
+
+    TickCount t1 = TickCount::now();
+    Real brute_force_sum = 0.0;
+    for (size_t i = 0; i != number_of_probes; ++i)
+        brute_force_sum += bruteForceClosestPoint(single_faces_, positions_[i]).norm();
+    TimeInterval brute_force_time = TickCount::now() - t1;
+
+    TickCount t2 = TickCount::now();
+    Real bvh_sum = 0.0;
+    for (size_t i = 0; i != number_of_probes; ++i)
+        bvh_sum += bvh.findClosestPoint(positions_[i]).norm();
+    TimeInterval bvh_time = TickCount::now() - t2;
+
+    std::cout << faces_.size() << " faces, closest points of " << number_of_probes << " probes: "
+              << "brute force " << brute_force_time.seconds() << " s, BVH " << bvh_time.seconds() << " s." << std::endl;
+    EXPECT_NEAR(brute_force_sum, bvh_sum, 1.0e-10);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
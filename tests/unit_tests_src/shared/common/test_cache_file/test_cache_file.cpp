@@ -0,0 +1,129 @@
+#include "cache_file.h"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+using namespace SPH;
+
+TEST(cache_file, ContentHash)
+{
+    ContentHash hash_1, hash_2, hash_3;
+    hash_1.add(std::string("GeometricShapeBox")).add(Vecd::Ones().eval()).add(Real(0.1));
+    hash_2.add(std::string("GeometricShapeBox")).add(Vecd::Ones().eval()).add(Real(0.1));
+    hash_3.add(std::string("GeometricShapeBox")).add(Vecd::Ones().eval()).add(Real(0.2));
+    EXPECT_EQ(hash_1.Value(), hash_2.Value());
+    EXPECT_NE(hash_1.Value(), hash_3.Value());
+    EXPECT_EQ(hash_1.HexDigest().size(), 16);
+}
+
+TEST(cache_file, LargeDataHash)
+{
+    // larger than a part hashed in parallel
+    StdLargeVec<Vecd> positions(200000, Vecd::Ones());
+    uint64_t hash = hashLargeData(positions.data(), positions.size() * sizeof(Vecd));
+    EXPECT_EQ(hash, hashLargeData(positions.data(), positions.size() * sizeof(Vecd)));
+    positions.back()[0] = 2.0;
+    EXPECT_NE(hash, hashLargeData(positions.data(), positions.size() * sizeof(Vecd)));
+    EXPECT_NE(hash, hashLargeData(positions.data(), (positions.size() - 1) * sizeof(Vecd)));
+}
+
+TEST(cache_file, LargeDataHashInPieces)
+{
+    // pieces smaller and larger than a part, not aligned with the parts
+    StdVec<char> data(3 * LargeDataHash::part_size_ + 12345);
+    for (size_t i = 0; i != data.size(); ++i)
+        data[i] = char(i * 7 + i / 1000);
+    LargeDataHash large_data_hash;
+    size_t begin = 0;
+    for (size_t piece_size : {size_t(10), LargeDataHash::part_size_ - 3, size_t(7), 2 * LargeDataHash::part_size_})
+    {
+        large_data_hash.addBytes(data.data() + begin, piece_size);
+        begin += piece_size;
+    }
+    large_data_hash.addBytes(data.data() + begin, data.size() - begin);
+    EXPECT_EQ(large_data_hash.Value(), hashLargeData(data.data(), data.size()));
+    EXPECT_EQ(LargeDataHash().Value(), hashLargeData(data.data(), 0));
+}
+
+TEST(cache_file, WriteAndRead)
+{
+    std::string file_path = "./cache_test/test_cache_file.bin";
+    StdLargeVec<Vecd> positions(100);
+    for (size_t i = 0; i != positions.size(); ++i)
+        positions[i] = Real(i) * Vecd::Ones();
+    {
+        CacheFileWriter cache_file_writer(file_path, 42);
+        cache_file_writer.write(std::string("Position"));
+        cache_file_writer.write(positions.size());
+        cache_file_writer.writeBytes(positions.data(), positions.size() * sizeof(Vecd));
+        EXPECT_TRUE(cache_file_writer.commit());
+    }
+
+    CacheFileReader cache_file_reader(file_path, 42);
+    ASSERT_TRUE(cache_file_reader.isValid());
+    std::string name;
+    cache_file_reader.read(name);
+    EXPECT_EQ(name, "Position");
+    StdLargeVec<Vecd> read_positions(cache_file_reader.read<size_t>());
+    cache_file_reader.readBytes(read_positions.data(), read_positions.size() * sizeof(Vecd));
+    EXPECT_EQ(positions, read_positions);
+
+    // the memory map moves with the reader
+    static_assert(!std::is_copy_constructible<CacheFileReader>::value);
+    CacheFileReader moved_reader(std::move(cache_file_reader));
+    EXPECT_FALSE(cache_file_reader.isValid());
+    ASSERT_TRUE(moved_reader.isValid());
+    moved_reader.seek(0);
+    EXPECT_EQ(moved_reader.read<std::string>(), "Position");
+
+    EXPECT_FALSE(CacheFileReader(file_path, 43).isValid());
+    EXPECT_FALSE(CacheFileReader("./cache_test/not_existing.bin", 42).isValid());
+}
+
+TEST(cache_file, AlignedArraysWithSeek)
+{
+    // arrays at aligned offsets after a manifest, as in binary restart files
+    std::string file_path = "./cache_test/test_aligned_arrays.bin";
+    StdLargeVec<Real> scalars(10, 2.0);
+    size_t offset = 64 - sizeof(CacheFileHeader);
+    {
+        CacheFileWriter cache_file_writer(file_path, 42);
+        cache_file_writer.write(offset);
+        StdVec<char> padding(offset - cache_file_writer.PayloadSize(), 0);
+        cache_file_writer.writeBytes(padding.data(), padding.size());
+        EXPECT_EQ(cache_file_writer.PayloadSize(), offset);
+        cache_file_writer.writeBytes(scalars.data(), scalars.size() * sizeof(Real));
+        EXPECT_TRUE(cache_file_writer.commit());
+    }
+
+    CacheFileReader cache_file_reader(file_path, 42);
+    ASSERT_TRUE(cache_file_reader.isValid());
+    cache_file_reader.seek(cache_file_reader.read<size_t>());
+    StdLargeVec<Real> read_scalars(scalars.size());
+    cache_file_reader.readBytes(read_scalars.data(), read_scalars.size() * sizeof(Real));
+    EXPECT_EQ(scalars, read_scalars);
+}
+
+TEST(cache_file, CorruptedFile)
+{
+    std::string file_path = "./cache_test/test_corrupted_file.bin";
+    {
+        CacheFileWriter cache_file_writer(file_path, 42);
+        cache_file_writer.write(Real(1.0));
+        EXPECT_TRUE(cache_file_writer.commit());
+    }
+    {
+        std::fstream file(file_path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put(char(0x7f));
+    }
+    EXPECT_FALSE(CacheFileReader(file_path, 42).isValid());
+    std::filesystem::remove_all("./cache_test");
+}
+//=================================================================================================//
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,68 @@
+#include "memory_report.h"
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+
+using namespace SPH;
+
+TEST(memory_report, VectorMemoryUsage)
+{
+    StdLargeVec<Real> data(10);
+    data.reserve(100);
+    MemoryUsage usage = vectorMemoryUsage(data);
+    EXPECT_EQ(usage.allocated_, data.capacity() * sizeof(Real));
+    EXPECT_EQ(usage.used_, 10 * sizeof(Real));
+    EXPECT_EQ(vectorMemoryUsage(data, 4).used_, 4 * sizeof(Real));
+    EXPECT_FALSE(usage.is_estimated_);
+}
+
+TEST(memory_report, SummariesAndEstimates)
+{
+    MemoryReport memory_report;
+    memory_report.addEntry("Water", "particles", "Position", MemoryUsage(200, 100));
+    memory_report.addEntry("Water", "particles", "Velocity", MemoryUsage(200, 100));
+    memory_report.addEntry("Water", "io", "restart_xml", MemoryUsage(50, 50, true));
+    memory_report.addEntry("Wall", "particles", "Position", MemoryUsage(80, 40));
+
+    EXPECT_EQ(memory_report.Entries().size(), 4);
+    EXPECT_EQ(memory_report.TotalUsage().allocated_, 530);
+    EXPECT_EQ(memory_report.TotalUsage().used_, 290);
+    EXPECT_TRUE(memory_report.TotalUsage().is_estimated_);
+    EXPECT_EQ(memory_report.BodyUsage("Water").used_, 250);
+    EXPECT_EQ(memory_report.BodyUsage("Wall").allocated_, 80);
+    EXPECT_FALSE(memory_report.BodyUsage("Wall").is_estimated_);
+    EXPECT_EQ(memory_report.SubsystemUsage("Water", "particles").allocated_, 400);
+    EXPECT_FALSE(memory_report.SubsystemUsage("Water", "particles").is_estimated_);
+    EXPECT_TRUE(memory_report.SubsystemUsage("Water", "io").is_estimated_);
+
+    std::stringstream summary;
+    memory_report.writeToStream(summary);
+    EXPECT_NE(summary.str().find("Water: allocated"), std::string::npos);
+    EXPECT_NE(summary.str().find("(estimated in part)"), std::string::npos);
+}
+
+TEST(memory_report, WriteToJson)
+{
+    MemoryReport memory_report;
+    memory_report.addEntry("Water", "particles", "Position", MemoryUsage(200, 100));
+    memory_report.addEntry("Water", "io", "restart_xml", MemoryUsage(50, 50, true));
+    memory_report.writeToJson("./memory_report_test.json", 1.5);
+
+    std::ifstream in_file("./memory_report_test.json");
+    std::string content((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("\"physical_time\": 1.5"), std::string::npos);
+    EXPECT_NE(content.find("\"allocated\": 250"), std::string::npos);
+    EXPECT_NE(content.find("{\"name\": \"Position\", \"allocated\": 200, \"used\": 100}"), std::string::npos);
+    EXPECT_NE(content.find("{\"name\": \"restart_xml\", \"allocated\": 50, \"used\": 50, \"estimated\": true}"),
+              std::string::npos);
+    in_file.close();
+    std::remove("./memory_report_test.json");
+}
+//=================================================================================================//
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -11,6 +11,29 @@ TEST(sph_data_containers, getIntersectionOfBoundingBoxes)
     EXPECT_EQ(bb_ref, getIntersectionOfBoundingBoxes(bb_1, bb_2));
 }
 
+TEST(sph_data_containers, LargeDataAllocator)
+{
+    size_t huge_page_size = LargeDataAllocator<Real>::huge_page_size_;
+    StdLargeVec<Real> small_vector(100, 1.0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(small_vector.data()) % 64, 0);
+
+    size_t large_size = huge_page_size / sizeof(Real) + 1;
+    StdLargeVec<Real> large_vector(large_size);
+    for (size_t i = 0; i != large_size; ++i)
+        large_vector[i] = Real(i);
+#ifdef __linux__
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(large_vector.data()) % huge_page_size, 0);
+#endif
+    // the data are kept when growing from small to large blocks and back
+    small_vector.resize(large_size, 2.0);
+    large_vector.resize(100);
+    large_vector.shrink_to_fit();
+    for (size_t i = 0; i != large_size; ++i)
+        EXPECT_EQ(small_vector[i], i < 100 ? 1.0 : 2.0);
+    for (size_t i = 0; i != 100; ++i)
+        EXPECT_EQ(large_vector[i], Real(i));
+}
+
 //=================================================================================================//
 //=================================================================================================//
 int main(int argc, char *argv[])
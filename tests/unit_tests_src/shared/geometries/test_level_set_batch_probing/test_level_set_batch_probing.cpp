@@ -0,0 +1,131 @@
+#include "../../unit_test_shapes.h"
+#include "adaptation.h"
+#include "level_set.h"
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace SPH;
+
+class LevelSetBatchProbing : public testing::Test
+{
+  protected:
+    TestBall ball_{1.0};
+    SPHAdaptation sph_adaptation_{0.05};
+    LevelSet level_set_{ball_.getBounds(), 0.05, ball_, sph_adaptation_};
+    StdLargeVec<Vecd> positions_;
+    IndexVector indices_;
+
+    void SetUp() override
+    {
+        std::mt19937 random_engine(1);
+        std::uniform_real_distribution<Real> distribution(-1.1, 1.1);
+        positions_.resize(100000);
+        for (size_t i = 0; i != positions_.size(); ++i)
+        {
+            for (int n = 0; n != Dimensions; ++n)
+                positions_[i][n] = distribution(random_engine);
+            // probe only every other position to check the index mapping
+            if (i % 2 == 0)
+                indices_.push_back(i);
+        }
+    };
+};
+
+TEST_F(LevelSetBatchProbing, IdenticalToSinglePositionProbing)
+{
+    StdLargeVec<Real> signed_distances(positions_.size(), -1.0);
+    StdLargeVec<Vecd> level_set_gradients(positions_.size(), Vecd::Ones());
+    StdLargeVec<Real> kernel_integrals(positions_.size(), -1.0);
+    level_set_.probeSignedDistance(positions_, indices_, signed_distances);
+    level_set_.probeLevelSetGradient(positions_, indices_, level_set_gradients);
+    level_set_.probeKernelIntegral(positions_, indices_, kernel_integrals);
+
+    for (size_t i = 0; i != positions_.size(); ++i)
+    {
+        if (i % 2 == 0)
+        {
+            EXPECT_EQ(signed_distances[i], level_set_.probeSignedDistance(positions_[i]));
+            EXPECT_EQ(level_set_gradients[i], level_set_.probeLevelSetGradient(positions_[i]));
+            EXPECT_EQ(kernel_integrals[i], level_set_.probeKernelIntegral(positions_[i]));
+        }
+        else
+        {
+            EXPECT_EQ(signed_distances[i], -1.0);
+            EXPECT_EQ(level_set_gradients[i], Vecd::Ones());
+            EXPECT_EQ(kernel_integrals[i], -1.0);
+        }
+    }
+}
+
+TEST_F(LevelSetBatchProbing, MultilevelKernelIntegrals)
+{
+    MultilevelLevelSet multilevel_level_set(ball_.getBounds(), 0.1, 2, ball_, sph_adaptation_);
+    StdVec<LevelSet *> mesh_levels = multilevel_level_set.getMeshLevels();
+    Real h_ratio = 0.5 * (mesh_levels[0]->global_h_ratio_ + mesh_levels[1]->global_h_ratio_);
+
+    // the second probe with fewer positions reuses the fine level values of the first
+    for (size_t number_of_positions : {positions_.size(), positions_.size() / 4})
+    {
+        StdLargeVec<Vecd> positions(positions_.begin(), positions_.begin() + number_of_positions);
+        IndexVector indices;
+        for (size_t index : indices_)
+        {
+            if (index < number_of_positions)
+                indices.push_back(index);
+        }
+        StdLargeVec<Real> kernel_integrals(number_of_positions, -1.0);
+        StdLargeVec<Vecd> kernel_gradient_integrals(number_of_positions, Vecd::Ones());
+        multilevel_level_set.probeKernelIntegral(positions, indices, kernel_integrals, h_ratio);
+        multilevel_level_set.probeKernelGradientIntegral(positions, indices, kernel_gradient_integrals, h_ratio);
+        for (size_t index : indices)
+        {
+            EXPECT_EQ(kernel_integrals[index], multilevel_level_set.probeKernelIntegral(positions[index], h_ratio));
+            EXPECT_EQ(kernel_gradient_integrals[index],
+                      multilevel_level_set.probeKernelGradientIntegral(positions[index], h_ratio));
+        }
+    }
+}
+
+TEST_F(LevelSetBatchProbing, BenchmarkAgainstSinglePositionProbing)
+{
+    // positions near the surface as probed by particle relaxation and surface bounding
+    StdLargeVec<Vecd> surface_positions(positions_.size());
+    for (size_t i = 0; i != positions_.size(); ++i)
+        surface_positions[i] = (0.9 + 0.1 * positions_[i].norm()) * positions_[i].normalized();
+
+    for (auto positions : {&positions_, &surface_positions})
+    {
+        StdLargeVec<Real> single_probed(positions->size());
+        StdLargeVec<Real> batch_probed(positions->size());
+        size_t repeats = 20;
+
+        TickCount t1 = TickCount::now();
+        for (size_t n = 0; n != repeats; ++n)
+            parallel_for(
+                IndexRange(0, indices_.size()),
+                [&](const IndexRange &r)
+                {
+                    for (size_t i = r.begin(); i != r.end(); ++i)
+                        single_probed[indices_[i]] = level_set_.probeSignedDistance((*positions)[indices_[i]]);
+                },
+                ap);
+        TimeInterval single_time = TickCount::now() - t1;
+
+        TickCount t2 = TickCount::now();
+        for (size_t n = 0; n != repeats; ++n)
+            level_set_.probeSignedDistance(*positions, indices_, batch_probed);
+        TimeInterval batch_time = TickCount::now() - t2;
+
+        std::cout << "Single-position probing: " << single_time.seconds() << " s, "
+                  << "batched probing: " << batch_time.seconds() << " s." << std::endl;
+        for (size_t i = 0; i != indices_.size(); ++i)
+            EXPECT_EQ(single_probed[indices_[i]], batch_probed[indices_[i]]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
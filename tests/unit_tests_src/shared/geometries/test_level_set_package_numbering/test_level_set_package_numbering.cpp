@@ -0,0 +1,47 @@
+#include "../../unit_test_shapes.h"
+#include "adaptation.h"
+#include "level_set.h"
+#include "mesh_iterators.hpp"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** gives access to the package metadata for checking them against the serial numbering */
+class LevelSetPackages : public LevelSet
+{
+  public:
+    using LevelSet::LevelSet;
+
+    void checkSameAsSerialNumbering()
+    {
+        // the sequential loop over the cells which numbered the packages before
+        size_t package_index = 2;
+        mesh_for(MeshRange(Arrayi::Zero(), all_cells_),
+                 [&](const Arrayi &cell_index)
+                 {
+                     if (isInnerDataPackage(cell_index))
+                     {
+                         EXPECT_EQ(PackageIndexFromCellIndex(cell_index), package_index);
+                         EXPECT_TRUE((meta_data_cell_[package_index].first == cell_index).all());
+                         package_index++;
+                     }
+                 });
+        EXPECT_GT(package_index, 2);
+        EXPECT_EQ(num_grid_pkgs_, package_index);
+    };
+};
+
+TEST(LevelSetPackageNumbering, SameAsSerialLoop)
+{
+    // off the center, so that the rows of cells are occupied differently
+    TestBall ball(0.1 * Vecd::Ones(), 1.0);
+    SPHAdaptation sph_adaptation(0.02);
+    LevelSetPackages level_set(ball.getBounds(), 0.02, ball, sph_adaptation);
+    level_set.checkSameAsSerialNumbering();
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,114 @@
+#include "../../unit_test_shapes.h"
+#include "adaptation.h"
+#include "level_set_shape.h"
+#include <gtest/gtest.h>
+
+#include <random>
+#include <tbb/task_group.h>
+
+using namespace SPH;
+
+class LevelSetShapeTransform : public testing::Test
+{
+  protected:
+    TestBall ball_{Vecd(0.2, 0.0, 0.0), 1.0};
+    LevelSetShape reference_shape_{ball_, makeShared<SPHAdaptation>(0.05)};
+    LevelSetShape moving_shape_{ball_, makeShared<SPHAdaptation>(0.05)};
+    Transform transform_{Rotation3d(0.7, Vec3d(1.0, 1.0, 0.0).normalized()), Vec3d(0.5, -0.3, 0.2)};
+    StdLargeVec<Vecd> reference_positions_;
+    StdLargeVec<Vecd> moved_positions_;
+
+    void SetUp() override
+    {
+        moving_shape_.setTransform(transform_);
+        std::mt19937 random_engine(1);
+        std::uniform_real_distribution<Real> distribution(-1.0, 1.4);
+        reference_positions_.resize(1000);
+        moved_positions_.resize(1000);
+        for (size_t i = 0; i != reference_positions_.size(); ++i)
+        {
+            for (int n = 0; n != Dimensions; ++n)
+                reference_positions_[i][n] = distribution(random_engine);
+            moved_positions_[i] = transform_.shiftFrameStationToBase(reference_positions_[i]);
+        }
+    };
+};
+
+TEST_F(LevelSetShapeTransform, ProbesMovedWithShape)
+{
+    for (size_t i = 0; i != reference_positions_.size(); ++i)
+    {
+        const Vecd &reference_position = reference_positions_[i];
+        const Vecd &moved_position = moved_positions_[i];
+        EXPECT_EQ(moving_shape_.checkContain(moved_position), reference_shape_.checkContain(reference_position));
+        EXPECT_NEAR(moving_shape_.findSignedDistance(moved_position),
+                    reference_shape_.findSignedDistance(reference_position), 1.0e-10);
+        EXPECT_NEAR(moving_shape_.computeKernelIntegral(moved_position),
+                    reference_shape_.computeKernelIntegral(reference_position), 1.0e-10);
+
+        Vecd closest_point = transform_.shiftFrameStationToBase(reference_shape_.findClosestPoint(reference_position));
+        EXPECT_LT((moving_shape_.findClosestPoint(moved_position) - closest_point).norm(), 1.0e-10);
+        Vecd gradient = transform_.xformFrameVecToBase(reference_shape_.findLevelSetGradient(reference_position));
+        EXPECT_LT((moving_shape_.findLevelSetGradient(moved_position) - gradient).norm(), 1.0e-10);
+        Vecd kernel_gradient = transform_.xformFrameVecToBase(
+            reference_shape_.computeKernelGradientIntegral(reference_position));
+        EXPECT_LT((moving_shape_.computeKernelGradientIntegral(moved_position) - kernel_gradient).norm(), 1.0e-10);
+    }
+}
+
+TEST_F(LevelSetShapeTransform, BatchedProbesMovedWithShape)
+{
+    IndexRange index_range(0, moved_positions_.size());
+    StdLargeVec<Real> signed_distances(moved_positions_.size());
+    StdLargeVec<Real> reference_signed_distances(moved_positions_.size());
+    StdLargeVec<Vecd> normal_directions(moved_positions_.size());
+    StdLargeVec<Vecd> reference_normal_directions(moved_positions_.size());
+    moving_shape_.findSignedDistances(moved_positions_, index_range, signed_distances);
+    moving_shape_.findNormalDirections(moved_positions_, index_range, normal_directions);
+    reference_shape_.findSignedDistances(reference_positions_, index_range, reference_signed_distances);
+    reference_shape_.findNormalDirections(reference_positions_, index_range, reference_normal_directions);
+    for (size_t i = 0; i != moved_positions_.size(); ++i)
+    {
+        EXPECT_NEAR(signed_distances[i], reference_signed_distances[i], 1.0e-10);
+        Vecd normal = transform_.xformFrameVecToBase(reference_normal_directions[i]);
+        EXPECT_LT((normal_directions[i] - normal).norm(), 1.0e-10);
+    }
+}
+
+TEST_F(LevelSetShapeTransform, BatchedProbesConcurrently)
+{
+    size_t half_size = moved_positions_.size() / 2;
+    StdLargeVec<Real> signed_distances(moved_positions_.size());
+    StdLargeVec<Real> reference_signed_distances(moved_positions_.size());
+    /** the two halves are probed on the same moved shape at the same time */
+    tbb::task_group probes;
+    probes.run([&]()
+               { moving_shape_.findSignedDistances(moved_positions_, IndexRange(0, half_size), signed_distances); });
+    probes.run([&]()
+               { moving_shape_.findSignedDistances(moved_positions_, IndexRange(half_size, moved_positions_.size()),
+                                                   signed_distances); });
+    probes.wait();
+    reference_shape_.findSignedDistances(reference_positions_, IndexRange(0, moved_positions_.size()),
+                                         reference_signed_distances);
+    for (size_t i = 0; i != moved_positions_.size(); ++i)
+    {
+        EXPECT_NEAR(signed_distances[i], reference_signed_distances[i], 1.0e-10);
+    }
+}
+
+TEST_F(LevelSetShapeTransform, BoundsMovedWithShape)
+{
+    BoundingBox bounds = moving_shape_.getBounds();
+    Vecd moved_center = transform_.shiftFrameStationToBase(Vecd(0.2, 0.0, 0.0));
+    for (int n = 0; n != Dimensions; ++n)
+    {
+        EXPECT_LE(bounds.first_[n], moved_center[n] - 1.0);
+        EXPECT_GE(bounds.second_[n], moved_center[n] + 1.0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,83 @@
+#include "../../unit_test_shapes.h"
+#include "adaptation.h"
+#include "level_set.h"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace SPH;
+
+/** the value of an attribute in the first element with the given tag */
+std::string attributeValue(const std::string &content, const std::string &tag, const std::string &attribute)
+{
+    size_t element_begin = content.find("<" + tag);
+    size_t value_begin = content.find(attribute + "=\"", element_begin) + attribute.size() + 2;
+    return content.substr(value_begin, content.find('"', value_begin) - value_begin);
+}
+
+TEST(level_set_vtk_output, ImageData)
+{
+    TestBall ball(1.0);
+    SPHAdaptation sph_adaptation(0.05);
+    LevelSet level_set(ball.getBounds(), 0.05, ball, sph_adaptation);
+    std::filesystem::create_directory("./vtk_test");
+    level_set.writeMeshFieldToVtk("./vtk_test/level_set");
+
+    std::ifstream in_file("./vtk_test/level_set.vti", std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    std::stringstream extent(attributeValue(content, "ImageData", "WholeExtent"));
+    std::stringstream origin(attributeValue(content, "ImageData", "Origin"));
+    Real spacing = std::stod(attributeValue(content, "ImageData", "Spacing"));
+    EXPECT_NEAR(spacing, 0.05, 1.0e-6);
+
+    Arrayi all_grid_points = Arrayi::Ones();
+    Vecd lower_bound = Vecd::Zero();
+    for (int n = 0; n != 3; ++n)
+    {
+        int lower_index, upper_index;
+        Real origin_coordinate;
+        extent >> lower_index >> upper_index;
+        origin >> origin_coordinate;
+        if (n < Dimensions)
+        {
+            all_grid_points[n] = upper_index + 1;
+            lower_bound[n] = origin_coordinate;
+        }
+    }
+    size_t total_grid_points = all_grid_points.prod();
+
+    // the first array in the appended data is the level set, i.e. phi
+    size_t data_begin = content.find("_", content.find("<AppendedData")) + 1;
+    uint64_t number_of_bytes = 0;
+    std::memcpy(&number_of_bytes, content.data() + data_begin, sizeof(uint64_t));
+    ASSERT_EQ(number_of_bytes, total_grid_points * sizeof(float));
+    const char *phi_data = content.data() + data_begin + sizeof(uint64_t);
+
+    // with the x index running fastest, compare with probing at the grid points
+    for (size_t i = 0; i < total_grid_points; i += 97)
+    {
+        Arrayi grid_index = Arrayi::Zero();
+        size_t point_number = i;
+        for (int n = 0; n != Dimensions; ++n)
+        {
+            grid_index[n] = point_number % all_grid_points[n];
+            point_number /= all_grid_points[n];
+        }
+        Vecd position = lower_bound + grid_index.cast<Real>().matrix() * spacing;
+        if (!level_set.probeIsWithinMeshBound(position))
+            continue;
+        float phi = 0.0;
+        std::memcpy(&phi, phi_data + i * sizeof(float), sizeof(float));
+        EXPECT_NEAR(phi, level_set.probeSignedDistance(position), 1.0e-4);
+    }
+    std::filesystem::remove_all("./vtk_test");
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,66 @@
+#include "io_asynchronous.h"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+using namespace SPH;
+
+TEST(AsynchronousWriter, TasksInSubmittedOrder)
+{
+    StdVec<size_t> written;
+    {
+        AsynchronousWriter asynchronous_writer(2);
+        for (size_t i = 0; i != 100; ++i)
+            asynchronous_writer.submit([&written, i]()
+                                       { written.push_back(i); });
+        // the pending tasks are finished on destruction
+    }
+    ASSERT_EQ(written.size(), 100);
+    for (size_t i = 0; i != written.size(); ++i)
+        EXPECT_EQ(written[i], i);
+}
+
+TEST(AsynchronousWriter, BoundedPendingTasks)
+{
+    std::atomic<int> pending(0);
+    std::atomic<int> max_pending(0);
+    AsynchronousWriter asynchronous_writer(2);
+    for (size_t i = 0; i != 20; ++i)
+    {
+        asynchronous_writer.waitForFreeSlot();
+        int now_pending = ++pending;
+        max_pending = SMAX(max_pending.load(), now_pending);
+        asynchronous_writer.submit([&pending]()
+                                   {
+                                       std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                                       --pending; });
+    }
+    asynchronous_writer.flush();
+    EXPECT_EQ(pending, 0);
+    EXPECT_LE(max_pending, 2);
+}
+
+TEST(AsynchronousWriter, TaskExceptionRethrownByFlush)
+{
+    size_t finished_tasks = 0;
+    AsynchronousWriter asynchronous_writer(2);
+    asynchronous_writer.submit([]()
+                               { throw std::runtime_error("disk full"); });
+    asynchronous_writer.submit([&finished_tasks]()
+                               { ++finished_tasks; });
+    EXPECT_THROW(asynchronous_writer.flush(), std::runtime_error);
+    // the following tasks are still executed and the exception is reported only once
+    EXPECT_EQ(finished_tasks, 1);
+    asynchronous_writer.submit([&finished_tasks]()
+                               { ++finished_tasks; });
+    EXPECT_NO_THROW(asynchronous_writer.flush());
+    EXPECT_EQ(finished_tasks, 2);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
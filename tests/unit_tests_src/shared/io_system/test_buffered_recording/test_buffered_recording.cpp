@@ -0,0 +1,152 @@
+#include "../../unit_test_shapes.h"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace SPH;
+namespace fs = std::filesystem;
+
+std::string readFile(const std::string &file_path)
+{
+    std::ifstream in_file(file_path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+}
+
+class BufferedRecordingTest : public testing::Test
+{
+  protected:
+    SPHSystem sph_system_;
+    SPHBody ball_;
+    IOEnvironment *io_environment_;
+
+    BufferedRecordingTest()
+        : sph_system_(BoundingBox(-2.0 * Vecd::Ones(), 2.0 * Vecd::Ones()), 0.1),
+          ball_(sph_system_, makeShared<TestBall>(1.0), "Ball")
+    {
+        sph_system_.setIOEnvironment();
+        io_environment_ = &sph_system_.getIOEnvironment();
+        ball_.defineMaterial<BaseMaterial>();
+        ball_.generateParticles<BaseParticles, Lattice>();
+    };
+};
+
+TEST_F(BufferedRecordingTest, BinaryLayoutAndFlushes)
+{
+    std::string file_path = io_environment_->output_folder_ + "/Probe_Position.bin";
+    size_t header_size = 8 + sizeof(uint64_t);
+    StdVec<std::string> column_names = {"run_time"};
+    for (int i = 0; i != Dimensions; ++i)
+        column_names.push_back("Position[" + std::to_string(i) + "]");
+    for (const std::string &column_name : column_names)
+        header_size += sizeof(uint64_t) + column_name.size();
+    size_t record_size = (1 + Dimensions) * sizeof(double);
+
+    {
+        BufferedRecordingFile recording_file(*io_environment_, io_environment_->output_folder_ + "/Probe_Position");
+        recording_file.setRecordingFormat(RecordingFormat::binary, 3);
+        EXPECT_EQ(recording_file.FilePath(), file_path);
+        recording_file.addColumn("run_time", Real(0));
+        recording_file.addColumn("Position", Vecd(Vecd::Zero()));
+        recording_file.open();
+        EXPECT_EQ(fs::file_size(file_path), header_size);
+
+        for (size_t record = 0; record != 7; ++record)
+        {
+            recording_file.beginRecord(0.1 * Real(record));
+            recording_file.appendValue(Real(record) * Vecd::Ones());
+            recording_file.endRecord();
+            // written every third record only
+            EXPECT_EQ(fs::file_size(file_path), header_size + (record + 1) / 3 * 3 * record_size);
+        }
+        // as before the restart files
+        io_environment_->flushBufferedOutputs();
+        EXPECT_EQ(fs::file_size(file_path), header_size + 7 * record_size);
+
+        recording_file.beginRecord(0.1 * Real(7));
+        recording_file.appendValue(7.0 * Vecd::Ones());
+        recording_file.endRecord();
+        EXPECT_EQ(fs::file_size(file_path), header_size + 7 * record_size);
+    }
+    // and on destruction
+    ASSERT_EQ(fs::file_size(file_path), header_size + 8 * record_size);
+
+    std::ifstream in_file(file_path, std::ios::binary);
+    char magic[8];
+    in_file.read(magic, 8);
+    EXPECT_EQ(std::string(magic, 8), "SPHREC01");
+    uint64_t number_of_columns = 0;
+    in_file.read(reinterpret_cast<char *>(&number_of_columns), sizeof(uint64_t));
+    ASSERT_EQ(number_of_columns, column_names.size());
+    for (const std::string &column_name : column_names)
+    {
+        uint64_t length = 0;
+        in_file.read(reinterpret_cast<char *>(&length), sizeof(uint64_t));
+        std::string name(length, ' ');
+        in_file.read(name.data(), length);
+        EXPECT_EQ(name, column_name);
+    }
+    for (size_t record = 0; record != 8; ++record)
+    {
+        double row[1 + Dimensions];
+        in_file.read(reinterpret_cast<char *>(row), sizeof(row));
+        EXPECT_EQ(row[0], 0.1 * Real(record));
+        for (int i = 0; i != Dimensions; ++i)
+            EXPECT_EQ(row[1 + i], Real(record));
+    }
+}
+
+TEST_F(BufferedRecordingTest, TextSameAsPerRecordFile)
+{
+    BaseParticles &particles = ball_.getBaseParticles();
+    StdLargeVec<Real> &mass = *particles.getVariableDataByName<Real>("Mass");
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+        mass[i] = 0.0;
+    // with small times written in scientific notation by the default format
+    StdVec<Real> times = {0.0, 1.5e-7, 0.123456789, 2.0, 12.5};
+    std::string file_path = io_environment_->output_folder_ + "/Ball_TotalMass.dat";
+
+    // the output of the former recording, which opened the file for each record
+    PltEngine plt_engine;
+    std::ostringstream header;
+    header << "\"run_time\""
+           << "   ";
+    plt_engine.writeAQuantityHeader(header, Real(0), "TotalMass");
+    header << "\n";
+    StdVec<std::string> records;
+    for (size_t record = 0; record != times.size(); ++record)
+    {
+        std::ostringstream out_file;
+        out_file << times[record] << "   ";
+        plt_engine.writeAQuantity(out_file, Real(record) / 3.0);
+        out_file << "\n";
+        records.push_back(out_file.str());
+    }
+    auto expectedContent = [&](size_t number_of_records)
+    {
+        std::string content = header.str();
+        for (size_t record = 0; record != number_of_records; ++record)
+            content += records[record];
+        return content;
+    };
+
+    {
+        ReducedQuantityRecording<QuantitySummation<Real>> write_total_mass(ball_, "Mass");
+        write_total_mass.setRecordingFormat(RecordingFormat::text, 2);
+        for (size_t record = 0; record != times.size(); ++record)
+        {
+            GlobalStaticVariables::physical_time_ = times[record];
+            mass[0] = Real(record) / 3.0;
+            write_total_mass.writeToFile(record);
+            EXPECT_EQ(readFile(file_path), expectedContent((record + 1) / 2 * 2));
+        }
+    }
+    EXPECT_EQ(readFile(file_path), expectedContent(times.size()));
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,66 @@
+#include "../../unit_test_shapes.h"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+/** the total mass recorded in the time series store of the system */
+class TotalMassRegression : public RegressionTestBase<ReducedQuantityRecording<QuantitySummation<Real>>>
+{
+  public:
+    explicit TotalMassRegression(SPHBody &sph_body)
+        : RegressionTestBase<ReducedQuantityRecording<QuantitySummation<Real>>>(sph_body, "Mass")
+    {
+        setRecordingFormat(RecordingFormat::time_series);
+    };
+    const BiVector<Real> &CurrentResult() { return current_result_; };
+};
+
+TEST(time_series_regression, ReadCurrentResultAfterRestart)
+{
+    SPHSystem sph_system(BoundingBox(-2.0 * Vecd::Ones(), 2.0 * Vecd::Ones()), 0.1);
+    sph_system.setIOEnvironment();
+    SPHBody ball(sph_system, makeShared<TestBall>(1.0), "Ball");
+    ball.defineMaterial<BaseMaterial>();
+    ball.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = ball.getBaseParticles();
+    StdLargeVec<Real> &mass = *particles.getVariableDataByName<Real>("Mass");
+    Real other_mass = 0.0;
+    for (size_t i = 1; i != particles.TotalRealParticles(); ++i)
+        other_mass += mass[i];
+
+    {
+        TotalMassRegression total_mass(ball);
+        for (size_t step = 0; step != 4; ++step)
+        {
+            GlobalStaticVariables::physical_time_ = 0.1 * Real(step);
+            mass[0] = Real(step);
+            total_mass.writeToFile(step);
+        }
+    }
+
+    // a run restarted at the time 0.1 records again from there on
+    TotalMassRegression total_mass(ball);
+    for (size_t step = 1; step != 5; ++step)
+    {
+        GlobalStaticVariables::physical_time_ = 0.1 * Real(step);
+        mass[0] = 10.0 * Real(step);
+        total_mass.writeToFile(step);
+    }
+    total_mass.readCurrentResult();
+
+    const BiVector<Real> &current_result = total_mass.CurrentResult();
+    ASSERT_EQ(current_result.size(), 5);
+    EXPECT_NEAR(current_result[0][0], other_mass, 1.0e-10 * other_mass);
+    for (size_t snapshot = 1; snapshot != 5; ++snapshot)
+    {
+        ASSERT_EQ(current_result[snapshot].size(), 1);
+        EXPECT_NEAR(current_result[snapshot][0], other_mass + 10.0 * Real(snapshot), 1.0e-10 * other_mass);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
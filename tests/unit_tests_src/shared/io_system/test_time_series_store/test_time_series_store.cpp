@@ -0,0 +1,105 @@
+#include "io_time_series.h"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+using namespace SPH;
+
+/** records of the columns time, 10 * time and the record index */
+StdVec<double> createRecords(size_t first_record, size_t number_of_records)
+{
+    StdVec<double> records;
+    for (size_t i = first_record; i != first_record + number_of_records; ++i)
+    {
+        double time = 0.01 * double(i);
+        records.insert(records.end(), {time, 10.0 * time, double(i)});
+    }
+    return records;
+}
+
+TEST(time_series_store, WriteAndReadTimeRange)
+{
+    std::filesystem::create_directory("./time_series_test");
+    std::string file_path = "./time_series_test/TimeSeries.sts";
+    {
+        TimeSeriesStore time_series_store(file_path);
+        size_t observer = time_series_store.addSeries("Observer_Pressure", {"run_time", "Pressure[0]", "Index[0]"});
+        size_t energy = time_series_store.addSeries("TotalEnergy", {"run_time", "TotalEnergy"});
+        for (size_t chunk = 0; chunk != 10; ++chunk)
+        {
+            time_series_store.appendRecords(observer, createRecords(chunk * 100, 100));
+            time_series_store.appendRecords(energy, {0.01 * double(chunk), 1.0});
+        }
+    }
+
+    TimeSeriesReader time_series_reader(file_path);
+    ASSERT_TRUE(time_series_reader.isValid());
+    EXPECT_EQ(time_series_reader.SeriesNames().size(), 2);
+    EXPECT_EQ(time_series_reader.ColumnNames("Observer_Pressure")[1], "Pressure[0]");
+    StdVec<StdVec<double>> all_columns = time_series_reader.readColumns("Observer_Pressure");
+    EXPECT_EQ(all_columns[0].size(), 1000);
+    StdVec<StdVec<double>> columns = time_series_reader.readColumns("Observer_Pressure", 2.5, 3.505);
+    ASSERT_EQ(columns[2].size(), 101);
+    EXPECT_EQ(columns[2].front(), 250.0);
+    EXPECT_EQ(columns[2].back(), 350.0);
+    EXPECT_DOUBLE_EQ(columns[1][10], 10.0 * columns[0][10]);
+    EXPECT_EQ(time_series_reader.readColumns("TotalEnergy")[1].size(), 10);
+}
+
+TEST(time_series_store, AppendAfterRestartAndTruncation)
+{
+    std::string file_path = "./time_series_test/TimeSeries.sts";
+    // a chunk truncated by an aborted run
+    std::uintmax_t file_size = std::filesystem::file_size(file_path);
+    std::filesystem::resize_file(file_path, file_size - 8);
+    EXPECT_EQ(TimeSeriesReader(file_path).readColumns("TotalEnergy")[1].size(), 9);
+    {
+        TimeSeriesStore time_series_store(file_path);
+        size_t energy = time_series_store.addSeries("TotalEnergy", {"run_time", "TotalEnergy"});
+        EXPECT_EQ(energy, 1);
+        time_series_store.appendRecords(energy, {0.2, 2.0});
+    }
+
+    TimeSeriesReader time_series_reader(file_path);
+    StdVec<StdVec<double>> columns = time_series_reader.readColumns("TotalEnergy");
+    ASSERT_EQ(columns[1].size(), 10);
+    EXPECT_EQ(columns[1].back(), 2.0);
+    std::filesystem::remove_all("./time_series_test");
+}
+TEST(time_series_store, LatestRunAfterRestart)
+{
+    std::filesystem::create_directory("./time_series_test");
+    std::string file_path = "./time_series_test/TimeSeries.sts";
+    {
+        TimeSeriesStore time_series_store(file_path);
+        size_t energy = time_series_store.addSeries("TotalEnergy", {"run_time", "TotalEnergy"});
+        for (size_t i = 0; i != 10; ++i)
+            time_series_store.appendRecords(energy, {0.1 * double(i), 1.0});
+    }
+    // restarted from the time 0.5 and recorded again from there
+    {
+        TimeSeriesStore time_series_store(file_path);
+        size_t energy = time_series_store.addSeries("TotalEnergy", {"run_time", "TotalEnergy"});
+        for (size_t i = 5; i != 8; ++i)
+            time_series_store.appendRecords(energy, {0.1 * double(i), 2.0});
+    }
+
+    TimeSeriesReader time_series_reader(file_path);
+    StdVec<StdVec<double>> columns = time_series_reader.readColumns("TotalEnergy");
+    ASSERT_EQ(columns[0].size(), 8);
+    for (size_t i = 0; i != columns[0].size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(columns[0][i], 0.1 * double(i));
+        EXPECT_EQ(columns[1][i], i < 5 ? 1.0 : 2.0);
+    }
+    // the records of the earlier run after the restart time are not read within a time range either
+    EXPECT_EQ(time_series_reader.readColumns("TotalEnergy", 0.75, 1.0)[0].size(), 0);
+    std::filesystem::remove_all("./time_series_test");
+}
+//=================================================================================================//
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
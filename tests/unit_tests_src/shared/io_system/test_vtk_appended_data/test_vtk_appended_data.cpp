@@ -0,0 +1,158 @@
+#include "io_vtk_binary.h"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+
+using namespace SPH;
+
+/** the bytes of the appended data section starting after the leading underscore */
+std::string appendedBytes(const std::string &output)
+{
+    size_t begin = output.find('_') + 1;
+    size_t end = output.rfind("\n </AppendedData>");
+    return output.substr(begin, end - begin);
+}
+
+std::string decodeBase64(const std::string &encoded)
+{
+    const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string decoded;
+    int buffer = 0, bits = 0;
+    for (char c : encoded)
+    {
+        if (c == '=')
+            break;
+        buffer = (buffer << 6) | int(alphabet.find(c));
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            decoded.push_back(char((buffer >> bits) & 0xff));
+        }
+    }
+    return decoded;
+}
+
+/** the offset attribute of a DataArray element */
+size_t arrayOffset(const std::string &data_array)
+{
+    size_t begin = data_array.find("offset=\"") + 8;
+    return std::stoul(data_array.substr(begin, data_array.find('"', begin) - begin));
+}
+
+class VtkAppendedDataTest : public testing::Test
+{
+  protected:
+    StdLargeVec<Real> scalars_;
+    StdLargeVec<Vecd> vectors_;
+    StdLargeVec<int> integers_;
+
+    void SetUp() override
+    {
+        // more entries than a chunk to check the continuous streaming
+        size_t number_of_entries = 30000;
+        for (size_t i = 0; i != number_of_entries; ++i)
+        {
+            scalars_.push_back(Real(i) * 0.5);
+            vectors_.push_back(Real(i) * Vecd::Ones());
+            integers_.push_back(-int(i));
+        }
+    };
+
+    void checkArrays(VtkEncoding encoding)
+    {
+        VtkAppendedData appended_data(encoding);
+        std::string scalar_array = appended_data.addDataArray("Scalar", scalars_, scalars_.size());
+        std::string vector_array = appended_data.addDataArray("Vector", vectors_, vectors_.size());
+        std::string integer_array = appended_data.addDataArray("Integer", integers_, integers_.size());
+        EXPECT_NE(vector_array.find("NumberOfComponents=\"3\""), std::string::npos);
+        EXPECT_NE(integer_array.find("type=\"Int32\""), std::string::npos);
+
+        std::ostringstream output;
+        appended_data.writeAppendedData(output);
+        std::string bytes = appendedBytes(output.str());
+
+        auto decodeArray = [&](const std::string &data_array)
+        {
+            size_t offset = arrayOffset(data_array);
+            if (encoding == VtkEncoding::raw)
+            {
+                uint64_t size;
+                std::memcpy(&size, bytes.data() + offset, sizeof(uint64_t));
+                return bytes.substr(offset + sizeof(uint64_t), size);
+            }
+            // the header and the data are encoded separately
+            std::string header = decodeBase64(bytes.substr(offset, 12));
+            uint64_t size;
+            std::memcpy(&size, header.data(), sizeof(uint64_t));
+            return decodeBase64(bytes.substr(offset + 12, 4 * ((size + 2) / 3)));
+        };
+
+        std::string scalar_bytes = decodeArray(scalar_array);
+        std::string vector_bytes = decodeArray(vector_array);
+        std::string integer_bytes = decodeArray(integer_array);
+        ASSERT_EQ(scalar_bytes.size(), scalars_.size() * sizeof(float));
+        ASSERT_EQ(vector_bytes.size(), 3 * vectors_.size() * sizeof(float));
+        ASSERT_EQ(integer_bytes.size(), integers_.size() * sizeof(int));
+
+        const float *scalar_values = reinterpret_cast<const float *>(scalar_bytes.data());
+        const float *vector_values = reinterpret_cast<const float *>(vector_bytes.data());
+        const int *integer_values = reinterpret_cast<const int *>(integer_bytes.data());
+        for (size_t i = 0; i != scalars_.size(); ++i)
+        {
+            EXPECT_EQ(scalar_values[i], float(scalars_[i]));
+            for (int k = 0; k != Dimensions; ++k)
+                EXPECT_EQ(vector_values[3 * i + k], float(vectors_[i][k]));
+            for (int k = Dimensions; k != 3; ++k)
+                EXPECT_EQ(vector_values[3 * i + k], 0.0f);
+            EXPECT_EQ(integer_values[i], integers_[i]);
+        }
+    };
+};
+
+TEST_F(VtkAppendedDataTest, RawEncoding)
+{
+    checkArrays(VtkEncoding::raw);
+}
+
+TEST_F(VtkAppendedDataTest, Base64Encoding)
+{
+    checkArrays(VtkEncoding::base64);
+}
+
+TEST_F(VtkAppendedDataTest, PieceOfArray)
+{
+    // the second of three contiguous pieces as written for partitioned output
+    size_t first_entry = scalars_.size() / 3;
+    size_t number_of_entries = 2 * scalars_.size() / 3 - first_entry;
+    VtkAppendedData appended_data(VtkEncoding::raw);
+    appended_data.addDataArray("Scalar", scalars_, number_of_entries, first_entry);
+    std::ostringstream output;
+    appended_data.writeAppendedData(output);
+    std::string bytes = appendedBytes(output.str());
+
+    uint64_t size;
+    std::memcpy(&size, bytes.data(), sizeof(uint64_t));
+    ASSERT_EQ(size, number_of_entries * sizeof(float));
+    const float *scalar_values = reinterpret_cast<const float *>(bytes.data() + sizeof(uint64_t));
+    for (size_t i = 0; i != number_of_entries; ++i)
+        EXPECT_EQ(scalar_values[i], float(scalars_[first_entry + i]));
+}
+
+TEST_F(VtkAppendedDataTest, ParallelDataArrays)
+{
+    VtkAppendedData appended_data(VtkEncoding::raw);
+    appended_data.addDataArray("Vector", vectors_, 0);
+    EXPECT_EQ(appended_data.takeParallelDataArrays(),
+              "    <PDataArray Name=\"Vector\" type=\"Float32\" NumberOfComponents=\"3\"/>\n");
+    appended_data.addDataArray("Integer", integers_, 0);
+    EXPECT_EQ(appended_data.takeParallelDataArrays(),
+              "    <PDataArray Name=\"Integer\" type=\"Int32\" NumberOfComponents=\"1\"/>\n");
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,220 @@
+#include "../../unit_test_shapes.h"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+using namespace SPH;
+namespace fs = std::filesystem;
+
+class VtpRecordingTest : public testing::Test
+{
+  protected:
+    SPHSystem sph_system_;
+    RealBody ball_;
+    std::string output_folder_;
+
+    VtpRecordingTest()
+        : sph_system_(BoundingBox(-2.0 * Vecd::Ones(), 2.0 * Vecd::Ones()), 0.1),
+          ball_(sph_system_, makeShared<TestBall>(1.0), "Ball")
+    {
+        sph_system_.setIOEnvironment();
+        output_folder_ = sph_system_.getIOEnvironment().output_folder_;
+        ball_.defineMaterial<BaseMaterial>();
+        ball_.generateParticles<BaseParticles, Lattice>();
+    };
+
+    void writeStates(BodyStatesRecordingToVtp &write_states)
+    {
+        ball_.setNewlyUpdated();
+        write_states.writeToFile();
+    };
+
+    /** write the states at the iteration step and return the content of the file */
+    std::string writeStep(BodyStatesRecordingToVtp &write_states, size_t iteration_step)
+    {
+        ball_.setNewlyUpdated();
+        write_states.writeToFile(iteration_step);
+        std::ostringstream sequence;
+        sequence << std::setw(10) << std::setfill('0') << iteration_step;
+        std::ifstream in_file(output_folder_ + "/Ball_" + sequence.str() + ".vtp", std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    };
+
+    std::set<size_t> selectedOriginalIds(OutputFilter &output_filter)
+    {
+        BaseParticles &particles = ball_.getBaseParticles();
+        IndexVector selected_particles;
+        output_filter.selectParticles(particles, selected_particles);
+        std::set<size_t> original_ids;
+        for (size_t i : selected_particles)
+            original_ids.insert(particles.ParticleOriginalIds()[i]);
+        return original_ids;
+    };
+};
+
+TEST_F(VtpRecordingTest, StalePiecesRemoved)
+{
+    GlobalStaticVariables::physical_time_ = 0.0;
+    BodyStatesRecordingToVtp write_states(ball_, VtkEncoding::raw);
+    write_states.setNumberOfPieces(4);
+    writeStates(write_states);
+
+    std::string file_name;
+    for (const auto &entry : fs::directory_iterator(output_folder_))
+    {
+        if (entry.path().extension() == ".pvtp")
+            file_name = entry.path().stem().string();
+    }
+    ASSERT_FALSE(file_name.empty());
+    std::string pieces_folder = output_folder_ + "/" + file_name;
+    auto piece = [&](size_t k)
+    { return pieces_folder + "/" + file_name + "_" + std::to_string(k) + ".vtp"; };
+    EXPECT_TRUE(fs::exists(piece(3)));
+
+    // the same output written again with fewer pieces
+    write_states.setNumberOfPieces(2);
+    writeStates(write_states);
+    EXPECT_TRUE(fs::exists(piece(0)));
+    EXPECT_TRUE(fs::exists(piece(1)));
+    EXPECT_FALSE(fs::exists(piece(2)));
+    EXPECT_FALSE(fs::exists(piece(3)));
+
+    write_states.setNumberOfPieces(1);
+    writeStates(write_states);
+    EXPECT_TRUE(fs::exists(output_folder_ + "/" + file_name + ".vtp"));
+    EXPECT_FALSE(fs::exists(output_folder_ + "/" + file_name + ".pvtp"));
+    EXPECT_FALSE(fs::exists(pieces_folder));
+}
+
+TEST_F(VtpRecordingTest, FilterSelectionKeptAfterSorting)
+{
+    BaseParticles &particles = ball_.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+    StrideOutputFilter stride_filter(3);
+    RandomSubsampleOutputFilter random_filter(0.3, 7);
+    std::set<size_t> stride_selection = selectedOriginalIds(stride_filter);
+    std::set<size_t> random_selection = selectedOriginalIds(random_filter);
+    EXPECT_EQ(stride_selection.size(), (total_real_particles + 2) / 3);
+    EXPECT_NEAR(Real(random_selection.size()) / Real(total_real_particles), 0.3, 0.03);
+
+    ball_.updateCellLinkedList();
+    ball_.updateCellLinkedListWithParticleSort(1);
+    size_t number_of_moved = 0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        number_of_moved += particles.ParticleOriginalIds()[i] != i;
+    ASSERT_GT(number_of_moved, 0);
+    EXPECT_EQ(selectedOriginalIds(stride_filter), stride_selection);
+    EXPECT_EQ(selectedOriginalIds(random_filter), random_selection);
+}
+
+TEST_F(VtpRecordingTest, RegionFilterWithOutsideStride)
+{
+    BaseParticles &particles = ball_.getBaseParticles();
+    TestBall region(0.5 * Vecd::UnitX(), 0.5);
+    RegionOutputFilter region_filter(region, 5);
+    IndexVector selected_particles;
+    region_filter.selectParticles(particles, selected_particles);
+
+    IndexVector expected_particles;
+    size_t number_of_inside = 0;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        bool is_inside = region.checkContain(particles.ParticlePositions()[i]);
+        number_of_inside += is_inside;
+        if (is_inside || particles.ParticleOriginalIds()[i] % 5 == 0)
+            expected_particles.push_back(i);
+    }
+    ASSERT_GT(number_of_inside, 0);
+    EXPECT_GT(expected_particles.size(), number_of_inside);
+    EXPECT_EQ(selected_particles, expected_particles);
+}
+
+TEST_F(VtpRecordingTest, FilteredOutputAndOutputIntervals)
+{
+    ball_.getBaseParticles().registerSharedVariable<Vecd>("Velocity");
+    BodyStatesRecordingToVtp write_states(ball_, VtkEncoding::raw);
+    write_states.addToWrite<Vecd>(ball_, "Velocity");
+    write_states.addOutputFilter<StrideOutputFilter>(ball_, 4);
+    write_states.setOutputInterval("Velocity", 2);
+
+    size_t total_real_particles = ball_.getBaseParticles().TotalRealParticles();
+    std::string number_of_points = "NumberOfPoints=\"" + std::to_string((total_real_particles + 3) / 4) + "\"";
+    for (size_t step = 0; step != 3; ++step)
+    {
+        std::string content = writeStep(write_states, step);
+        EXPECT_NE(content.find(number_of_points), std::string::npos);
+        EXPECT_NE(content.find("Name=\"OriginalParticle_ID\""), std::string::npos);
+        // the velocity is written with every second output only
+        EXPECT_EQ(content.find("Name=\"Velocity\"") != std::string::npos, step % 2 == 0);
+    }
+
+    // a run restarted at step 5 writes the velocity with its first output and then keeps the intervals aligned,
+    // an output without any updated body does not count
+    BodyStatesRecordingToVtp restarted_write_states(ball_, VtkEncoding::raw);
+    restarted_write_states.addToWrite<Vecd>(ball_, "Velocity");
+    restarted_write_states.setOutputInterval("Velocity", 2);
+    EXPECT_NE(writeStep(restarted_write_states, 5).find("Name=\"Velocity\""), std::string::npos);
+    EXPECT_NE(writeStep(restarted_write_states, 6).find("Name=\"Velocity\""), std::string::npos);
+    EXPECT_EQ(writeStep(restarted_write_states, 7).find("Name=\"Velocity\""), std::string::npos);
+    restarted_write_states.writeToFile(8);
+    EXPECT_NE(writeStep(restarted_write_states, 9).find("Name=\"Velocity\""), std::string::npos);
+    EXPECT_NE(writeStep(restarted_write_states, 10).find("Name=\"Velocity\""), std::string::npos);
+    EXPECT_EQ(writeStep(restarted_write_states, 11).find("Name=\"Velocity\""), std::string::npos);
+}
+
+TEST(VtpRecordingLargeOutput, MultiPieceBinaryBeyondBatch)
+{
+    /** each of the two pieces has more particles than the 3 * 8192 * 32 entries of a batch
+     *  filled in parallel, while the pieces are also written in parallel */
+    SPHSystem sph_system(BoundingBox(-1.1 * Vecd::Ones(), 1.1 * Vecd::Ones()), 0.0135);
+    sph_system.setIOEnvironment();
+    std::string output_folder = sph_system.getIOEnvironment().output_folder_;
+    RealBody ball(sph_system, makeShared<TestBall>(1.0), "LargeBall");
+    ball.defineMaterial<BaseMaterial>();
+    ball.generateParticles<BaseParticles, Lattice>();
+    size_t total_real_particles = ball.getBaseParticles().TotalRealParticles();
+    ASSERT_GT(total_real_particles, 2 * 3 * 8192 * 32);
+
+    BodyStatesRecordingToVtp write_states(ball, VtkEncoding::raw);
+    write_states.setNumberOfPieces(2);
+    ball.setNewlyUpdated();
+    write_states.writeToFile(0);
+
+    std::string file_name = "LargeBall_0000000000";
+    size_t first_particle = 0;
+    for (size_t k = 0; k != 2; ++k)
+    {
+        std::ifstream in_file(output_folder + "/" + file_name + "/" + file_name + "_" + std::to_string(k) + ".vtp",
+                              std::ios::binary);
+        ASSERT_TRUE(in_file.is_open());
+        std::string content((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+        size_t id_array = content.find("Name=\"OriginalParticle_ID\"");
+        ASSERT_NE(id_array, std::string::npos);
+        size_t offset_begin = content.find("offset=\"", id_array) + 8;
+        size_t offset = std::stoul(content.substr(offset_begin, content.find('"', offset_begin) - offset_begin));
+        size_t appended_begin = content.find('_', content.find("<AppendedData")) + 1;
+
+        // the original ids are not sorted, so that they are the particle indices
+        uint64_t size;
+        std::memcpy(&size, content.data() + appended_begin + offset, sizeof(uint64_t));
+        size_t number_of_particles = size / sizeof(int);
+        EXPECT_GT(number_of_particles, 3 * 8192 * 32);
+        const int *original_ids = reinterpret_cast<const int *>(content.data() + appended_begin + offset + sizeof(uint64_t));
+        size_t number_of_mismatches = 0;
+        for (size_t i = 0; i != number_of_particles; ++i)
+            number_of_mismatches += original_ids[i] != int(first_particle + i);
+        EXPECT_EQ(number_of_mismatches, 0);
+        first_particle += number_of_particles;
+    }
+    EXPECT_EQ(first_particle, total_real_particles);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,96 @@
+#include "../../unit_test_shapes.h"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace SPH;
+
+/** the Seek offsets and the byte sizes of all DataItem elements in the order of the XDMF file */
+StdVec<std::pair<size_t, size_t>> dataItemExtents(const std::string &xdmf_file_path)
+{
+    std::ifstream in_file(xdmf_file_path);
+    std::string content((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    StdVec<std::pair<size_t, size_t>> extents;
+    for (size_t begin = content.find("<DataItem"); begin != std::string::npos;
+         begin = content.find("<DataItem", begin + 1))
+    {
+        size_t seek_begin = content.find("Seek=\"", begin) + 6;
+        size_t dimensions_begin = content.find("Dimensions=\"", begin) + 12;
+        std::stringstream dimensions(content.substr(dimensions_begin, content.find('"', dimensions_begin) - dimensions_begin));
+        size_t number_of_entries = 0, number_of_components = 1;
+        dimensions >> number_of_entries >> number_of_components;
+        extents.push_back({std::stoul(content.substr(seek_begin)), 4 * number_of_entries * number_of_components});
+    }
+    return extents;
+}
+
+/** the arrays follow each other in the container without gaps */
+void checkDataItemExtents(const std::string &xdmf_file_path, const std::string &heavy_data_file_path)
+{
+    StdVec<std::pair<size_t, size_t>> extents = dataItemExtents(xdmf_file_path);
+    ASSERT_FALSE(extents.empty());
+    EXPECT_EQ(extents.front().first, 0);
+    for (size_t i = 1; i != extents.size(); ++i)
+        EXPECT_EQ(extents[i].first, extents[i - 1].first + extents[i - 1].second);
+    EXPECT_EQ(extents.back().first + extents.back().second, std::filesystem::file_size(heavy_data_file_path));
+}
+
+size_t countTimeSteps(const std::string &xdmf_file_path)
+{
+    std::ifstream in_file(xdmf_file_path);
+    std::string content((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    std::string closing_tags = "  </Grid>\n </Domain>\n</Xdmf>\n";
+    EXPECT_EQ(content.substr(content.size() - closing_tags.size()), closing_tags);
+    size_t number_of_time_steps = 0;
+    for (size_t begin = content.find("<Grid Name=\"Step_"); begin != std::string::npos;
+         begin = content.find("<Grid Name=\"Step_", begin + 1))
+        ++number_of_time_steps;
+    return number_of_time_steps;
+}
+
+TEST(xdmf_recording, AppendedTimeStepsAndRestart)
+{
+    SPHSystem sph_system(BoundingBox(-2.0 * Vecd::Ones(), 2.0 * Vecd::Ones()), 0.1);
+    sph_system.setIOEnvironment();
+    SPHBody ball(sph_system, makeShared<TestBall>(1.0), "Ball");
+    ball.defineMaterial<BaseMaterial>();
+    ball.generateParticles<BaseParticles, Lattice>();
+    ball.getBaseParticles().registerSharedVariable<Vecd>("Velocity");
+    std::string xdmf_file_path = sph_system.getIOEnvironment().output_folder_ + "/Ball_states.xdmf";
+    std::string heavy_data_file_path = sph_system.getIOEnvironment().output_folder_ + "/Ball_states.bin";
+
+    {
+        BodyStatesRecordingToXdmf write_states(ball);
+        write_states.addToWrite<Vecd>(ball, "Velocity");
+        for (size_t step = 0; step != 3; ++step)
+        {
+            GlobalStaticVariables::physical_time_ = 0.1 * Real(step);
+            ball.setNewlyUpdated();
+            write_states.writeToFile();
+        }
+    }
+    EXPECT_EQ(countTimeSteps(xdmf_file_path), 3);
+    checkDataItemExtents(xdmf_file_path, heavy_data_file_path);
+
+    // a restarted run continues the container and the index
+    std::uintmax_t heavy_data_size = std::filesystem::file_size(heavy_data_file_path);
+    sph_system.setRestartStep(3);
+    {
+        BodyStatesRecordingToXdmf write_states(ball);
+        GlobalStaticVariables::physical_time_ = 0.3;
+        ball.setNewlyUpdated();
+        write_states.writeToFile();
+    }
+    EXPECT_EQ(countTimeSteps(xdmf_file_path), 4);
+    EXPECT_GT(std::filesystem::file_size(heavy_data_file_path), heavy_data_size);
+    checkDataItemExtents(xdmf_file_path, heavy_data_file_path);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+#include "../../../unit_test_shapes.h"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+class FluidBall
+{
+  public:
+    FluidBody ball_;
+
+    FluidBall(SPHSystem &sph_system, const std::string &name)
+        : ball_(sph_system, makeShared<TestBall>(0.6), name)
+    {
+        ball_.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+        ball_.generateParticles<BaseParticles, Lattice>();
+    };
+};
+
+/** a fluid ball with gravity and the acoustic steps,
+ *  optionally with the forces and density change rate stored in reduced precision */
+class BallWithAcousticSteps : public FluidBall
+{
+  public:
+    BaseParticles &particles_;
+    InnerRelation ball_inner_;
+    Gravity gravity_;
+    std::unique_ptr<SimpleDynamics<GravityForce>> constant_gravity_;
+    std::unique_ptr<Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann>> pressure_relaxation_;
+    std::unique_ptr<Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann>> density_relaxation_;
+
+    BallWithAcousticSteps(SPHSystem &sph_system, const std::string &name, bool is_reduced)
+        : FluidBall(sph_system, name), particles_(ball_.getBaseParticles()),
+          ball_inner_(ball_), gravity_(Vecd(-Vecd::UnitY()))
+    {
+        // the storage precision is chosen before the dynamics are created
+        if (is_reduced)
+        {
+            particles_.registerSharedVariable<ReducedData<Vecd>>("Force");
+            particles_.registerSharedVariable<ReducedData<Vecd>>("ForcePrior");
+            particles_.registerSharedVariable<ReducedData<Real>>("DensityChangeRate");
+        }
+        constant_gravity_ = std::make_unique<SimpleDynamics<GravityForce>>(ball_, gravity_);
+        pressure_relaxation_ = std::make_unique<Dynamics1Level<fluid_dynamics::Integration1stHalfInnerRiemann>>(ball_inner_);
+        density_relaxation_ = std::make_unique<Dynamics1Level<fluid_dynamics::Integration2ndHalfInnerRiemann>>(ball_inner_);
+
+        StdLargeVec<Vecd> &pos = particles_.ParticlePositions();
+        StdLargeVec<Real> &rho = *particles_.getVariableDataByName<Real>("Density");
+        for (size_t i = 0; i != particles_.TotalRealParticles(); ++i)
+            rho[i] = 1.0 + 0.01 * sin(Pi * pos[i][0]) * cos(Pi * pos[i][1]);
+        ball_.updateCellLinkedList();
+        ball_inner_.updateConfiguration();
+        constant_gravity_->exec();
+    };
+
+    void runAcousticSteps(size_t number_of_steps, Real dt)
+    {
+        for (size_t step = 0; step != number_of_steps; ++step)
+        {
+            pressure_relaxation_->exec(dt);
+            density_relaxation_->exec(dt);
+        }
+    };
+};
+
+TEST(reduced_force_storage, AcousticStepsAgainstFullPrecision)
+{
+    SPHSystem sph_system(BoundingBox(-Vecd::Ones(), Vecd::Ones()), 0.1);
+    BallWithAcousticSteps full_ball(sph_system, "FullBall", false);
+    BallWithAcousticSteps reduced_ball(sph_system, "ReducedBall", true);
+    BaseParticles &full_particles = full_ball.particles_;
+    BaseParticles &reduced_particles = reduced_ball.particles_;
+
+    // the opted-in variables are stored in single precision only
+    EXPECT_EQ(reduced_particles.getVariableDataByName<ReducedData<Vecd>>("Force")->size(),
+              reduced_particles.ParticlesBound());
+    EXPECT_EQ(reduced_particles.getVariableDataByName<ReducedData<Vecd>>("ForcePrior")->size(),
+              reduced_particles.ParticlesBound());
+    EXPECT_TRUE(reduced_particles.getStoredVariableByName<Real>("DensityChangeRate").isReduced());
+    EXPECT_FALSE(full_particles.getStoredVariableByName<Real>("DensityChangeRate").isReduced());
+    // and are sorted and restarted with the precision they are stored with
+    auto &reduced_vectors_to_restart = std::get<DataTypeIndex<ReducedData<Vecd>>::value>(reduced_particles.getVariablesToRestart());
+    EXPECT_EQ(reduced_vectors_to_restart.size(), 2);
+
+    size_t total_real_particles = full_particles.TotalRealParticles();
+    ASSERT_EQ(reduced_particles.TotalRealParticles(), total_real_particles);
+    full_ball.runAcousticSteps(5, 0.001);
+    reduced_ball.runAcousticSteps(5, 0.001);
+
+    StdLargeVec<Vecd> &full_vel = *full_particles.getVariableDataByName<Vecd>("Velocity");
+    StdLargeVec<Vecd> &reduced_vel = *reduced_particles.getVariableDataByName<Vecd>("Velocity");
+    StdLargeVec<Real> &full_rho = *full_particles.getVariableDataByName<Real>("Density");
+    StdLargeVec<Real> &reduced_rho = *reduced_particles.getVariableDataByName<Real>("Density");
+    Real velocity_scale = 0.0;
+    Real density_change_scale = 0.0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        velocity_scale = SMAX(velocity_scale, full_vel[i].norm());
+        density_change_scale = SMAX(density_change_scale, ABS(full_rho[i] - 1.0));
+    }
+    ASSERT_GT(velocity_scale, 0.0);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_LT((reduced_vel[i] - full_vel[i]).norm(), 1.0e-5 * velocity_scale);
+        EXPECT_LT(ABS(reduced_rho[i] - full_rho[i]), 1.0e-5 * density_change_scale);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
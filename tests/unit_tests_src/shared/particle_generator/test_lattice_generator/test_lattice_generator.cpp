@@ -0,0 +1,44 @@
+#include "../../unit_test_shapes.h"
+#include "mesh_iterators.hpp"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+TEST(lattice_generator, SameAsSerialLatticeLoops)
+{
+    // the ball is off the center so that the tiles are cut asymmetrically
+    SPHSystem sph_system(BoundingBox(-1.5 * Vecd::Ones(), 1.5 * Vecd::Ones()), 0.05);
+    SPHBody ball(sph_system, makeShared<TestBall>(0.13 * Vecd::Ones() - 0.2 * Vecd::UnitX(), 1.1), "Ball");
+    ball.defineMaterial<BaseMaterial>();
+    ball.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = ball.getBaseParticles();
+
+    // the nested lattice loops of the serial generator
+    Real lattice_spacing = ball.sph_adaptation_->ReferenceSpacing();
+    BaseMesh mesh(ball.getSPHSystemBounds(), lattice_spacing, 0);
+    Arrayi number_of_lattices = mesh.AllCellsFromAllGridPoints(mesh.AllGridPoints());
+    StdVec<Vecd> serial_positions;
+    mesh_for_each(Arrayi::Zero(), number_of_lattices,
+                  [&](const Arrayi &cell_index)
+                  {
+                      Vecd position = mesh.CellPositionFromIndex(cell_index);
+                      if (ball.getInitialShape().checkContain(position))
+                          serial_positions.push_back(position);
+                  });
+
+    ASSERT_EQ(particles.TotalRealParticles(), serial_positions.size());
+    StdLargeVec<Vecd> &positions = particles.ParticlePositions();
+    StdLargeVec<Real> &volumes = particles.VolumetricMeasures();
+    for (size_t i = 0; i != serial_positions.size(); ++i)
+    {
+        EXPECT_EQ(positions[i], serial_positions[i]);
+        EXPECT_DOUBLE_EQ(volumes[i], std::pow(lattice_spacing, Dimensions));
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,64 @@
+#include "../../unit_test_shapes.h"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+using namespace SPH;
+namespace fs = std::filesystem;
+
+TEST(particle_cache, WriteAndReloadParticles)
+{
+    std::string cache_folder = "./particle_cache_test";
+    fs::remove_all(cache_folder);
+    BoundingBox system_domain_bounds(-1.5 * Vecd::Ones(), 1.5 * Vecd::Ones());
+
+    SPHSystem sph_system(system_domain_bounds, 0.1);
+    sph_system.setIOEnvironment();
+    sph_system.setGeometryCache(cache_folder);
+    SPHBody ball(sph_system, makeShared<TestBall>(1.0), "Ball");
+    ball.defineMaterial<BaseMaterial>();
+    ball.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = ball.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+    StdLargeVec<Vecd> &pos = particles.ParticlePositions();
+    StdLargeVec<Real> &Vol = particles.VolumetricMeasures();
+    // perturbed as the relaxed particles are, so that the lattice can not be reproduced
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        pos[i] += 0.01 * sin(Real(i)) * Vecd::Ones();
+        Vol[i] *= 1.0 + 0.1 * cos(Real(i));
+    }
+
+    ParticleCacheIO particle_cache(ball, "relaxed");
+    EXPECT_FALSE(particle_cache.isCached());
+    particle_cache.writeToFile();
+    EXPECT_TRUE(particle_cache.isCached());
+
+    // a new run with the same body finds and reloads the cached particles
+    SPHSystem new_sph_system(system_domain_bounds, 0.1);
+    new_sph_system.setIOEnvironment();
+    new_sph_system.setGeometryCache(cache_folder);
+    SPHBody new_ball(new_sph_system, makeShared<TestBall>(1.0), "Ball");
+    new_ball.defineMaterial<BaseMaterial>();
+    ParticleCacheIO new_particle_cache(new_ball, "relaxed");
+    EXPECT_EQ(new_particle_cache.CacheKey(), particle_cache.CacheKey());
+    ASSERT_TRUE(new_particle_cache.isCached());
+    EXPECT_FALSE(ParticleCacheIO(new_ball, "not relaxed").isCached());
+    new_ball.generateParticles<BaseParticles, Cache>(new_particle_cache);
+
+    BaseParticles &new_particles = new_ball.getBaseParticles();
+    ASSERT_EQ(new_particles.TotalRealParticles(), total_real_particles);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_EQ(new_particles.ParticlePositions()[i], pos[i]);
+        EXPECT_EQ(new_particles.VolumetricMeasures()[i], Vol[i]);
+    }
+    fs::remove_all(cache_folder);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,170 @@
+#include "../../unit_test_shapes.h"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace SPH;
+
+/** a ball of particles with the position, velocity and mass for restart */
+class RestartBall
+{
+  public:
+    SPHSystem sph_system_;
+    SPHBody ball_;
+    BaseParticles *particles_;
+    StdLargeVec<Vecd> *velocity_;
+
+    RestartBall()
+        : sph_system_(BoundingBox(-2.0 * Vecd::Ones(), 2.0 * Vecd::Ones()), 0.1),
+          ball_(sph_system_, makeShared<TestBall>(1.0), "Ball")
+    {
+        ball_.defineMaterial<BaseMaterial>();
+        ball_.generateParticles<BaseParticles, Lattice>();
+        particles_ = &ball_.getBaseParticles();
+        velocity_ = particles_->registerSharedVariable<Vecd>("Velocity");
+        particles_->addVariableToRestart<Vecd>("Position");
+        particles_->addVariableToRestart<Vecd>("Velocity");
+        particles_->addVariableToRestart<Real>("Mass");
+    };
+};
+
+TEST(binary_restart, WriteAndRead)
+{
+    std::filesystem::create_directory("./restart_test");
+    RestartBall restart_ball;
+    BaseParticles &particles = *restart_ball.particles_;
+    StdLargeVec<Vecd> &velocity = *restart_ball.velocity_;
+    size_t total_real_particles = particles.TotalRealParticles();
+    ASSERT_GT(total_real_particles, 0);
+
+    for (size_t i = 0; i != total_real_particles; ++i)
+        velocity[i] = Real(i) * Vecd::Ones();
+    particles.writeParticlesToBinaryForRestart("./restart_test/Ball_rst_0.bin", 0.25);
+
+    StdLargeVec<Vecd> position = *particles.getVariableDataByName<Vecd>("Position");
+    StdLargeVec<Vecd> &restart_position = *particles.getVariableDataByName<Vecd>("Position");
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        velocity[i] = Vecd::Zero();
+        restart_position[i] = Vecd::Zero();
+    }
+
+    EXPECT_EQ(particles.readParticlesFromBinaryForRestart("./restart_test/Ball_rst_0.bin"), 0.25);
+    EXPECT_EQ(particles.TotalRealParticles(), total_real_particles);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_EQ(velocity[i], Real(i) * Vecd::Ones());
+        EXPECT_EQ(restart_position[i], position[i]);
+    }
+
+    // a changed byte in the arrays is found by the checksum
+    std::fstream restart_file("./restart_test/Ball_rst_0.bin", std::ios::in | std::ios::out | std::ios::binary);
+    restart_file.seekp(-8, std::ios::end);
+    restart_file.put(char(0x5A));
+    restart_file.close();
+    // the error message goes to the standard output, which is redirected for matching
+    EXPECT_EXIT(
+        {
+            std::cout.rdbuf(std::cerr.rdbuf());
+            particles.readParticlesFromBinaryForRestart("./restart_test/Ball_rst_0.bin");
+        },
+        testing::ExitedWithCode(1), "is missing, corrupted or written by an incompatible build");
+    std::filesystem::remove_all("./restart_test");
+}
+
+TEST(binary_restart, FullAndIncrementalCheckpoints)
+{
+    std::filesystem::create_directory("./restart_test");
+    RestartBall restart_ball;
+    BaseParticles &particles = *restart_ball.particles_;
+    StdLargeVec<Vecd> &velocity = *restart_ball.velocity_;
+    size_t total_real_particles = particles.TotalRealParticles();
+    ASSERT_GT(total_real_particles, 0);
+
+    for (size_t i = 0; i != total_real_particles; ++i)
+        velocity[i] = Real(i) * Vecd::Ones();
+    particles.writeParticlesToBinaryForRestart("./restart_test/Ball_rst_0.bin", 0.0, false, true);
+    for (size_t i = 0; i != total_real_particles; ++i)
+        velocity[i] = -Real(i) * Vecd::Ones();
+    particles.writeParticlesToBinaryForRestart("./restart_test/Ball_rst_1.bin", 0.5, true, true);
+
+    // only the velocity is held by the incremental file, the others are referred to the full one
+    size_t velocity_bytes = total_real_particles * sizeof(Vecd);
+    size_t unchanged_bytes = total_real_particles * (sizeof(Vecd) + sizeof(Real));
+    std::uintmax_t full_size = std::filesystem::file_size("./restart_test/Ball_rst_0.bin");
+    std::uintmax_t incremental_size = std::filesystem::file_size("./restart_test/Ball_rst_1.bin");
+    EXPECT_GT(incremental_size, velocity_bytes);
+    EXPECT_LT(incremental_size, full_size - unchanged_bytes + 1024);
+
+    StdLargeVec<Vecd> position = *particles.getVariableDataByName<Vecd>("Position");
+    StdLargeVec<Real> mass = *particles.getVariableDataByName<Real>("Mass");
+    StdLargeVec<Vecd> &restart_position = *particles.getVariableDataByName<Vecd>("Position");
+    StdLargeVec<Real> &restart_mass = *particles.getVariableDataByName<Real>("Mass");
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        velocity[i] = Vecd::Zero();
+        restart_position[i] = Vecd::Zero();
+        restart_mass[i] = 0.0;
+    }
+
+    EXPECT_EQ(particles.readParticlesFromBinaryForRestart("./restart_test/Ball_rst_1.bin"), 0.5);
+    EXPECT_EQ(particles.TotalRealParticles(), total_real_particles);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_EQ(velocity[i], -Real(i) * Vecd::Ones());
+        EXPECT_EQ(restart_position[i], position[i]);
+        EXPECT_EQ(restart_mass[i], mass[i]);
+    }
+}
+
+TEST(binary_restart, MissingReferencedFile)
+{
+    std::filesystem::remove("./restart_test/Ball_rst_0.bin");
+    RestartBall restart_ball;
+    // the error message goes to the standard output, which is redirected for matching
+    EXPECT_EXIT(
+        {
+            std::cout.rdbuf(std::cerr.rdbuf());
+            restart_ball.particles_->readParticlesFromBinaryForRestart("./restart_test/Ball_rst_1.bin");
+        },
+        testing::ExitedWithCode(1), "Ball_rst_0.bin holding the variable '.*' is missing or corrupted");
+    std::filesystem::remove_all("./restart_test");
+}
+
+TEST(binary_restart, IncrementalReferredToLastFullCheckpoint)
+{
+    std::filesystem::create_directory("./restart_test");
+    RestartBall restart_ball;
+    BaseParticles &particles = *restart_ball.particles_;
+    StdLargeVec<Vecd> &velocity = *restart_ball.velocity_;
+    size_t total_real_particles = particles.TotalRealParticles();
+
+    for (size_t i = 0; i != total_real_particles; ++i)
+        velocity[i] = Real(i) * Vecd::Ones();
+    particles.writeParticlesToBinaryForRestart("./restart_test/Ball_rst_0.bin", 0.0, false, true);
+    for (size_t i = 0; i != total_real_particles; ++i)
+        velocity[i] = -Real(i) * Vecd::Ones();
+    particles.writeParticlesToBinaryForRestart("./restart_test/Ball_rst_1.bin", 0.5, true, true);
+    // changed back to the velocity of the full checkpoint
+    for (size_t i = 0; i != total_real_particles; ++i)
+        velocity[i] = Real(i) * Vecd::Ones();
+    particles.writeParticlesToBinaryForRestart("./restart_test/Ball_rst_2.bin", 1.0, true, true);
+
+    // all arrays are referred to the full checkpoint, none to the incremental one before
+    EXPECT_LT(std::filesystem::file_size("./restart_test/Ball_rst_2.bin"), 1024);
+    std::filesystem::remove("./restart_test/Ball_rst_1.bin");
+    for (size_t i = 0; i != total_real_particles; ++i)
+        velocity[i] = Vecd::Zero();
+    EXPECT_EQ(particles.readParticlesFromBinaryForRestart("./restart_test/Ball_rst_2.bin"), 1.0);
+    for (size_t i = 0; i != total_real_particles; ++i)
+        EXPECT_EQ(velocity[i], Real(i) * Vecd::Ones());
+    std::filesystem::remove_all("./restart_test");
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+#include "../../unit_test_shapes.h"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace SPH;
+
+class BufferParticlesTest : public testing::Test
+{
+  protected:
+    SPHSystem sph_system_;
+    ParticleBuffer<ReserveSizeFactor> batched_buffer_, serial_buffer_;
+    SPHBody batched_ball_, serial_ball_;
+    BaseParticles *batched_particles_, *serial_particles_;
+
+    BufferParticlesTest()
+        : sph_system_(BoundingBox(-2.0 * Vecd::Ones(), 2.0 * Vecd::Ones()), 0.1),
+          batched_buffer_(0.5), serial_buffer_(0.5),
+          batched_ball_(sph_system_, makeShared<TestBall>(1.0), "BatchedBall"),
+          serial_ball_(sph_system_, makeShared<TestBall>(1.0), "SerialBall")
+    {
+        batched_particles_ = initializeParticles(batched_ball_, batched_buffer_);
+        serial_particles_ = initializeParticles(serial_ball_, serial_buffer_);
+    };
+
+    BaseParticles *initializeParticles(SPHBody &ball, ParticleBuffer<ReserveSizeFactor> &buffer)
+    {
+        ball.defineMaterial<BaseMaterial>();
+        ball.generateParticlesWithReserve<BaseParticles, Lattice>(buffer);
+        BaseParticles &particles = ball.getBaseParticles();
+        // a state which identifies the particle it is copied from
+        particles.registerSharedVariable<Real>("Marker", [&](size_t i) -> Real
+                                               { return Real(i); });
+        return &particles;
+    };
+
+    /** the indices in a random order, as collected by a parallel particle loop */
+    ConcurrentIndexVector concurrentIndices(StdVec<size_t> indices)
+    {
+        std::shuffle(indices.begin(), indices.end(), std::mt19937(7));
+        ConcurrentIndexVector concurrent_indices;
+        for (size_t index : indices)
+            concurrent_indices.push_back(index);
+        return concurrent_indices;
+    };
+};
+
+TEST_F(BufferParticlesTest, CreateRealParticlesSameAsOneByOne)
+{
+    size_t total_real_particles = batched_particles_->TotalRealParticles();
+    StdVec<size_t> sources;
+    for (size_t i = 0; i < total_real_particles; i += 5)
+        sources.push_back(i);
+
+    batched_particles_->createRealParticlesFrom(concurrentIndices(sources));
+    for (size_t source : sources)
+        serial_particles_->createRealParticleFrom(source);
+
+    ASSERT_EQ(batched_particles_->TotalRealParticles(), total_real_particles + sources.size());
+    ASSERT_EQ(serial_particles_->TotalRealParticles(), total_real_particles + sources.size());
+    StdLargeVec<Real> &batched_marker = *batched_particles_->getVariableDataByName<Real>("Marker");
+    StdLargeVec<Real> &serial_marker = *serial_particles_->getVariableDataByName<Real>("Marker");
+    for (size_t i = 0; i != serial_particles_->TotalRealParticles(); ++i)
+    {
+        EXPECT_EQ(batched_particles_->ParticlePositions()[i], serial_particles_->ParticlePositions()[i]);
+        EXPECT_EQ(batched_particles_->ParticleOriginalIds()[i], serial_particles_->ParticleOriginalIds()[i]);
+        EXPECT_EQ(batched_marker[i], serial_marker[i]);
+    }
+}
+
+TEST_F(BufferParticlesTest, SwitchToBufferParticlesSameAsOneByOne)
+{
+    size_t total_real_particles = batched_particles_->TotalRealParticles();
+    // including the particles in the tail, which are not moved, and a duplicate
+    StdVec<size_t> deleted = {total_real_particles - 1, total_real_particles - 3, 11};
+    for (size_t i = 0; i < total_real_particles; i += 7)
+        deleted.push_back(i);
+
+    batched_particles_->switchToBufferParticles(concurrentIndices(deleted));
+    std::sort(deleted.begin(), deleted.end());
+    deleted.erase(std::unique(deleted.begin(), deleted.end()), deleted.end());
+    for (auto index = deleted.rbegin(); index != deleted.rend(); ++index)
+        serial_particles_->switchToBufferParticle(*index);
+
+    // the remaining particles may be ordered differently
+    size_t new_total_real_particles = total_real_particles - deleted.size();
+    ASSERT_EQ(batched_particles_->TotalRealParticles(), new_total_real_particles);
+    ASSERT_EQ(serial_particles_->TotalRealParticles(), new_total_real_particles);
+    StdLargeVec<Real> &batched_marker = *batched_particles_->getVariableDataByName<Real>("Marker");
+    StdLargeVec<Real> &serial_marker = *serial_particles_->getVariableDataByName<Real>("Marker");
+    StdLargeVec<size_t> &batched_original_id = batched_particles_->ParticleOriginalIds();
+    StdLargeVec<size_t> &serial_sorted_id = serial_particles_->ParticleSortedIds();
+    for (size_t i = 0; i != new_total_real_particles; ++i)
+    {
+        size_t original_id = batched_original_id[i];
+        EXPECT_FALSE(std::binary_search(deleted.begin(), deleted.end(), original_id));
+        EXPECT_EQ(batched_particles_->ParticleSortedIds()[original_id], i);
+        EXPECT_EQ(batched_marker[i], Real(original_id));
+        size_t serial_index = serial_sorted_id[original_id];
+        ASSERT_LT(serial_index, new_total_real_particles);
+        EXPECT_EQ(serial_particles_->ParticleOriginalIds()[serial_index], original_id);
+        EXPECT_EQ(batched_particles_->ParticlePositions()[i], serial_particles_->ParticlePositions()[serial_index]);
+        EXPECT_EQ(batched_marker[i], serial_marker[serial_index]);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,121 @@
+#include "../../unit_test_shapes.h"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+template <typename DataType>
+bool isListed(const ParticleVariables &variable_set, const std::string &name)
+{
+    for (auto &variable : std::get<DataTypeIndex<DataType>::value>(variable_set))
+    {
+        if (variable->Name() == name)
+            return true;
+    }
+    return false;
+}
+
+template <typename DataType>
+bool isListedForIO(BaseParticles &particles, const std::string &name)
+{
+    return isListed<DataType>(particles.getVariablesToWrite(), name) ||
+           isListed<DataType>(particles.getVariablesToRestart(), name) ||
+           isListed<DataType>(particles.getVariablesToReload(), name);
+}
+
+TEST(particle_variables, TransientVariablesReleased)
+{
+    SPHSystem sph_system(BoundingBox(-2.0 * Vecd::Ones(), 2.0 * Vecd::Ones()), 0.1);
+    SPHBody ball(sph_system, makeShared<TestBall>(1.0), "Ball");
+    ball.defineMaterial<BaseMaterial>();
+    ball.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = ball.getBaseParticles();
+
+    // two users share the data
+    StdLargeVec<Vecd> *residue = particles.registerTransientVariable<Vecd>("Residue");
+    EXPECT_EQ(particles.registerTransientVariable<Vecd>("Residue"), residue);
+    EXPECT_EQ(residue->size(), particles.ParticlesBound());
+    EXPECT_FALSE(isListedForIO<Vecd>(particles, "Residue"));
+
+    DiscreteVariable<Vecd> *variable = particles.getVariableByName<Vecd>("Residue");
+    particles.releaseTransientVariable<Vecd>("Residue");
+    EXPECT_FALSE(variable->isDataReleased());
+    EXPECT_EQ(residue->size(), particles.ParticlesBound());
+    particles.releaseTransientVariable<Vecd>("Residue");
+    EXPECT_TRUE(variable->isDataReleased());
+    EXPECT_EQ(residue->capacity(), 0);
+    // the error message goes to the standard output, which is redirected for matching
+    EXPECT_EXIT(
+        {
+            std::cout.rdbuf(std::cerr.rdbuf());
+            particles.getVariableDataByName<Vecd>("Residue");
+        },
+        testing::ExitedWithCode(1), "has been released");
+
+    // allocated again by a new user in the same container, and kept if required for output
+    EXPECT_EQ(particles.registerTransientVariable<Vecd>("Residue"), residue);
+    EXPECT_EQ(residue->size(), particles.ParticlesBound());
+    particles.addVariableToWrite<Vecd>("Residue");
+    particles.releaseTransientVariable<Vecd>("Residue");
+    EXPECT_FALSE(variable->isDataReleased());
+    EXPECT_EQ(residue->size(), particles.ParticlesBound());
+}
+
+TEST(particle_variables, RelaxationResidueReleased)
+{
+    SPHSystem sph_system(BoundingBox(-2.0 * Vecd::Ones(), 2.0 * Vecd::Ones()), 0.1);
+    sph_system.setIOEnvironment();
+    RealBody ball(sph_system, makeShared<TestBall>(1.0), "Ball");
+    ball.defineMaterial<BaseMaterial>();
+    ball.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = ball.getBaseParticles();
+    InnerRelation ball_inner(ball);
+    BodyStatesRecordingToVtp write_ball_states(ball);
+    RestartIO restart_io(sph_system);
+    ReloadParticleIO reload_io(ball);
+
+    {
+        InteractionDynamics<relax_dynamics::RelaxationResidue<Inner<>>> relaxation_residue(ball_inner);
+        EXPECT_EQ(particles.getVariableDataByName<Vecd>("ZeroOrderResidue")->size(), particles.ParticlesBound());
+    }
+    EXPECT_TRUE(particles.getVariableByName<Vecd>("ZeroOrderResidue")->isDataReleased());
+    EXPECT_FALSE(isListedForIO<Vecd>(particles, "ZeroOrderResidue"));
+}
+
+TEST(particle_variables, ResizedWithParticleBounds)
+{
+    SPHSystem sph_system(BoundingBox(-2.0 * Vecd::Ones(), 2.0 * Vecd::Ones()), 0.1);
+    SPHBody ball(sph_system, makeShared<TestBall>(1.0), "Ball");
+    ball.defineMaterial<BaseMaterial>();
+    ball.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = ball.getBaseParticles();
+    size_t particles_bound = particles.ParticlesBound();
+    StdLargeVec<Vecd> &velocity = *particles.registerSharedVariable<Vecd>("Velocity", Vecd(Vecd::Ones()));
+    StdLargeVec<Real> &mass = *particles.getVariableDataByName<Real>("Mass");
+    StdLargeVec<Real> mass_before = mass;
+    particles.registerTransientVariable<Vecd>("Residue");
+    particles.releaseTransientVariable<Vecd>("Residue");
+
+    // the variables registered before the buffer or ghost particles are resized in one pass
+    particles.increaseAllParticlesBounds(10);
+    size_t ghost_lower_bound = particles.allocateGhostParticles(5);
+    EXPECT_EQ(ghost_lower_bound, particles_bound + 10);
+    ASSERT_EQ(particles.ParticlesBound(), particles_bound + 15);
+    ASSERT_EQ(velocity.size(), particles.ParticlesBound());
+    ASSERT_EQ(mass.size(), particles.ParticlesBound());
+    EXPECT_EQ(particles.ParticlePositions().size(), particles.ParticlesBound());
+    EXPECT_EQ(particles.ParticleOriginalIds().size(), particles.ParticlesBound());
+    for (size_t i = 0; i != particles.ParticlesBound(); ++i)
+    {
+        EXPECT_EQ(velocity[i], i < particles_bound ? Vecd(Vecd::Ones()) : Vecd(Vecd::Zero()));
+        EXPECT_EQ(mass[i], i < particles_bound ? mass_before[i] : 0.0);
+    }
+    // but not the released ones
+    EXPECT_EQ(particles.getVariableByName<Vecd>("Residue")->DataField()->capacity(), 0);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -103,6 +103,117 @@ TEST(test_anisotropic_kernel, test_Laplacian)
     EXPECT_NEAR(2.0 * A.trace(), predicted_laplacian, 0.05);
 }
 
+StdVec<Vecd> getAnisotropicLattice(Real resolution_x, Real resolution_y, int x_num, int y_num)
+{
+    StdVec<Vecd> positions;
+    for (int i = 0; i < x_num; i++)
+        for (int j = 0; j < y_num; j++)
+            positions.push_back(Vecd(i * resolution_x, j * resolution_y));
+    return positions;
+}
+
+/** the per-pair work of the neighbor builders, summed up to keep it from being optimized away */
+template <class KernelEvaluation>
+Real evaluateAllPairs(const KernelEvaluation &kernel, const StdVec<Vecd> &positions)
+{
+    Real sum = 0.0;
+    for (const Vecd &pos_i : positions)
+        for (const Vecd &pos_j : positions)
+        {
+            Vecd displacement = pos_i - pos_j;
+            if (kernel.checkIfWithinCutOffRadius(displacement))
+            {
+                Real distance = displacement.norm();
+                sum += kernel.W(distance, displacement) + kernel.dW(distance, displacement) +
+                       kernel.e(distance, displacement).sum();
+            }
+        }
+    return sum;
+}
+
+template <class KernelType>
+Real evaluateAllPairs(const InlinedKernel<AnisotropicKernel<KernelType>> &kernel, const StdVec<Vecd> &positions)
+{
+    Real sum = 0.0;
+    for (const Vecd &pos_i : positions)
+        for (const Vecd &pos_j : positions)
+        {
+            Vecd displacement = pos_i - pos_j;
+            if (kernel.checkIfWithinCutOffRadius(displacement))
+            {
+                Real W_ij, dW_ij;
+                Vecd e_ij;
+                kernel.evaluatePair(displacement, W_ij, dW_ij, e_ij);
+                sum += W_ij + dW_ij + e_ij.sum();
+            }
+        }
+    return sum;
+}
+
+TEST(test_anisotropic_kernel, test_inlined_evaluation)
+{
+    Real resolution_y = 0.02;
+    Real resolution_x = 4.0 * resolution_y;
+    Vecd scaling_vector(1.0, 0.25);
+    AnisotropicKernel<KernelWendlandC2> wendland(1.15 * resolution_x, scaling_vector, Vecd(0.0, 0.0));
+    InlinedKernel<Kernel> virtual_kernel(wendland);
+    InlinedKernel<AnisotropicKernel<KernelWendlandC2>> inlined_kernel(wendland);
+    EXPECT_EQ(dispatchKernel(wendland).index(), DispatchedKernel(inlined_kernel).index());
+
+    Vecd pos_i(5.0 * resolution_x, 5.0 * resolution_y);
+    auto compareWithVirtual = [&]()
+    {
+        for (const Vecd &pos_j : getAnisotropicLattice(resolution_x, resolution_y, 11, 11))
+        {
+            Vecd displacement = pos_i - pos_j;
+            Real distance = displacement.norm();
+            EXPECT_EQ(virtual_kernel.checkIfWithinCutOffRadius(displacement),
+                      inlined_kernel.checkIfWithinCutOffRadius(displacement));
+            EXPECT_EQ(virtual_kernel.e(distance, displacement), inlined_kernel.e(distance, displacement));
+
+            Real W_ij, dW_ij;
+            Vecd e_ij;
+            inlined_kernel.evaluatePair(displacement, W_ij, dW_ij, e_ij);
+            EXPECT_EQ(virtual_kernel.W(distance, displacement), W_ij);
+            EXPECT_EQ(virtual_kernel.dW(distance, displacement), dW_ij);
+            /** the displacement is transformed only once in a pair evaluation */
+            EXPECT_LT((virtual_kernel.e(distance, displacement) - e_ij).norm(), 1.0e-12 * e_ij.norm() + TinyReal);
+        }
+    };
+    compareWithVirtual();
+    /** the inlined kernel follows a reset of the kernel it wraps */
+    wendland.resetSmoothingLength(0.5 * wendland.SmoothingLength());
+    compareWithVirtual();
+}
+
+TEST(test_anisotropic_kernel, benchmark_pair_evaluation)
+{
+    Real resolution_y = 0.01;
+    Real resolution_x = 4.0 * resolution_y;
+    StdVec<Vecd> positions = getAnisotropicLattice(resolution_x, resolution_y, 25, 100);
+
+    KernelWendlandC2 isotropic(1.15 * resolution_y);
+    StdVec<Vecd> isotropic_positions = getAnisotropicLattice(resolution_y, resolution_y, 25, 100);
+    AnisotropicKernel<KernelWendlandC2> anisotropic(1.15 * resolution_x, Vecd(1.0, 0.25), Vecd(0.0, 0.0));
+
+    auto benchmark = [](const std::string &label, auto kernel, const StdVec<Vecd> &lattice)
+    {
+        TickCount t1 = TickCount::now();
+        Real sum = evaluateAllPairs(kernel, lattice);
+        TimeInterval interval = TickCount::now() - t1;
+        std::cout << std::setw(36) << std::left << label << interval.seconds() << " s (checksum " << sum << ")\n";
+        return sum;
+    };
+    /** both lattices have the same number of neighbors per particle */
+    Real isotropic_sum = benchmark("isotropic, virtual", InlinedKernel<Kernel>(isotropic), isotropic_positions);
+    Real isotropic_inlined_sum = benchmark("isotropic, inlined", InlinedKernel<KernelWendlandC2>(isotropic), isotropic_positions);
+    Real anisotropic_sum = benchmark("anisotropic, virtual", InlinedKernel<Kernel>(anisotropic), positions);
+    Real inlined_sum = benchmark("anisotropic, inlined", InlinedKernel<AnisotropicKernel<KernelWendlandC2>>(anisotropic), positions);
+
+    EXPECT_EQ(isotropic_sum, isotropic_inlined_sum);
+    EXPECT_NEAR(anisotropic_sum, inlined_sum, 1.0e-12 * ABS(anisotropic_sum));
+}
+
 int main(int argc, char *argv[])
 {
     testing::InitGoogleTest(&argc, argv);
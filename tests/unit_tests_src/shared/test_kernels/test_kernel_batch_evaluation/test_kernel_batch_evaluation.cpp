@@ -0,0 +1,58 @@
+#include "anisotropic_kernel.hpp"
+#include "kernel_cubic_B_spline.h"
+#include "kernel_hyperbolic.h"
+#include "kernel_quadratic.h"
+#include "kernel_wenland_c2.h"
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+
+template <class KernelType>
+class KernelBatchEvaluation : public testing::Test
+{
+};
+using BatchEvaluatedKernels = testing::Types<KernelWendlandC2, KernelQuadratic, KernelHyperbolic, KernelCubicBSpline>;
+TYPED_TEST_SUITE(KernelBatchEvaluation, BatchEvaluatedKernels);
+
+TYPED_TEST(KernelBatchEvaluation, SameAsPairByPair)
+{
+    TypeParam kernel(1.3);
+    // from the origin to beyond the cut-off radius, including the cut-off radius itself
+    StdVec<Real> r_sqr;
+    for (size_t i = 0; i != 1000; ++i)
+        r_sqr.push_back(1.2 * kernel.CutOffRadiusSqr() * Real(i) / 999.0);
+    r_sqr.push_back(kernel.CutOffRadiusSqr());
+    // and the boundary between the pieces of the cubic B-spline
+    r_sqr.push_back(0.25 * kernel.CutOffRadiusSqr());
+    StdVec<Real> W(r_sqr.size()), dW(r_sqr.size());
+    kernel.evaluateBatch(r_sqr.data(), r_sqr.size(), W.data(), dW.data());
+
+    for (size_t i = 0; i != r_sqr.size(); ++i)
+    {
+        Real r_ij = sqrt(r_sqr[i]);
+        bool is_within_cutoff = r_sqr[i] < kernel.CutOffRadiusSqr();
+        Real W_ij = is_within_cutoff ? kernel.W(r_ij, ZeroVecd) : 0.0;
+        Real dW_ij = is_within_cutoff ? kernel.dW(r_ij, ZeroVecd) : 0.0;
+        EXPECT_NEAR(W_ij, W[i], 1.0e-10 * kernel.W0(ZeroVecd));
+        EXPECT_NEAR(dW_ij, dW[i], 1.0e-10 * kernel.W0(ZeroVecd));
+    }
+}
+
+TEST(AnisotropicKernelBatchEvaluation, NotAvailable)
+{
+    AnisotropicKernel<KernelWendlandC2> kernel(1.0, Vecd(Vecd::Ones()), Vecd(Vecd::Zero()));
+    StdVec<Real> r_sqr = {0.0, 0.5}, W(2), dW(2);
+    // the error message goes to the standard output, which is redirected for matching
+    EXPECT_EXIT(
+        {
+            std::cout.rdbuf(std::cerr.rdbuf());
+            kernel.evaluateBatch(r_sqr.data(), r_sqr.size(), W.data(), dW.data());
+        },
+        testing::ExitedWithCode(1), "can not be evaluated from squared distances");
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -29,6 +29,22 @@ TEST(test_Kernel_Cubic_B_Spline, test_d2W)
 
     EXPECT_EQ(-3.0 / 4.0, d2W_1D);
 }
+
+TEST(test_Kernel_Cubic_B_Spline, test_evaluateBatch)
+{
+    KernelCubicBSpline B_spline(1.0);
+    StdVec<Real> r_sqr = {0.0, 0.25, 1.0, 2.25, 3.9, 4.0, 5.0};
+    StdVec<Real> W(r_sqr.size()), dW(r_sqr.size());
+    B_spline.evaluateBatch(r_sqr.data(), r_sqr.size(), W.data(), dW.data());
+
+    for (size_t i = 0; i != r_sqr.size(); ++i)
+    {
+        Real r_ij = sqrt(r_sqr[i]);
+        bool is_within_cutoff = r_sqr[i] < B_spline.CutOffRadiusSqr();
+        EXPECT_NEAR(is_within_cutoff ? B_spline.W(r_ij, ZeroVecd) : 0.0, W[i], 1.0e-12);
+        EXPECT_NEAR(is_within_cutoff ? B_spline.dW(r_ij, ZeroVecd) : 0.0, dW[i], 1.0e-12);
+    }
+}
 int main(int argc, char *argv[])
 {
     testing::InitGoogleTest(&argc, argv);
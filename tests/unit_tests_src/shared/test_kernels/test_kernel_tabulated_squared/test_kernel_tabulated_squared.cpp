@@ -0,0 +1,50 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+using namespace SPH;
+
+/** compare the tabulated kernel on squared distance with the analytic one */
+template <class KernelType>
+void testTabulatedSquared(Real h, int kernel_resolution, Real tolerance)
+{
+    KernelType analytic_kernel(h);
+    KernelTabulatedSquared<KernelType> tabulated_kernel(h, kernel_resolution);
+    Real cutoff_radius = analytic_kernel.CutOffRadius();
+
+    size_t number_of_samples = 1000;
+    for (size_t i = 1; i != number_of_samples; ++i)
+    {
+        Real r_ij = cutoff_radius * Real(i) / Real(number_of_samples);
+        Real W = 0.0, dW_over_r = 0.0;
+        EXPECT_TRUE(tabulated_kernel.evaluateSquared(r_ij * r_ij, W, dW_over_r));
+        EXPECT_NEAR(analytic_kernel.W(r_ij, ZeroVecd), W, tolerance * analytic_kernel.FactorW());
+        EXPECT_NEAR(analytic_kernel.dW(r_ij, ZeroVecd),
+                    dW_over_r * r_ij, tolerance * analytic_kernel.FactordW());
+    }
+
+    Real W = 0.0, dW_over_r = 0.0;
+    EXPECT_TRUE(tabulated_kernel.evaluateSquared(0.0, W, dW_over_r));
+    EXPECT_NEAR(analytic_kernel.W(0.0, ZeroVecd), W, tolerance * analytic_kernel.FactorW());
+    EXPECT_FALSE(tabulated_kernel.evaluateSquared(cutoff_radius * cutoff_radius, W, dW_over_r));
+    EXPECT_FALSE(tabulated_kernel.evaluateSquared(1.1 * cutoff_radius * cutoff_radius, W, dW_over_r));
+}
+
+TEST(test_Kernel_Tabulated_Squared, test_WendlandC2)
+{
+    testTabulatedSquared<KernelWendlandC2>(1.3, 100, 2.0e-4);
+}
+
+TEST(test_Kernel_Tabulated_Squared, test_CubicBSpline)
+{
+    testTabulatedSquared<KernelCubicBSpline>(0.7, 100, 2.0e-4);
+}
+
+TEST(test_Kernel_Tabulated_Squared, test_LaguerreGauss)
+{
+    testTabulatedSquared<KernelLaguerreGauss>(1.0, 100, 1.0e-5);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
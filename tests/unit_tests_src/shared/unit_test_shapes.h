@@ -0,0 +1,45 @@
+/**
+ * @file 	unit_test_shapes.h
+ * @brief 	Analytic shapes shared by the unit tests.
+ * @details	Unlike GeometricShapeBall, which is built on Simbody contact geometry,
+ *			these shapes are analytic and give exact containment and closest points.
+ * @author	agent
+ */
+#ifndef UNIT_TEST_SHAPES_H
+#define UNIT_TEST_SHAPES_H
+
+#include "base_geometry.h"
+
+namespace SPH
+{
+/** an analytic ball, e.g. for building level sets or generating lattice particles */
+class TestBall : public Shape
+{
+    Vecd center_;
+    Real radius_;
+
+  public:
+    TestBall(const Vecd &center, Real radius) : Shape("TestBall"), center_(center), radius_(radius){};
+    explicit TestBall(Real radius) : TestBall(Vecd::Zero(), radius){};
+    virtual bool checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED = true) override
+    {
+        return (probe_point - center_).norm() < radius_;
+    };
+    virtual Vecd findClosestPoint(const Vecd &probe_point) override
+    {
+        return center_ + (probe_point - center_).normalized() * radius_;
+    };
+    virtual bool hashGeometry(ContentHash &content_hash) override
+    {
+        content_hash.add(std::string("TestBall")).add(center_).add(radius_);
+        return true;
+    };
+
+  protected:
+    virtual BoundingBox findBounds() override
+    {
+        return BoundingBox(center_ - radius_ * Vecd::Ones(), center_ + radius_ * Vecd::Ones());
+    };
+};
+} // namespace SPH
+#endif // UNIT_TEST_SHAPES_H